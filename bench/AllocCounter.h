@@ -0,0 +1,38 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_BENCH_ALLOCCOUNTER_H
+#define MDLP_BENCH_ALLOCCOUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bench {
+    /**
+     * @brief Heap use of the calling thread, seen through the global operator new
+     *
+     * AllocCounter.cpp replaces the global operator new and delete of any
+     * program it is linked into; every std::vector the library allocates goes
+     * through them. Each block carries its size in a header, so frees are
+     * counted whatever delete overload the caller uses. The counts are the
+     * calling thread's: work a ThreadPool does on its workers is not in them.
+     * Over-aligned allocations keep the standard library's own operators and
+     * are not counted; the library makes none.
+     */
+    struct AllocUsage {
+        uint64_t allocations = 0;  ///< Calls to operator new
+        uint64_t bytes = 0;        ///< Bytes they asked for
+        uint64_t peak = 0;         ///< Most bytes live at once, over those live at begin
+    };
+
+    namespace alloc {
+        /** @brief Start a measurement; the peak restarts from what is live now */
+        void begin();
+        /** @brief What this thread allocated since begin() */
+        AllocUsage end();
+    }
+}
+#endif
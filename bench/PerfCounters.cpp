@@ -0,0 +1,149 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <utility>
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+    const char* PerfCounters::name(Event event)
+    {
+        static const char* const names[n_events] = {
+            "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses"
+        };
+        return names[event];
+    }
+
+#ifdef __linux__
+    namespace {
+        constexpr uint64_t cache_read_miss(uint64_t cache)
+        {
+            return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        }
+
+        int open_event(uint32_t type, uint64_t config)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            // This thread, any CPU, no group. glibc has no wrapper.
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+        }
+    }
+
+    PerfCounters::PerfCounters()
+    {
+        const std::array<std::pair<uint32_t, uint64_t>, n_events> events = { {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_L1D) },
+            { PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_LL) },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+            { PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_DTLB) },
+        } };
+        fds.fill(-1);
+        for (size_t e = 0; e < n_events; ++e) {
+            fds[e] = open_event(events[e].first, events[e].second);
+            if (e == cycles && fds[e] < 0) {
+                why = std::string("perf_event_open: ") + std::strerror(errno);
+                if (errno == EACCES || errno == EPERM) {
+                    why += " (see /proc/sys/kernel/perf_event_paranoid)";
+                }
+                return;
+            }
+        }
+    }
+
+    PerfCounters::~PerfCounters()
+    {
+        for (const int fd : fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    bool PerfCounters::read(Event event, Reading& out) const
+    {
+        uint64_t buffer[3];
+        if (::read(fds[event], buffer, sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer))) {
+            return false;
+        }
+        out = { buffer[0], buffer[1], buffer[2] };
+        return true;
+    }
+
+    void PerfCounters::start()
+    {
+        for (size_t e = 0; e < n_events; ++e) {
+            if (fds[e] >= 0) {
+                ioctl(fds[e], PERF_EVENT_IOC_RESET, 0);
+                read(static_cast<Event>(e), at_start[e]);
+            }
+        }
+        for (const int fd : fds) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    PerfCounters::Counts PerfCounters::stop()
+    {
+        for (const int fd : fds) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+        Counts counts;
+        for (size_t e = 0; e < n_events; ++e) {
+            Reading now;
+            if (fds[e] < 0 || !read(static_cast<Event>(e), now)) {
+                continue;
+            }
+            // The times keep running across a reset; only the difference is
+            // this measurement's. An event never scheduled counted nothing we
+            // could scale, so it is left invalid.
+            const auto enabled = now.enabled - at_start[e].enabled;
+            const auto running = now.running - at_start[e].running;
+            if (running == 0) {
+                continue;
+            }
+            counts.value[e] = static_cast<double>(now.value) * static_cast<double>(enabled) / static_cast<double>(running);
+            counts.valid[e] = true;
+        }
+        return counts;
+    }
+#else
+    PerfCounters::PerfCounters() : why("perf_event_open is Linux-only")
+    {
+        fds.fill(-1);
+    }
+
+    PerfCounters::~PerfCounters() = default;
+
+    bool PerfCounters::read(Event, Reading&) const { return false; }
+
+    void PerfCounters::start() {}
+
+    PerfCounters::Counts PerfCounters::stop() { return {}; }
+#endif
+}
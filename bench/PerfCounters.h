@@ -0,0 +1,70 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_BENCH_PERFCOUNTERS_H
+#define MDLP_BENCH_PERFCOUNTERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace bench {
+    /**
+     * @brief Hardware counters of the calling thread, through perf_event_open
+     *
+     * Each event is opened on its own rather than as a group, so a PMU with
+     * fewer counters than events multiplexes them instead of refusing the
+     * group; the kernel reports how long each was actually counting and the
+     * counts are scaled up by that. Only user-space work is counted, which is
+     * what perf_event_paranoid 2, the usual default, allows.
+     *
+     * Never throws. If cycles cannot be counted — not Linux, a kernel that
+     * denies access, a container without the syscall — available() is false
+     * and error() says why; another event that fails on its own, as the cache
+     * events do on many virtual machines, is just left out.
+     */
+    class PerfCounters {
+    public:
+        enum Event { cycles, instructions, l1d_misses, llc_misses, branch_misses, dtlb_misses, n_events };
+
+        /** @brief Counts of one measurement; an event not counted is invalid */
+        struct Counts {
+            std::array<double, n_events> value{};
+            std::array<bool, n_events> valid{};
+        };
+
+        PerfCounters();
+        ~PerfCounters();
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        /** @brief Name of an event, as the JSON spells it */
+        static const char* name(Event event);
+
+        inline bool available() const { return fds[cycles] >= 0; }
+        inline bool has(Event event) const { return fds[event] >= 0; }
+        inline const std::string& error() const { return why; }
+
+        /** @brief Zero and start every open counter */
+        void start();
+        /** @brief Stop them and return what they counted since start() */
+        Counts stop();
+
+    private:
+        struct Reading {
+            uint64_t value = 0;
+            uint64_t enabled = 0;
+            uint64_t running = 0;
+        };
+        bool read(Event event, Reading& out) const;
+
+        std::array<int, n_events> fds;
+        std::array<Reading, n_events> at_start{};
+        std::string why;
+    };
+}
+#endif
@@ -0,0 +1,181 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "Workload.h"
+
+namespace bench {
+    namespace portable {
+        double u01(std::mt19937& rng)
+        {
+            return static_cast<double>(rng() >> 8) * (1.0 / 16777216.0);
+        }
+
+        int bounded(std::mt19937& rng, int k)
+        {
+            const int v = static_cast<int>(u01(rng) * static_cast<double>(k));
+            return v < k ? v : k - 1;
+        }
+
+        // Box-Muller would pull in std::log and std::cos, whose last-ulp
+        // results are not guaranteed to agree across platforms.
+        double normal01(std::mt19937& rng)
+        {
+            double s = 0.0;
+            for (int i = 0; i < 12; ++i) {
+                s += u01(rng);
+            }
+            return s - 6.0;
+        }
+    }
+
+    namespace {
+        using portable::bounded;
+        using portable::normal01;
+        using portable::u01;
+
+        void validate(const WorkloadSpec& spec)
+        {
+            if (spec.classes < 1) {
+                throw std::invalid_argument("Workload needs at least one class, got " + std::to_string(spec.classes));
+            }
+            if (!(spec.imbalance >= 1.0)) {
+                throw std::invalid_argument("Workload imbalance must be at least 1, got " + std::to_string(spec.imbalance));
+            }
+            if (!(spec.duplicates >= 0.0 && spec.duplicates <= 1.0)) {
+                throw std::invalid_argument("Workload duplicate share must be in [0, 1], got " + std::to_string(spec.duplicates));
+            }
+            if (!(spec.correlation >= 0.0 && spec.correlation <= 1.0)) {
+                throw std::invalid_argument("Workload correlation must be in [0, 1], got " + std::to_string(spec.correlation));
+            }
+        }
+
+        // Class c weighs imbalance - (imbalance - 1) * c / (classes - 1): linear,
+        // because a geometric fall would need std::pow.
+        class LabelDraw {
+        public:
+            explicit LabelDraw(const WorkloadSpec& spec) : classes(spec.classes), uniform(spec.imbalance == 1.0 || spec.classes == 1)
+            {
+                if (uniform) {
+                    return;
+                }
+                double total = 0.0;
+                for (int c = 0; c < classes; ++c) {
+                    total += spec.imbalance - (spec.imbalance - 1.0) * c / (classes - 1);
+                    cumulative.push_back(total);
+                }
+                for (auto& bound : cumulative) {
+                    bound /= total;
+                }
+            }
+            int operator()(std::mt19937& rng) const
+            {
+                if (uniform) {
+                    return bounded(rng, classes);
+                }
+                const double u = u01(rng);
+                int c = 0;
+                while (c < classes - 1 && u >= cumulative[static_cast<size_t>(c)]) {
+                    ++c;
+                }
+                return c;
+            }
+        private:
+            int classes;
+            bool uniform;
+            std::vector<double> cumulative;
+        };
+
+        double draw_value(const WorkloadSpec& spec, int centre, std::mt19937& rng)
+        {
+            const double at = static_cast<double>(centre) * 2.0;
+            switch (spec.distribution) {
+                case Distribution::uniform:
+                    return at + (u01(rng) * 2.0 - 1.0) * 1.5;
+                case Distribution::heavy_tailed: {
+                    const double numerator = normal01(rng);
+                    const double denominator = normal01(rng);
+                    return at + numerator / (denominator == 0.0 ? 1.0 : denominator);
+                }
+                case Distribution::integer:
+                    return std::floor(at + normal01(rng));
+                case Distribution::bimodal: {
+                    // Past the last class's first mode by more than the noise
+                    // reaches either side, so the modes never meet.
+                    const double far = static_cast<double>(spec.classes) * 2.0 + 12.0;
+                    return at + normal01(rng) + (bounded(rng, 2) == 1 ? far : 0.0);
+                }
+                case Distribution::normal:
+                default:
+                    return at + normal01(rng);
+            }
+        }
+    }
+
+    Workload generate(const WorkloadSpec& spec)
+    {
+        validate(spec);
+        std::mt19937 rng(spec.seed);
+        const LabelDraw draw_label(spec);
+        // Fresh values of each class, for the repeats to choose from.
+        std::vector<std::vector<mdlp::precision_t>> drawn(spec.duplicates > 0.0 ? static_cast<size_t>(spec.classes) : 0);
+        Workload w;
+        w.X.reserve(spec.n);
+        w.y.reserve(spec.n);
+        for (size_t i = 0; i < spec.n; ++i) {
+            // Each draw below is taken only when its field is off its default,
+            // which keeps the defaults on the sequence of dataset version 2.
+            const int label = draw_label(rng);
+            mdlp::precision_t value;
+            if (spec.duplicates > 0.0 && u01(rng) < spec.duplicates && !drawn[static_cast<size_t>(label)].empty()) {
+                const auto& earlier = drawn[static_cast<size_t>(label)];
+                value = earlier[static_cast<size_t>(bounded(rng, static_cast<int>(earlier.size())))];
+            } else {
+                int centre = label;
+                if (spec.correlation < 1.0 && u01(rng) >= spec.correlation) {
+                    centre = bounded(rng, spec.classes);
+                }
+                value = static_cast<mdlp::precision_t>(draw_value(spec, centre, rng));
+                if (spec.duplicates > 0.0) {
+                    drawn[static_cast<size_t>(label)].push_back(value);
+                }
+            }
+            w.X.push_back(value);
+            w.y.push_back(static_cast<mdlp::label_t>(label));
+        }
+        return w;
+    }
+
+    const char* name(Distribution distribution)
+    {
+        switch (distribution) {
+            case Distribution::uniform: return "uniform";
+            case Distribution::heavy_tailed: return "heavy_tailed";
+            case Distribution::integer: return "integer";
+            case Distribution::bimodal: return "bimodal";
+            case Distribution::normal:
+            default: return "normal";
+        }
+    }
+
+    std::string describe(const WorkloadSpec& spec)
+    {
+        const WorkloadSpec defaults;
+        std::ostringstream os;
+        const auto field = [&os](const char* key, const auto& value) {
+            os << (os.tellp() > 0 ? " " : "") << key << "=" << value;
+            };
+        if (spec.classes != defaults.classes) field("classes", spec.classes);
+        if (spec.imbalance != defaults.imbalance) field("imbalance", spec.imbalance);
+        if (spec.duplicates != defaults.duplicates) field("duplicates", spec.duplicates);
+        if (spec.distribution != defaults.distribution) field("distribution", name(spec.distribution));
+        if (spec.correlation != defaults.correlation) field("correlation", spec.correlation);
+        return os.tellp() > 0 ? os.str() : "default";
+    }
+}
@@ -0,0 +1,87 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_BENCH_WORKLOAD_H
+#define MDLP_BENCH_WORKLOAD_H
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include "typesFImdlp.h"
+
+namespace bench {
+    /** @brief How the values of a class spread around its centre */
+    enum class Distribution {
+        normal,        ///< Irwin-Hall approximation to N(0, 1)
+        uniform,       ///< Uniform over a band 3 wide, so neighbouring classes overlap
+        heavy_tailed,  ///< Ratio of two normals: Cauchy-like, a few values far out
+        integer,       ///< The normal rounded down to whole numbers: ties everywhere
+        bimodal        ///< Every class in two modes far apart
+    };
+
+    /**
+     * @brief What to generate; the defaults are benchmark dataset version 2
+     *
+     * Class c is centred at 2c. Every field away from its default changes the
+     * data; at the defaults generate() gives, bit for bit, the class-conditional
+     * normals the benchmark has always measured, so results stored before the
+     * generator existed stay comparable.
+     */
+    struct WorkloadSpec {
+        size_t n = 1000;                                  ///< Samples
+        int classes = 3;                                  ///< Labels 0 .. classes - 1
+        double imbalance = 1.0;                           ///< Frequency of class 0 over that of the last; falls linearly between
+        double duplicates = 0.0;                          ///< Share of samples repeating an earlier value of their class
+        Distribution distribution = Distribution::normal;
+        double correlation = 1.0;                         ///< Share of values drawn around their own class's centre; the rest around a random class's
+        unsigned seed = 42u;
+
+        WorkloadSpec& withN(size_t n_) { n = n_; return *this; }
+        WorkloadSpec& withClasses(int classes_) { classes = classes_; return *this; }
+        WorkloadSpec& withImbalance(double imbalance_) { imbalance = imbalance_; return *this; }
+        WorkloadSpec& withDuplicates(double duplicates_) { duplicates = duplicates_; return *this; }
+        WorkloadSpec& withDistribution(Distribution distribution_) { distribution = distribution_; return *this; }
+        WorkloadSpec& withCorrelation(double correlation_) { correlation = correlation_; return *this; }
+        WorkloadSpec& withSeed(unsigned seed_) { seed = seed_; return *this; }
+    };
+
+    struct Workload {
+        mdlp::samples_t X;
+        mdlp::labels_t y;
+    };
+
+    /**
+     * @brief The (X, y) columns spec describes, the same on every platform
+     *
+     * Only std::mt19937's raw output, integer operations and IEEE-754
+     * arithmetic are used: the standard distributions, std::log and std::pow
+     * may differ in the last bit between standard libraries, and a shared seed
+     * must give shared data.
+     * @throws std::invalid_argument for fewer than one class, an imbalance
+     * below 1, or a duplicate share or correlation outside [0, 1]
+     */
+    Workload generate(const WorkloadSpec& spec);
+
+    /**
+     * @brief The shape fields off their defaults, e.g. "classes=16 duplicates=0.9"
+     *
+     * n and the seed are left out; a spec at the defaults is "default".
+     */
+    std::string describe(const WorkloadSpec& spec);
+
+    /** @brief The distribution's name, as describe() writes it */
+    const char* name(Distribution distribution);
+
+    namespace portable {
+        /** @brief Uniform in [0, 1) with 24 bits; exact, the divisor is a power of two */
+        double u01(std::mt19937& rng);
+        /** @brief Uniform integer in [0, k) */
+        int bounded(std::mt19937& rng, int k);
+        /** @brief Twelve uniforms minus six: addition only */
+        double normal01(std::mt19937& rng);
+    }
+}
+#endif
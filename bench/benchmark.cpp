@@ -11,18 +11,52 @@
 // asserted. Build with `make bench`, which forces a Release (-O3) build.
 //
 // Statistics: min / median / mean over a FIXED number of repetitions, after
-// warmup. Repetition counts are identical on every platform on purpose — the
+// warmup. Every repetition's time is kept as well, in the order measured, so
+// two results can be compared with a significance test rather than by eye
+// (scripts/benchmarks.py compare). Repetition counts are identical on every platform on purpose — the
 // minimum of a sample shrinks as the sample grows, so comparing minima taken
 // with different rep counts would systematically favour whichever machine ran
 // more of them. Use the MEDIAN for cross-platform comparison and the MINIMUM for
 // before/after checks on one machine.
 //
+// Four suites. The synthetic one sweeps n over generated data, to show how each
+// operation scales. The real one loads the ARFF files bundled in tests/datasets
+// once each and times the load, then fit and transform of every discretizer
+// per feature and over the whole dataset, so the skew, duplicates and class
+// counts of real features are measured too. The scaling one runs the
+// parallel paths on 1, 2, 4 ... threads up to the hardware's, next to a serial
+// baseline, to show where they stop scaling. The workloads one holds n and
+// varies the data instead: class count, imbalance, duplicates, value
+// distribution and label-value correlation, from Workload.h. All write the same JSON schema; real rows also
+// name their dataset and, per feature, the attribute, workload rows their
+// workload, and scaling rows their thread count.
+//
+// Memory is measured alongside, always: AllocCounter.cpp replaces the global
+// operator new and delete, and every row reports the allocations and bytes of
+// a repetition and the peak of live bytes above what was live when it began.
+// Like the counters they cover the calling thread only. Unlike the times they
+// are exact, so a change in them is a change in the code.
+//
+// With --perf, each repetition is also counted by the CPU's performance
+// counters (PerfCounters.h): cycles, instructions, L1D, last-level cache and
+// dTLB read misses, and branch misses, reported per sample. They count the
+// calling thread in user space only, so the "(pool)" rows show what the caller
+// did, not the workers. Where the kernel refuses, the run goes on with
+// timings alone.
+//
 // Usage:
-//   benchmark [--json PATH] [--level quick|full]
-//     --json   also write machine-readable results to PATH
-//     --level  quick stops at n=10,000; full includes n=100,000 (default: full)
+//   benchmark [--json PATH] [--level quick|full] [--suite synthetic|real|scaling|workloads] [--datasets DIR] [--perf]
+//     --json      also write machine-readable results to PATH
+//     --level     quick stops at n=10,000; full includes n=100,000 (default: full).
+//                 For the real suite, quick skips datasets over 10,000 samples;
+//                 for the scaling suite, quick uses a quarter of the work;
+//                 for the workloads suite, quick uses n=10,000 instead of 100,000
+//     --suite     which data to measure (default: synthetic)
+//     --datasets  folder of the ARFF files (default: tests/datasets)
+//     --perf      also read the hardware counters (Linux)
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstring>
@@ -30,6 +64,9 @@
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <numeric>
 #include <random>
 #include <sstream>
@@ -40,31 +77,74 @@
 
 #include "BinDisc.h"
 #include "CPPFImdlp.h"
+#include "Executor.h"
+#include "Loader.h"
 #include "PKIDisc.h"
+#include "AllocCounter.h"
+#include "PerfCounters.h"
+#include "Workload.h"
 
 namespace {
 
     using clock_type = std::chrono::steady_clock;
     using mdlp::labels_t;
     using mdlp::samples_t;
+    using bench::PerfCounters;
 
     struct Stats {
         double min_ms = 0.0;
         double median_ms = 0.0;
         double mean_ms = 0.0;
         int reps = 0;
+        // Every repetition, in the order measured.
+        std::vector<double> samples_ms;
+        // Heap use per repetition, on the calling thread: allocations and
+        // bytes on average, and the highest peak of live bytes.
+        double allocations = 0.0;
+        double alloc_bytes = 0.0;
+        uint64_t peak_bytes = 0;
+        // Counts per repetition, with --perf; an event is valid only if every
+        // repetition counted it.
+        PerfCounters::Counts perf;
     };
 
     struct Result {
         std::string name;
         size_t n = 0;
         Stats stats;
+        // The dataset of a real row or the workload of a workloads row; empty
+        // elsewhere, and feature is empty for the whole-dataset rows.
+        std::string dataset;
+        std::string feature;
+        // Samples one repetition processes, when that is not n: a
+        // whole-dataset row processes every feature.
+        size_t elements = 0;
+        // Scaling suite only; threads is 0 elsewhere and on the serial
+        // baselines. Speedup is the baseline's median over this row's,
+        // efficiency the speedup per thread, and idle_ms how long each thread
+        // went without a task during a repetition, on average.
+        size_t threads = 0;
+        double speedup = 0.0;
+        double efficiency = 0.0;
+        double idle_ms = 0.0;
+
+        inline size_t samples() const { return elements > 0 ? elements : n; }
+    };
+
+    // What was measured, so two runs can be checked to have measured the same
+    // bytes. Synthetic datasets have no name.
+    struct DatasetInfo {
+        std::string name;
+        size_t n = 0;
+        size_t features = 0;
+        std::string checksum;
     };
 
     Stats summarize(std::vector<double>& samples, int reps)
     {
-        std::sort(samples.begin(), samples.end());
         Stats s;
+        s.samples_ms = samples;
+        std::sort(samples.begin(), samples.end());
         s.reps = reps;
         s.min_ms = samples.front();
         s.median_ms = samples[samples.size() / 2];
@@ -72,6 +152,58 @@ namespace {
         return s;
     }
 
+    // Set by --perf when the counters open; measure() then counts every
+    // repetition. Starting and stopping them are system calls, so both happen
+    // outside the timed region.
+    PerfCounters* counters = nullptr;
+
+    // What measure() keeps of each repetition besides its time: the heap it
+    // used (AllocCounter.h) and, with --perf, the counts. Summed, and averaged
+    // into the Stats at the end.
+    class Tally {
+    public:
+        inline void start() const
+        {
+            bench::alloc::begin();
+            if (counters) {
+                counters->start();
+            }
+        }
+        void stop()
+        {
+            if (counters) {
+                const auto counts = counters->stop();
+                for (size_t e = 0; e < PerfCounters::n_events; ++e) {
+                    perf.value[e] += counts.value[e];
+                    perf.valid[e] = (reps == 0 || perf.valid[e]) && counts.valid[e];
+                }
+            }
+            const auto heap = bench::alloc::end();
+            allocations += heap.allocations;
+            bytes += heap.bytes;
+            peak = std::max(peak, heap.peak);
+            ++reps;
+        }
+        void into(Stats& s) const
+        {
+            const double n = reps > 0 ? reps : 1;
+            s.allocations = static_cast<double>(allocations) / n;
+            s.alloc_bytes = static_cast<double>(bytes) / n;
+            s.peak_bytes = peak;
+            s.perf = perf;
+            for (auto& value : s.perf.value) {
+                value /= n;
+            }
+        }
+
+    private:
+        PerfCounters::Counts perf;
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        uint64_t peak = 0;
+        int reps = 0;
+    };
+
     Stats measure(const std::function<void()>& body, int reps, int warmup)
     {
         for (int i = 0; i < warmup; ++i) {
@@ -79,13 +211,18 @@ namespace {
         }
         std::vector<double> samples;
         samples.reserve(static_cast<size_t>(reps));
+        Tally tally;
         for (int i = 0; i < reps; ++i) {
+            tally.start();
             const auto t0 = clock_type::now();
             body();
             const auto t1 = clock_type::now();
+            tally.stop();
             samples.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
         }
-        return summarize(samples, reps);
+        auto s = summarize(samples, reps);
+        tally.into(s);
+        return s;
     }
 
     // For benchmarks whose body consumes its input, the replacement inputs must be
@@ -99,19 +236,21 @@ namespace {
         }
         std::vector<double> samples;
         samples.reserve(static_cast<size_t>(reps));
+        Tally tally;
         for (int i = 0; i < reps; ++i) {
+            tally.start();
             const auto t0 = clock_type::now();
             body(k++);
             const auto t1 = clock_type::now();
+            tally.stop();
             samples.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
         }
-        return summarize(samples, reps);
+        auto s = summarize(samples, reps);
+        tally.into(s);
+        return s;
     }
 
-    struct Dataset {
-        samples_t X;
-        labels_t y;
-    };
+    using Dataset = bench::Workload;
 
     // ---- portable pseudo-random data ---------------------------------------
     //
@@ -122,34 +261,10 @@ namespace {
     // results were comparing platforms that had each discretized a different
     // dataset — which makes cross-platform timings uninterpretable.
     //
-    // Everything below uses only integer operations and IEEE-754 addition, both
+    // Workload.cpp uses only integer operations and IEEE-754 arithmetic, both
     // of which are exactly specified, so the dataset is bit-identical everywhere.
     constexpr int DATASET_VERSION = 2;
 
-    // Uniform in [0,1), 24 bits of precision. Exact: the divisor is a power of two.
-    double u01(std::mt19937& rng)
-    {
-        return static_cast<double>(rng() >> 8) * (1.0 / 16777216.0);
-    }
-
-    int bounded(std::mt19937& rng, int k)
-    {
-        const int v = static_cast<int>(u01(rng) * static_cast<double>(k));
-        return v < k ? v : k - 1;
-    }
-
-    // Irwin-Hall approximation to N(0,1): twelve uniforms minus six. Addition
-    // only. Box-Muller would pull in std::log and std::cos, whose last-ulp
-    // results are not guaranteed to agree across platforms.
-    double normal01(std::mt19937& rng)
-    {
-        double s = 0.0;
-        for (int i = 0; i < 12; ++i) {
-            s += u01(rng);
-        }
-        return s - 6.0;
-    }
-
     uint64_t fnv1a(const void* data, size_t bytes, uint64_t h)
     {
         const auto* p = static_cast<const unsigned char*>(data);
@@ -176,17 +291,7 @@ namespace {
     // structure to find rather than degenerating to "no cut points".
     Dataset make_dataset(size_t n, int n_classes, unsigned seed = 42u)
     {
-        std::mt19937 rng(seed);
-        Dataset d;
-        d.X.reserve(n);
-        d.y.reserve(n);
-        for (size_t i = 0; i < n; ++i) {
-            const int label = bounded(rng, n_classes);
-            const double value = static_cast<double>(label) * 2.0 + normal01(rng);
-            d.X.push_back(static_cast<mdlp::precision_t>(value));
-            d.y.push_back(static_cast<mdlp::label_t>(label));
-        }
-        return d;
+        return bench::generate(bench::WorkloadSpec{}.withN(n).withClasses(n_classes).withSeed(seed));
     }
 
     // Lets the CPU governor ramp before anything is timed. Without it the first
@@ -228,28 +333,60 @@ namespace {
         return os.str();
     }
 
+    // The --perf columns: instructions per cycle, then each event per sample.
+    const char* const perf_columns[] = { "IPC", "cyc/el", "ins/el", "L1m/el", "LLCm/el", "brm/el", "TLBm/el" };
+
     void print_header()
     {
-        std::cout << std::left << std::setw(36) << "benchmark"
+        std::cout << std::left << std::setw(42) << "benchmark"
             << std::right << std::setw(10) << "n"
             << std::setw(7) << "reps"
             << std::setw(13) << "min (ms)"
             << std::setw(13) << "median (ms)"
             << std::setw(13) << "mean (ms)"
-            << "\n"
-            << std::string(92, '-') << "\n";
+            << std::setw(10) << "allocs"
+            << std::setw(12) << "alloc KiB"
+            << std::setw(12) << "peak KiB";
+        size_t width = 132;
+        if (counters) {
+            for (const auto* column : perf_columns) {
+                std::cout << std::setw(10) << column;
+            }
+            width += 10 * std::size(perf_columns);
+        }
+        std::cout << "\n"
+            << std::string(width, '-') << "\n";
     }
 
     void print_row(const Result& r)
     {
-        std::cout << std::left << std::setw(36) << r.name
+        std::cout << std::left << std::setw(42) << r.name
             << std::right << std::setw(10) << r.n
             << std::setw(7) << r.stats.reps
             << std::fixed
             << std::setw(13) << std::setprecision(4) << r.stats.min_ms
             << std::setw(13) << std::setprecision(4) << r.stats.median_ms
             << std::setw(13) << std::setprecision(4) << r.stats.mean_ms
-            << "\n";
+            << std::setw(10) << std::setprecision(0) << r.stats.allocations
+            << std::setw(12) << std::setprecision(1) << r.stats.alloc_bytes / 1024.0
+            << std::setw(12) << std::setprecision(1) << static_cast<double>(r.stats.peak_bytes) / 1024.0;
+        if (counters) {
+            const auto& perf = r.stats.perf;
+            const auto cell = [](bool valid, double value) {
+                if (valid) {
+                    std::cout << std::setw(10) << std::setprecision(3) << value;
+                } else {
+                    std::cout << std::setw(10) << "-";
+                }
+                };
+            cell(perf.valid[PerfCounters::cycles] && perf.valid[PerfCounters::instructions]
+                && perf.value[PerfCounters::cycles] > 0,
+                perf.value[PerfCounters::instructions] / perf.value[PerfCounters::cycles]);
+            for (size_t e = 0; e < PerfCounters::n_events; ++e) {
+                cell(perf.valid[e], perf.value[e] / static_cast<double>(r.samples()));
+            }
+        }
+        std::cout << "\n";
     }
 
     std::string json_escape(const std::string& s)
@@ -268,11 +405,12 @@ namespace {
 
     void write_json(const std::string& path,
         const std::vector<Result>& results,
+        const std::string& suite,
         const std::string& level,
         int n_classes,
         const Stats& drift_before,
         const Stats& drift_after,
-        const std::vector<std::pair<size_t, std::string>>& checksums)
+        const std::vector<DatasetInfo>& datasets)
     {
         std::ofstream f(path);
         if (!f) {
@@ -281,11 +419,14 @@ namespace {
         }
         f << std::fixed << std::setprecision(6);
         f << "{\n";
-        f << "  \"schema\": 2,\n";
+        f << "  \"schema\": 5,\n";
+        f << "  \"suite\": \"" << json_escape(suite) << "\",\n";
         f << "  \"dataset_version\": " << DATASET_VERSION << ",\n";
         f << "  \"library_version\": \"" << json_escape(mdlp::Discretizer::version()) << "\",\n";
         f << "  \"level\": \"" << json_escape(level) << "\",\n";
-        f << "  \"n_classes\": " << n_classes << ",\n";
+        if (n_classes > 0) {
+            f << "  \"n_classes\": " << n_classes << ",\n";
+        }
         f << "  \"seed\": 42,\n";
         f << "  \"build\": {\n";
         f << "    \"compiler\": \"" << json_escape(compiler_id()) << "\",\n";
@@ -298,11 +439,26 @@ namespace {
         f << "    \"before_median_ms\": " << drift_before.median_ms << ",\n";
         f << "    \"after_median_ms\": " << drift_after.median_ms << "\n";
         f << "  },\n";
+        if (counters) {
+            f << "  \"perf\": {\"scope\": \"calling thread, user space\", \"unit\": \"per sample\", \"events\": [";
+            bool first = true;
+            for (size_t e = 0; e < PerfCounters::n_events; ++e) {
+                if (counters->has(static_cast<PerfCounters::Event>(e))) {
+                    f << (first ? "" : ", ") << "\"" << PerfCounters::name(static_cast<PerfCounters::Event>(e)) << "\"";
+                    first = false;
+                }
+            }
+            f << "]},\n";
+        }
         f << "  \"datasets\": [\n";
-        for (size_t i = 0; i < checksums.size(); ++i) {
-            f << "    {\"n\": " << checksums[i].first
-                << ", \"checksum\": \"" << checksums[i].second << "\"}";
-            if (i + 1 < checksums.size()) f << ",";
+        for (size_t i = 0; i < datasets.size(); ++i) {
+            const auto& d = datasets[i];
+            f << "    {";
+            if (!d.name.empty()) {
+                f << "\"name\": \"" << json_escape(d.name) << "\", \"features\": " << d.features << ", ";
+            }
+            f << "\"n\": " << d.n << ", \"checksum\": \"" << d.checksum << "\"}";
+            if (i + 1 < datasets.size()) f << ",";
             f << "\n";
         }
         f << "  ],\n";
@@ -315,7 +471,41 @@ namespace {
                 << ", \"min_ms\": " << r.stats.min_ms
                 << ", \"median_ms\": " << r.stats.median_ms
                 << ", \"mean_ms\": " << r.stats.mean_ms
-                << "}";
+                << ", \"allocs\": " << r.stats.allocations
+                << ", \"alloc_bytes\": " << r.stats.alloc_bytes
+                << ", \"peak_bytes\": " << r.stats.peak_bytes;
+            if (!r.stats.samples_ms.empty()) {
+                f << ", \"samples_ms\": [";
+                for (size_t k = 0; k < r.stats.samples_ms.size(); ++k) {
+                    f << (k > 0 ? ", " : "") << r.stats.samples_ms[k];
+                }
+                f << "]";
+            }
+            if (!r.dataset.empty()) {
+                f << ", \"dataset\": \"" << json_escape(r.dataset) << "\"";
+            }
+            if (!r.feature.empty()) {
+                f << ", \"feature\": \"" << json_escape(r.feature) << "\"";
+            }
+            if (r.threads > 0) {
+                f << ", \"threads\": " << r.threads
+                    << ", \"speedup\": " << r.speedup
+                    << ", \"efficiency\": " << r.efficiency
+                    << ", \"idle_ms\": " << r.idle_ms;
+            }
+            if (counters) {
+                f << ", \"perf\": {";
+                bool first = true;
+                for (size_t e = 0; e < PerfCounters::n_events; ++e) {
+                    if (r.stats.perf.valid[e]) {
+                        f << (first ? "" : ", ") << "\"" << PerfCounters::name(static_cast<PerfCounters::Event>(e))
+                            << "\": " << r.stats.perf.value[e] / static_cast<double>(r.samples());
+                        first = false;
+                    }
+                }
+                f << "}";
+            }
+            f << "}";
             if (i + 1 < results.size()) f << ",";
             f << "\n";
         }
@@ -326,17 +516,465 @@ namespace {
     // Keeps the optimizer from discarding work whose result is otherwise unused.
     volatile size_t sink = 0;
 
+    using record_fn = std::function<void(Result, bool)>;
+
+    // Every operation at every size, on generated data.
+    void run_synthetic(const std::vector<size_t>& sizes, int n_classes, const record_fn& record_row,
+        std::vector<DatasetInfo>& datasets)
+    {
+        const auto record = [&](const std::string& name, size_t n, const Stats& s) {
+            record_row(Result{ name, n, s, "", "" }, true);
+            };
+        mdlp::ThreadPool pool;
+        for (const auto n : sizes) {
+            auto data = make_dataset(n, n_classes);
+            datasets.push_back({ "", n, 1, dataset_checksum(data) });
+            const int reps = reps_for(n);
+            const int warmup = warmup_for(n);
+
+            // --- fit: the operation that copies its inputs (see T5.1) ---
+            record("CPPFImdlp::fit", n, measure([&] {
+                mdlp::CPPFImdlp disc;
+                disc.fit(data.X, data.y);
+                sink += disc.getCutPoints().size();
+                }, reps, warmup));
+
+            record("BinDisc::fit (uniform)", n, measure([&] {
+                mdlp::BinDisc disc(5, mdlp::strategy_t::UNIFORM);
+                disc.fit(data.X, data.y);
+                sink += disc.getCutPoints().size();
+                }, reps, warmup));
+
+            record("BinDisc::fit (quantile)", n, measure([&] {
+                mdlp::BinDisc disc(5, mdlp::strategy_t::QUANTILE);
+                disc.fit(data.X, data.y);
+                sink += disc.getCutPoints().size();
+                }, reps, warmup));
+
+            record("PKIDisc::fit (sqrt)", n, measure([&] {
+                mdlp::PKIDisc disc(mdlp::compute_strategy_t::SQRT);
+                disc.fit(data.X, data.y);
+                sink += disc.getCutPoints().size();
+                }, reps, warmup));
+
+            // --- transform ---
+            mdlp::CPPFImdlp fitted_mdlp;
+            fitted_mdlp.fit(data.X, data.y);
+            record("CPPFImdlp::transform", n, measure([&] {
+                sink += fitted_mdlp.transform(data.X).size();
+                }, reps, warmup));
+
+            mdlp::BinDisc fitted_bin(5, mdlp::strategy_t::UNIFORM);
+            fitted_bin.fit(data.X, data.y);
+            record("BinDisc::transform", n, measure([&] {
+                sink += fitted_bin.transform(data.X).size();
+                }, reps, warmup));
+
+            // --- the static one-call forms, which copy the inputs once and
+            // return an owned result ---
+            record("CPPFImdlp::discretize", n, measure([&] {
+                sink += mdlp::CPPFImdlp::discretize(data.X, data.y).size();
+                }, reps, warmup));
+
+            record("BinDisc::discretize (quantile)", n, measure([&] {
+                sink += mdlp::BinDisc::discretize(data.X, data.y,
+                    mdlp::BinDiscConfig{}.withNBins(5).withStrategy(mdlp::strategy_t::QUANTILE)).size();
+                }, reps, warmup));
+
+            // --- copy cost of the inputs alone, for scale ---
+            record("(reference) copy X + y", n, measure([&] {
+                samples_t X_copy = data.X;
+                labels_t y_copy = data.y;
+                sink += X_copy.size() + y_copy.size();
+                }, reps, warmup));
+
+            // --- T5.1: rvalue fit(), against the copying rows above ---
+            {
+                const int pool_size = reps + warmup;
+                std::vector<samples_t> X_pool(static_cast<size_t>(pool_size), data.X);
+                std::vector<labels_t> y_pool(static_cast<size_t>(pool_size), data.y);
+                record("CPPFImdlp::fit (move)", n, measure_indexed([&](int i) {
+                    mdlp::CPPFImdlp disc;
+                    disc.fit(std::move(X_pool[static_cast<size_t>(i)]), std::move(y_pool[static_cast<size_t>(i)]));
+                    sink += disc.getCutPoints().size();
+                    }, reps, warmup));
+            }
+            // Control row: same pool, same access pattern, but copying. Reading a
+            // different pool slot each rep costs cache locality that the plain
+            // "BinDisc::fit (quantile)" row does not pay, so only this row is a fair
+            // baseline for the move row that follows.
+            {
+                const int pool_size = reps + warmup;
+                std::vector<samples_t> X_pool(static_cast<size_t>(pool_size), data.X);
+                std::vector<labels_t> y_pool(static_cast<size_t>(pool_size), data.y);
+                record("BinDisc::fit (quantile, pool copy)", n, measure_indexed([&](int i) {
+                    mdlp::BinDisc disc(5, mdlp::strategy_t::QUANTILE);
+                    disc.fit(X_pool[static_cast<size_t>(i)], y_pool[static_cast<size_t>(i)]);
+                    sink += disc.getCutPoints().size();
+                    }, reps, warmup));
+            }
+            {
+                const int pool_size = reps + warmup;
+                std::vector<samples_t> X_pool(static_cast<size_t>(pool_size), data.X);
+                std::vector<labels_t> y_pool(static_cast<size_t>(pool_size), data.y);
+                record("BinDisc::fit (quantile, move)", n, measure_indexed([&](int i) {
+                    mdlp::BinDisc disc(5, mdlp::strategy_t::QUANTILE);
+                    disc.fit(std::move(X_pool[static_cast<size_t>(i)]), std::move(y_pool[static_cast<size_t>(i)]));
+                    sink += disc.getCutPoints().size();
+                    }, reps, warmup));
+            }
+
+            // --- T5.2: transform into a reused caller buffer ---
+            labels_t out_buffer;
+            record("CPPFImdlp::transform (buffer)", n, measure([&] {
+                fitted_mdlp.transform(data.X, out_buffer);
+                sink += out_buffer.size();
+                }, reps, warmup));
+
+            // --- chunked transform on every hardware thread; the pool outlives the
+            // loop, so thread start-up is not in the measurement ---
+            record("CPPFImdlp::transform (pool)", n, measure([&] {
+                fitted_mdlp.transform(data.X, out_buffer, pool);
+                sink += out_buffer.size();
+                }, reps, warmup));
+
+            std::cout << "\n";
+        }
+
+    }
+
+    // The bundled datasets, smallest first, and whether each keeps its class
+    // attribute last.
+    const std::vector<std::pair<std::string, bool>> real_datasets = {
+        { "iris", true }, { "glass", true }, { "heart-statlog", true }, { "liver-disorders", true },
+        { "diabetes", true }, { "mfeat-factors", true }, { "kdd_JapaneseVowels", false }, { "letter", true },
+    };
+
+    struct Candidate {
+        std::string name;
+        std::function<std::unique_ptr<mdlp::Discretizer>()> make;
+    };
+
+    // The discretizers the synthetic suite fits, configured the same way.
+    std::vector<Candidate> candidates()
+    {
+        return {
+            { "CPPFImdlp", [] { return std::make_unique<mdlp::CPPFImdlp>(); } },
+            { "BinDisc (uniform)", [] { return std::make_unique<mdlp::BinDisc>(5, mdlp::strategy_t::UNIFORM); } },
+            { "BinDisc (quantile)", [] { return std::make_unique<mdlp::BinDisc>(5, mdlp::strategy_t::QUANTILE); } },
+            { "PKIDisc (sqrt)", [] { return std::make_unique<mdlp::PKIDisc>(mdlp::compute_strategy_t::SQRT); } },
+        };
+    }
+
+    std::string columns_checksum(const std::vector<samples_t>& X, const labels_t& y)
+    {
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (const auto& column : X) {
+            h = fnv1a(column.data(), column.size() * sizeof(mdlp::precision_t), h);
+        }
+        h = fnv1a(y.data(), y.size() * sizeof(mdlp::label_t), h);
+        std::ostringstream os;
+        os << std::hex << std::setw(16) << std::setfill('0') << h;
+        return os.str();
+    }
+
+    // Each file is loaded once; every discretizer is then fitted and applied
+    // to each feature alone and to all of them in turn. Per-feature rows go to
+    // the JSON only; the console shows the whole-dataset rows and the slowest
+    // feature of each, which is where the skew shows.
+    void run_real(const std::string& folder, size_t max_n, const record_fn& record_row,
+        std::vector<DatasetInfo>& datasets)
+    {
+        for (const auto& [name, class_last] : real_datasets) {
+            const auto path = folder + "/" + name + ".arff";
+            auto dataset = mdlp::load_arff(path, class_last);
+            auto& X = dataset.X;
+            auto& y = dataset.y;
+            const auto& attributes = dataset.attributes;
+            const size_t n = y.size();
+            if (n > max_n) {
+                continue;
+            }
+            datasets.push_back({ name, n, X.size(), columns_checksum(X, y) });
+            const int reps = reps_for(n);
+            const int warmup = warmup_for(n);
+            std::cout << name << ": " << n << " samples, " << X.size() << " features\n";
+            // Reading the file is part of what a user of the library waits for.
+            record_row({ "load_arff (dataset)", n, measure([&] {
+                sink += mdlp::load_arff(path, class_last).size();
+                }, reps, warmup), name, "", n * X.size() }, true);
+
+            labels_t out_buffer;
+            for (const auto& candidate : candidates()) {
+                const auto slowest_of = [&](const std::string& what, const std::function<void(size_t)>& body) {
+                    Result slowest;
+                    for (size_t j = 0; j < X.size(); ++j) {
+                        Result r{ candidate.name + "::" + what + " (feature)", n,
+                            measure([&] { body(j); }, reps, warmup), name, attributes[j].first };
+                        // Hundreds of features would each carry every
+                        // repetition; the whole-dataset rows keep theirs.
+                        r.stats.samples_ms.clear();
+                        record_row(r, false);
+                        if (r.stats.median_ms >= slowest.stats.median_ms) {
+                            slowest = r;
+                        }
+                    }
+                    slowest.name = "  slowest feature: " + slowest.feature;
+                    return slowest;
+                    };
+
+                const auto slowest_fit = slowest_of("fit", [&](size_t j) {
+                    auto disc = candidate.make();
+                    disc->fit(X[j], y);
+                    sink += disc->getCutPoints().size();
+                    });
+                record_row({ candidate.name + "::fit (dataset)", n, measure([&] {
+                    for (auto& column : X) {
+                        auto disc = candidate.make();
+                        disc->fit(column, y);
+                        sink += disc->getCutPoints().size();
+                    }
+                    }, reps, warmup), name, "", n * X.size() }, true);
+                print_row(slowest_fit);
+
+                std::vector<std::unique_ptr<mdlp::Discretizer>> models;
+                for (auto& column : X) {
+                    models.push_back(candidate.make());
+                    models.back()->fit(column, y);
+                }
+                const auto slowest_transform = slowest_of("transform", [&](size_t j) {
+                    models[j]->transform(X[j], out_buffer);
+                    sink += out_buffer.size();
+                    });
+                record_row({ candidate.name + "::transform (dataset)", n, measure([&] {
+                    for (size_t j = 0; j < X.size(); ++j) {
+                        models[j]->transform(X[j], out_buffer);
+                        sink += out_buffer.size();
+                    }
+                    }, reps, warmup), name, "", n * X.size() }, true);
+                print_row(slowest_transform);
+            }
+            std::cout << "\n";
+        }
+    }
+
+    // A ThreadPool that also sums how long its threads spent inside tasks.
+    // What a repetition's threads did not spend there they spent idle: waiting
+    // for a task, for the others to finish, or for the serial part of the
+    // call. Two clock reads per task, which here is a whole fit or a 64K-sample
+    // chunk.
+    class IdleProbe : public mdlp::Executor {
+    public:
+        explicit IdleProbe(size_t n_threads) : pool(n_threads) {}
+
+        inline size_t concurrency() const override { return pool.concurrency(); }
+        void run(size_t n_tasks, const std::function<void(size_t)>& task) override
+        {
+            pool.run(n_tasks, [&](size_t i) {
+                const auto t0 = clock_type::now();
+                task(i);
+                busy_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - t0).count(),
+                    std::memory_order_relaxed);
+                });
+        }
+
+        inline void reset() { busy_ns.store(0); }
+        /** @brief Mean idle time of a thread per repetition, given the repetitions since reset() */
+        double idle_ms(const Stats& s) const
+        {
+            const double busy_ms = static_cast<double>(busy_ns.load()) / 1e6;
+            return std::max(0.0, s.mean_ms - busy_ms / static_cast<double>(concurrency() * s.reps));
+        }
+
+    private:
+        mdlp::ThreadPool pool;
+        std::atomic<int64_t> busy_ns{ 0 };
+    };
+
+    // 1, 2, 4 ... below the hardware's thread count, then that count.
+    std::vector<size_t> thread_counts()
+    {
+        const size_t hardware = std::max<size_t>(1, std::thread::hardware_concurrency());
+        std::vector<size_t> counts;
+        for (size_t t = 1; t < hardware; t *= 2) {
+            counts.push_back(t);
+        }
+        counts.push_back(hardware);
+        return counts;
+    }
+
+    // Each workload is timed once serially, as the library runs it without an
+    // Executor, and then on an IdleProbe of every thread count. The rows are
+    // named per thread count so that bench-compare tests each on its own.
+    //
+    // There is no parallel cut search in the library; when one exists, it is a
+    // third workload here. Until then the two parallel paths are a fit per
+    // feature, as ColumnDiscretizer schedules it, and the chunked transform.
+    void run_scaling(bool quick, int n_classes, const record_fn& record_row,
+        std::vector<DatasetInfo>& datasets)
+    {
+        const int reps = 20;
+        const int warmup = 3;
+        const auto counts = thread_counts();
+
+        const auto scale = [&](const std::string& name, size_t n, size_t elements,
+            const std::function<void()>& serial, const std::function<void(mdlp::Executor&)>& parallel) {
+                Result baseline{ name + " (serial)", n, measure(serial, reps, warmup), "", "", elements };
+                record_row(baseline, true);
+                std::vector<Result> rows;
+                for (const auto t : counts) {
+                    IdleProbe probe(t);
+                    Result r{ name + " (" + std::to_string(t) + (t == 1 ? " thread)" : " threads)"), n,
+                        measure_indexed([&](int k) {
+                            if (k == warmup) {
+                                probe.reset();
+                            }
+                            parallel(probe);
+                            }, reps, warmup), "", "", elements };
+                    r.threads = t;
+                    r.speedup = baseline.stats.median_ms / r.stats.median_ms;
+                    r.efficiency = r.speedup / static_cast<double>(t);
+                    r.idle_ms = probe.idle_ms(r.stats);
+                    record_row(r, true);
+                    rows.push_back(r);
+                }
+                std::cout << "  " << std::left << std::setw(10) << "threads" << std::right
+                    << std::setw(10) << "speedup" << std::setw(12) << "efficiency" << std::setw(18) << "idle/thread (ms)" << "\n";
+                for (const auto& r : rows) {
+                    std::cout << "  " << std::left << std::setw(10) << r.threads << std::right << std::fixed
+                        << std::setw(9) << std::setprecision(2) << r.speedup << "x"
+                        << std::setw(11) << std::setprecision(1) << r.efficiency * 100.0 << "%"
+                        << std::setw(18) << std::setprecision(4) << r.idle_ms << "\n";
+                }
+                std::cout << "\n";
+            };
+
+        // --- a model per feature: one task each ---
+        const size_t n = 10000;
+        const size_t features = quick ? 16 : 64;
+        std::vector<samples_t> columns;
+        labels_t y;
+        for (size_t j = 0; j < features; ++j) {
+            auto data = make_dataset(n, n_classes, 42u + static_cast<unsigned>(j));
+            if (j == 0) {
+                y = std::move(data.y);
+            }
+            columns.push_back(std::move(data.X));
+        }
+        datasets.push_back({ "", n, features, columns_checksum(columns, y) });
+        std::vector<size_t> cuts(features);
+        const auto fit_feature = [&](size_t j) {
+            mdlp::CPPFImdlp disc;
+            disc.fit(columns[j], y);
+            cuts[j] = disc.getCutPoints().size();
+            };
+        scale("CPPFImdlp::fit per feature", n, n * features,
+            [&] {
+                for (size_t j = 0; j < features; ++j) {
+                    fit_feature(j);
+                }
+                sink += cuts.back();
+            },
+            [&](mdlp::Executor& executor) {
+                executor.run(features, fit_feature);
+                sink += cuts.back();
+            });
+
+        // --- transform: one task per 64K-sample chunk ---
+        const size_t big = quick ? size_t{ 1 } << 20 : size_t{ 1 } << 22;
+        auto data = make_dataset(big, n_classes);
+        datasets.push_back({ "", big, 1, dataset_checksum(data) });
+        mdlp::CPPFImdlp fitted;
+        fitted.fit(columns[0], y);
+        labels_t out;
+        scale("CPPFImdlp::transform by chunk", big, 0,
+            [&] {
+                fitted.transform(data.X, out);
+                sink += out.size();
+            },
+            [&](mdlp::Executor& executor) {
+                fitted.transform(data.X, out, executor);
+                sink += out.size();
+            });
+    }
+
+    // The shape of the data at a fixed n, one dimension at a time from the
+    // default: class count, class imbalance, duplicate share, value
+    // distribution and how closely values follow labels. getCandidate scans
+    // every class at every boundary, so the class sweep shows the O(n·k)
+    // terms; the duplicate and distribution sweeps show what ties do to the
+    // sort and to valueCutPoint.
+    void run_workloads(bool quick, const record_fn& record_row, std::vector<DatasetInfo>& datasets)
+    {
+        using bench::Distribution;
+        const size_t n = quick ? 10000 : 100000;
+        const auto base = bench::WorkloadSpec{}.withN(n);
+        std::vector<bench::WorkloadSpec> specs = { base };
+        for (const int k : { 2, 8, 16, 32, 64 }) {
+            specs.push_back(bench::WorkloadSpec(base).withClasses(k));
+        }
+        for (const double ratio : { 10.0, 100.0 }) {
+            specs.push_back(bench::WorkloadSpec(base).withImbalance(ratio));
+        }
+        for (const double share : { 0.5, 0.9, 0.99 }) {
+            specs.push_back(bench::WorkloadSpec(base).withDuplicates(share));
+        }
+        for (const auto distribution : { Distribution::uniform, Distribution::heavy_tailed, Distribution::integer, Distribution::bimodal }) {
+            specs.push_back(bench::WorkloadSpec(base).withDistribution(distribution));
+        }
+        for (const double correlation : { 0.5, 0.0 }) {
+            specs.push_back(bench::WorkloadSpec(base).withCorrelation(correlation));
+        }
+        const int reps = reps_for(n);
+        const int warmup = warmup_for(n);
+        for (const auto& spec : specs) {
+            const auto workload = bench::describe(spec);
+            auto data = bench::generate(spec);
+            datasets.push_back({ workload, n, 1, dataset_checksum(data) });
+            std::cout << workload << "\n";
+            const auto record = [&](const std::string& name, const Stats& stats) {
+                record_row(Result{ name, n, stats, workload, "" }, true);
+                };
+            record("CPPFImdlp::fit", measure([&] {
+                mdlp::CPPFImdlp disc;
+                disc.fit(data.X, data.y);
+                sink += disc.getCutPoints().size();
+                }, reps, warmup));
+            record("BinDisc::fit (quantile)", measure([&] {
+                mdlp::BinDisc disc(5, mdlp::strategy_t::QUANTILE);
+                disc.fit(data.X, data.y);
+                sink += disc.getCutPoints().size();
+                }, reps, warmup));
+            mdlp::CPPFImdlp fitted;
+            fitted.fit(data.X, data.y);
+            labels_t out;
+            record("CPPFImdlp::transform", measure([&] {
+                fitted.transform(data.X, out);
+                sink += out.size();
+                }, reps, warmup));
+        }
+    }
+
 }  // namespace
 
 int main(int argc, char** argv)
 {
     std::string json_path;
     std::string level = "full";
+    std::string suite = "synthetic";
+    std::string folder = "tests/datasets";
+    bool use_perf = false;
     for (int i = 1; i < argc; ++i) {
         if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
             json_path = argv[++i];
         } else if (std::strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
             level = argv[++i];
+        } else if (std::strcmp(argv[i], "--suite") == 0 && i + 1 < argc) {
+            suite = argv[++i];
+        } else if (std::strcmp(argv[i], "--datasets") == 0 && i + 1 < argc) {
+            folder = argv[++i];
+        } else if (std::strcmp(argv[i], "--perf") == 0) {
+            use_perf = true;
         } else {
             std::cerr << "benchmark: unknown argument " << argv[i] << "\n";
             return 1;
@@ -346,13 +984,16 @@ int main(int argc, char** argv)
         std::cerr << "benchmark: --level must be quick or full\n";
         return 1;
     }
+    if (suite != "synthetic" && suite != "real" && suite != "scaling" && suite != "workloads") {
+        std::cerr << "benchmark: --suite must be synthetic, real, scaling or workloads\n";
+        return 1;
+    }
 
     std::vector<size_t> sizes = { 100, 1000, 10000 };
     if (level == "full") {
         sizes.push_back(100000);
     }
     const int n_classes = 3;
-
     // Thermal drift probe: an identical small workload measured at the start and
     // again at the end. A machine that throttled over the run shows it here.
     const auto drift_data = make_dataset(1000, n_classes);
@@ -370,114 +1011,56 @@ int main(int argc, char** argv)
     std::cout << "mdlp benchmark (RELEASE_PLAN_V3.md Phase 0)\n"
         << "library version: " << mdlp::Discretizer::version() << "\n"
         << "compiler: " << compiler_id() << "\n"
-        << "level: " << level << ", classes: " << n_classes << ", seed: 42\n"
-        << "compare across platforms with the MEDIAN; rep counts are fixed\n\n";
+        << "suite: " << suite << ", level: " << level;
+    if (suite != "real" && suite != "workloads") {
+        std::cout << ", classes: " << n_classes << ", seed: 42";
+    }
+    std::cout << "\n"
+        << "compare across platforms with the MEDIAN; rep counts are fixed\n";
+    // Opened after the drift probe, which is measured the same way either way.
+    std::unique_ptr<PerfCounters> perf;
+    if (use_perf) {
+        perf = std::make_unique<PerfCounters>();
+        if (perf->available()) {
+            counters = perf.get();
+            std::cout << "hardware counters per sample, calling thread only";
+            std::string missing;
+            for (size_t e = 0; e < PerfCounters::n_events; ++e) {
+                if (!perf->has(static_cast<PerfCounters::Event>(e))) {
+                    missing += std::string(missing.empty() ? "" : ", ") + PerfCounters::name(static_cast<PerfCounters::Event>(e));
+                }
+            }
+            std::cout << (missing.empty() ? "" : "; not available here: " + missing) << "\n";
+        } else {
+            std::cout << "hardware counters unavailable, timing only: " << perf->error() << "\n";
+        }
+    }
+    std::cout << "\n";
 
     print_header();
 
     std::vector<Result> results;
-    std::vector<std::pair<size_t, std::string>> checksums;
-    const auto record = [&](const std::string& name, size_t n, const Stats& s) {
-        Result r{ name, n, s };
-        results.push_back(r);
-        print_row(r);
-        };
-
-    for (const auto n : sizes) {
-        auto data = make_dataset(n, n_classes);
-        checksums.emplace_back(n, dataset_checksum(data));
-        const int reps = reps_for(n);
-        const int warmup = warmup_for(n);
-
-        // --- fit: the operation that copies its inputs (see T5.1) ---
-        record("CPPFImdlp::fit", n, measure([&] {
-            mdlp::CPPFImdlp disc;
-            disc.fit(data.X, data.y);
-            sink += disc.getCutPoints().size();
-            }, reps, warmup));
-
-        record("BinDisc::fit (uniform)", n, measure([&] {
-            mdlp::BinDisc disc(5, mdlp::strategy_t::UNIFORM);
-            disc.fit(data.X, data.y);
-            sink += disc.getCutPoints().size();
-            }, reps, warmup));
-
-        record("BinDisc::fit (quantile)", n, measure([&] {
-            mdlp::BinDisc disc(5, mdlp::strategy_t::QUANTILE);
-            disc.fit(data.X, data.y);
-            sink += disc.getCutPoints().size();
-            }, reps, warmup));
-
-        record("PKIDisc::fit (sqrt)", n, measure([&] {
-            mdlp::PKIDisc disc(mdlp::compute_strategy_t::SQRT);
-            disc.fit(data.X, data.y);
-            sink += disc.getCutPoints().size();
-            }, reps, warmup));
-
-        // --- transform ---
-        mdlp::CPPFImdlp fitted_mdlp;
-        fitted_mdlp.fit(data.X, data.y);
-        record("CPPFImdlp::transform", n, measure([&] {
-            sink += fitted_mdlp.transform(data.X).size();
-            }, reps, warmup));
-
-        mdlp::BinDisc fitted_bin(5, mdlp::strategy_t::UNIFORM);
-        fitted_bin.fit(data.X, data.y);
-        record("BinDisc::transform", n, measure([&] {
-            sink += fitted_bin.transform(data.X).size();
-            }, reps, warmup));
-
-        // --- copy cost of the inputs alone, for scale ---
-        record("(reference) copy X + y", n, measure([&] {
-            samples_t X_copy = data.X;
-            labels_t y_copy = data.y;
-            sink += X_copy.size() + y_copy.size();
-            }, reps, warmup));
-
-        // --- T5.1: rvalue fit(), against the copying rows above ---
-        {
-            const int pool_size = reps + warmup;
-            std::vector<samples_t> X_pool(static_cast<size_t>(pool_size), data.X);
-            std::vector<labels_t> y_pool(static_cast<size_t>(pool_size), data.y);
-            record("CPPFImdlp::fit (move)", n, measure_indexed([&](int i) {
-                mdlp::CPPFImdlp disc;
-                disc.fit(std::move(X_pool[static_cast<size_t>(i)]), std::move(y_pool[static_cast<size_t>(i)]));
-                sink += disc.getCutPoints().size();
-                }, reps, warmup));
-        }
-        // Control row: same pool, same access pattern, but copying. Reading a
-        // different pool slot each rep costs cache locality that the plain
-        // "BinDisc::fit (quantile)" row does not pay, so only this row is a fair
-        // baseline for the move row that follows.
-        {
-            const int pool_size = reps + warmup;
-            std::vector<samples_t> X_pool(static_cast<size_t>(pool_size), data.X);
-            std::vector<labels_t> y_pool(static_cast<size_t>(pool_size), data.y);
-            record("BinDisc::fit (quantile, pool copy)", n, measure_indexed([&](int i) {
-                mdlp::BinDisc disc(5, mdlp::strategy_t::QUANTILE);
-                disc.fit(X_pool[static_cast<size_t>(i)], y_pool[static_cast<size_t>(i)]);
-                sink += disc.getCutPoints().size();
-                }, reps, warmup));
+    std::vector<DatasetInfo> datasets;
+    const auto record = [&](Result r, bool show) {
+        if (show) {
+            print_row(r);
         }
-        {
-            const int pool_size = reps + warmup;
-            std::vector<samples_t> X_pool(static_cast<size_t>(pool_size), data.X);
-            std::vector<labels_t> y_pool(static_cast<size_t>(pool_size), data.y);
-            record("BinDisc::fit (quantile, move)", n, measure_indexed([&](int i) {
-                mdlp::BinDisc disc(5, mdlp::strategy_t::QUANTILE);
-                disc.fit(std::move(X_pool[static_cast<size_t>(i)]), std::move(y_pool[static_cast<size_t>(i)]));
-                sink += disc.getCutPoints().size();
-                }, reps, warmup));
+        results.push_back(std::move(r));
+        };
+    if (suite == "synthetic") {
+        run_synthetic(sizes, n_classes, record, datasets);
+    } else if (suite == "scaling") {
+        run_scaling(level == "quick", n_classes, record, datasets);
+    } else if (suite == "workloads") {
+        run_workloads(level == "quick", record, datasets);
+    } else {
+        try {
+            run_real(folder, level == "quick" ? 10000 : std::numeric_limits<size_t>::max(), record, datasets);
+        } catch (const std::exception& e) {
+            std::cerr << "benchmark: " << e.what() << "\n"
+                << "  (run from the repository root or pass --datasets DIR)\n";
+            return 1;
         }
-
-        // --- T5.2: transform into a reused caller buffer ---
-        labels_t out_buffer;
-        record("CPPFImdlp::transform (buffer)", n, measure([&] {
-            fitted_mdlp.transform(data.X, out_buffer);
-            sink += out_buffer.size();
-            }, reps, warmup));
-
-        std::cout << "\n";
     }
 
     const Stats drift_after = measure(drift_body, 50, 10);
@@ -496,7 +1079,7 @@ int main(int argc, char** argv)
     }
 
     if (!json_path.empty()) {
-        write_json(json_path, results, level, n_classes, drift_before, drift_after, checksums);
+        write_json(json_path, results, suite, level, suite != "real" && suite != "workloads" ? n_classes : 0, drift_before, drift_after, datasets);
         std::cout << "wrote " << json_path << "\n";
     }
 
@@ -0,0 +1,250 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+// Kernel-level microbenchmarks, on Google Benchmark.
+//
+// benchmark.cpp times whole public operations; this times the pieces fit() and
+// transform() are made of, so a change to one of them can be measured on its
+// own. The protected kernels are reached through probe subclasses, the way the
+// unit tests reach them, and never through a change to the library.
+//
+// Every case sweeps n and, where they matter, the class count k and the
+// duplicate density: the percentage of samples that repeat a value already
+// present, which sets the length of the runs of equal values sortIndices(),
+// getCandidate() and valueCutPoint() walk. Items/second counts samples (counts
+// for entropyFromCounts); bytes/second counts the sample and label bytes read.
+//
+// Usage:
+//   microbench [--benchmark_filter=REGEX] [--benchmark_format=json] ...
+// Build with `make microbench`, which forces a Release (-O3) build.
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "BinDisc.h"
+#include "CPPFImdlp.h"
+#include "Metrics.h"
+#include "Workload.h"
+
+namespace {
+
+    using mdlp::indices_t;
+    using mdlp::label_t;
+    using mdlp::labels_t;
+    using mdlp::precision_t;
+    using mdlp::samples_t;
+
+    constexpr int64_t bytes_per_sample = sizeof(precision_t) + sizeof(label_t);
+
+    // n samples of which dup_percent repeat an earlier value of their class,
+    // labelled in k classes centred apart, so the class boundaries fall where
+    // a real feature's would. Seeded: every run sees the same data.
+    struct Workload : bench::Workload {
+        Workload(int64_t n, int64_t k, int64_t dup_percent)
+            : bench::Workload(bench::generate(bench::WorkloadSpec{}
+                .withN(static_cast<size_t>(n))
+                .withClasses(static_cast<int>(k))
+                .withDuplicates(static_cast<double>(dup_percent) / 100.0)
+                .withSeed(20260807u)))
+        {
+        }
+    };
+
+    // The protected steps of CPPFImdlp, on state prepared as fit() prepares it.
+    class MdlpKernels : public mdlp::CPPFImdlp {
+    public:
+        explicit MdlpKernels(const Workload& w)
+        {
+            X = w.X;
+            y = w.y;
+            indices = sortIndices(X, y);
+            metrics.setData(y, indices);
+        }
+        static indices_t sort(samples_t& X_, labels_t& y_) { return sortIndices(X_, y_); }
+        size_t candidate() { return getCandidate(0, X.size()); }
+        std::pair<precision_t, size_t> value(size_t cut) { return valueCutPoint(0, cut, X.size()); }
+        // Forgets the memoized entropies, so each resize pays for its scan.
+        void reset(const std::vector<precision_t>& cuts)
+        {
+            metrics.setData(y, indices);
+            cutPoints = cuts;
+        }
+        void resize() { resizeCutPoints(); }
+        std::vector<precision_t> fitted_cuts()
+        {
+            fit(X, y);
+            auto cuts = getCutPoints();
+            // The inner cuts only, as resizeCutPoints() sees them.
+            return std::vector<precision_t>(cuts.begin() + 1, cuts.end() - 1);
+        }
+    };
+
+    class MetricsProbe : public mdlp::Metrics {
+    public:
+        using Metrics::Metrics;
+        void forget() { entropyCache.clear(); igCache.clear(); }
+    };
+
+    void count_samples(benchmark::State& state, int64_t n)
+    {
+        state.SetItemsProcessed(state.iterations() * n);
+        state.SetBytesProcessed(state.iterations() * n * bytes_per_sample);
+    }
+
+    void BM_sortIndices(benchmark::State& state)
+    {
+        Workload w(state.range(0), state.range(1), state.range(2));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(MdlpKernels::sort(w.X, w.y));
+        }
+        count_samples(state, state.range(0));
+    }
+
+    void BM_getCandidate(benchmark::State& state)
+    {
+        MdlpKernels kernels(Workload(state.range(0), state.range(1), state.range(2)));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(kernels.candidate());
+        }
+        count_samples(state, state.range(0));
+    }
+
+    // Cost grows with the run of duplicates around the cut, not with n.
+    void BM_valueCutPoint(benchmark::State& state)
+    {
+        MdlpKernels kernels(Workload(state.range(0), state.range(1), state.range(2)));
+        auto cut = kernels.candidate();
+        if (cut == std::numeric_limits<size_t>::max()) {
+            cut = static_cast<size_t>(state.range(0) / 2);
+        }
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(kernels.value(cut));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_entropy(benchmark::State& state)
+    {
+        Workload w(state.range(0), state.range(1), 0);
+        indices_t order(w.X.size());
+        std::iota(order.begin(), order.end(), 0);
+        MetricsProbe metrics(w.y, order);
+        for (auto _ : state) {
+            metrics.forget();
+            benchmark::DoNotOptimize(metrics.entropy(0, w.y.size()));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * state.range(0)
+            * static_cast<int64_t>(sizeof(label_t) + sizeof(size_t)));
+    }
+
+    void BM_entropyFromCounts(benchmark::State& state)
+    {
+        const auto k = state.range(0);
+        labels_t counts(static_cast<size_t>(k));
+        int total = 0;
+        for (int64_t c = 0; c < k; ++c) {
+            counts[static_cast<size_t>(c)] = static_cast<label_t>(c + 1);
+            total += static_cast<int>(c + 1);
+        }
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(mdlp::Metrics::entropyFromCounts(counts, total));
+        }
+        state.SetItemsProcessed(state.iterations() * k);
+        state.SetBytesProcessed(state.iterations() * k * static_cast<int64_t>(sizeof(label_t)));
+    }
+
+    // One resize from the cuts of a full fit, with the entropy cache emptied
+    // first; the reset is not timed.
+    void BM_resizeCutPoints(benchmark::State& state)
+    {
+        MdlpKernels kernels(Workload(state.range(0), state.range(1), state.range(2)));
+        const auto cuts = kernels.fitted_cuts();
+        if (cuts.size() < 2) {
+            state.SkipWithError("the workload gives fewer than two cut points");
+            return;
+        }
+        for (auto _ : state) {
+            state.PauseTiming();
+            kernels.reset(cuts);
+            state.ResumeTiming();
+            kernels.resize();
+        }
+        state.counters["cuts"] = static_cast<double>(cuts.size());
+        count_samples(state, state.range(0));
+    }
+
+    // percentile() itself only interpolates between order statistics already
+    // in place; a QUANTILE fit selects them first, and that is the cost.
+    void BM_percentile(benchmark::State& state)
+    {
+        Workload w(state.range(0), 2, state.range(2));
+        mdlp::BinDisc disc(static_cast<int>(state.range(1)), mdlp::strategy_t::QUANTILE);
+        for (auto _ : state) {
+            disc.fit(w.X);
+            benchmark::DoNotOptimize(disc.getCutPoints().data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(precision_t)));
+    }
+
+    void BM_transform(benchmark::State& state)
+    {
+        Workload w(state.range(0), state.range(1), state.range(2));
+        mdlp::CPPFImdlp disc;
+        disc.fit(w.X, w.y);
+        labels_t out;
+        for (auto _ : state) {
+            disc.transform(w.X, out);
+            benchmark::DoNotOptimize(out.data());
+        }
+        state.counters["cuts"] = static_cast<double>(disc.getCutPoints().size());
+        count_samples(state, state.range(0));
+    }
+
+    // n x k x duplicate percentage.
+    void sweep(benchmark::internal::Benchmark* b)
+    {
+        b->ArgNames({ "n", "k", "dup" });
+        for (int64_t n : { 1 << 10, 1 << 14, 1 << 17 }) {
+            for (int64_t k : { 2, 8 }) {
+                for (int64_t dup : { 0, 50, 95 }) {
+                    b->Args({ n, k, dup });
+                }
+            }
+        }
+    }
+
+    // n x bins x duplicate percentage.
+    void quantile_sweep(benchmark::internal::Benchmark* b)
+    {
+        b->ArgNames({ "n", "bins", "dup" });
+        for (int64_t n : { 1 << 10, 1 << 14, 1 << 17, 1 << 20 }) {
+            for (int64_t bins : { 4, 16, 64 }) {
+                for (int64_t dup : { 0, 95 }) {
+                    b->Args({ n, bins, dup });
+                }
+            }
+        }
+    }
+}
+
+BENCHMARK(BM_sortIndices)->Apply(sweep);
+BENCHMARK(BM_getCandidate)->Apply(sweep);
+BENCHMARK(BM_valueCutPoint)->Apply(sweep);
+BENCHMARK(BM_entropy)->ArgNames({ "n", "k" })->ArgsProduct({ { 1 << 10, 1 << 14, 1 << 17 }, { 2, 8, 64 } });
+BENCHMARK(BM_entropyFromCounts)->ArgName("k")->RangeMultiplier(4)->Range(2, 512);
+BENCHMARK(BM_resizeCutPoints)->Apply(sweep);
+BENCHMARK(BM_percentile)->Apply(quantile_sweep);
+BENCHMARK(BM_transform)->Apply(sweep);
+
+BENCHMARK_MAIN();
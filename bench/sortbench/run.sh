@@ -23,6 +23,10 @@
 #
 # macOS realistically offers only AppleClang + libc++, which serves as the
 # reference point.
+#
+# `run.sh --candidates` instead builds once, with $CXX or g++, and times the
+# replacements for CPPFImdlp::sortIndices on every size and duplicate density.
+# Further arguments go to the program, e.g. `--threads 8` or `--csv`.
 
 set -uo pipefail
 
@@ -36,7 +40,7 @@ OUT="$(mktemp -d)"
 CSV="$OUT/results.csv"
 trap 'rm -rf "$OUT"' EXIT
 
-FLAGS="-O3 -std=c++17"
+FLAGS="-O3 -std=c++17 -pthread"
 BUILT=0
 FIRST=1
 
@@ -64,6 +68,16 @@ build_and_run() {
     BUILT=$((BUILT + 1))
 }
 
+if [ "${1:-}" = "--candidates" ]; then
+    shift
+    CXX="${CXX:-g++}"
+    echo ">>> sortbench: sort candidates, built with $CXX"
+    # shellcheck disable=SC2086
+    "$CXX" $FLAGS "$SRC" -o "$OUT/sortbench" || exit 1
+    "$OUT/sortbench" --candidates "$@"
+    exit $?
+fi
+
 echo ">>> sortbench: standalone toolchain diagnostic (no libtorch, no conan)"
 build_and_run "gcc_libstdcxx"    g++
 build_and_run "clang_libstdcxx"  clang++
@@ -34,18 +34,28 @@
 // not the library. A result here is a strong hypothesis about the cause, not a
 // measurement of mdlp. Confirming it inside the library would need an
 // ABI-compatible build, which is exactly what is unavailable.
+//
+// With --candidates it answers a second question: what should replace the
+// stable_sort in CPPFImdlp::sortIndices? Each candidate turns the same
+// (float, label) workloads into the library's order - ascending X, ties by
+// ascending y, equal pairs in input order - and is checked against the
+// stable_sort before it is timed, so a fast wrong answer cannot win. The
+// table names the winner for every size and duplicate density.
 
 #include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <functional>
+#include <iomanip>
 #include <iostream>
 #include <numeric>
 #include <random>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -220,6 +230,379 @@ namespace {
         sink += out.size();
     }
 
+    // ---- sort candidates (--candidates) -------------------------------------
+
+    // The workloads of make_dataset with a share of the samples repeating an
+    // earlier value: a pool of distinct values is drawn and sampled from, and
+    // one label in four is redrawn so that ties on X still differ in y.
+    Dataset make_duplicated(size_t n, double duplicates, int n_classes, unsigned seed = 42u)
+    {
+        if (duplicates <= 0.0) {
+            return make_dataset(n, n_classes, seed);
+        }
+        const size_t distinct = std::max<size_t>(1, static_cast<size_t>(static_cast<double>(n) * (1.0 - duplicates)));
+        const auto pool = make_dataset(distinct, n_classes, seed);
+        std::mt19937 rng(seed + 1);
+        Dataset d;
+        d.X.reserve(n);
+        d.y.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            const auto j = static_cast<size_t>(bounded(rng, static_cast<int>(distinct)));
+            d.X.push_back(pool.X[j]);
+            d.y.push_back(bounded(rng, 4) == 0 ? bounded(rng, n_classes) : pool.y[j]);
+        }
+        return d;
+    }
+
+    // A float's bits, flipped so that unsigned order is numeric order. -0 is
+    // folded into +0 first, since the library's comparator finds them equal.
+    uint32_t ordered_bits(precision_t x)
+    {
+        if (x == 0) {
+            x = 0;
+        }
+        uint32_t bits;
+        std::memcpy(&bits, &x, sizeof bits);
+        return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+    }
+
+    // What every candidate but the index-free one sorts: the value, the label
+    // and the position, compared in that order. The position makes the order
+    // total, so any sort, stable or not, gives the stable order.
+    struct Record {
+        precision_t x;
+        label_t y;
+        uint32_t i;
+    };
+
+    bool record_less(const Record& a, const Record& b)
+    {
+        if (a.x != b.x) return a.x < b.x;
+        if (a.y != b.y) return a.y < b.y;
+        return a.i < b.i;
+    }
+
+    std::vector<Record> records(const samples_t& X, const labels_t& y)
+    {
+        std::vector<Record> r(X.size());
+        for (size_t i = 0; i < X.size(); ++i) {
+            r[i] = { X[i], y[i], static_cast<uint32_t>(i) };
+        }
+        return r;
+    }
+
+    indices_t positions(const std::vector<Record>& r)
+    {
+        indices_t idx(r.size());
+        for (size_t i = 0; i < r.size(); ++i) {
+            idx[i] = r[i].i;
+        }
+        return idx;
+    }
+
+    // The library's sortIndices, without the bounds checks: the baseline every
+    // candidate is checked against and timed against.
+    indices_t sort_stable_index(const samples_t& X, const labels_t& y)
+    {
+        indices_t idx(X.size());
+        std::iota(idx.begin(), idx.end(), 0);
+        std::stable_sort(idx.begin(), idx.end(), [&X, &y](size_t i1, size_t i2) {
+            return X[i1] == X[i2] ? y[i1] < y[i2] : X[i1] < X[i2];
+            });
+        return idx;
+    }
+
+    indices_t sort_std_tiebreak(const samples_t& X, const labels_t& y)
+    {
+        auto r = records(X, y);
+        std::sort(r.begin(), r.end(), record_less);
+        return positions(r);
+    }
+
+    // Pattern-defeating quicksort (Peters, 2021), written out here because the
+    // program takes no dependencies: median of three, or Tukey's ninther above
+    // 128 elements, a partition that reports when the input was already
+    // partitioned so that a bounded insertion sort can finish sorted runs in
+    // linear time, pattern-breaking swaps after an unbalanced partition, and
+    // heapsort once log2(n) of those have happened. The records are unique, so
+    // pdqsort's separate pass for elements equal to the pivot is left out.
+    namespace pdq {
+        constexpr ptrdiff_t insertion_threshold = 24;
+        constexpr ptrdiff_t ninther_threshold = 128;
+        constexpr ptrdiff_t partial_insertion_limit = 8;
+
+        using It = std::vector<Record>::iterator;
+
+        void insertion_sort(It begin, It end)
+        {
+            if (begin == end) return;
+            for (It cur = begin + 1; cur != end; ++cur) {
+                if (record_less(*cur, *(cur - 1))) {
+                    Record tmp = *cur;
+                    It sift = cur;
+                    do {
+                        *sift = *(sift - 1);
+                        --sift;
+                    } while (sift != begin && record_less(tmp, *(sift - 1)));
+                    *sift = tmp;
+                }
+            }
+        }
+
+        // Gives up, returning false, after moving more than a few elements.
+        bool partial_insertion_sort(It begin, It end)
+        {
+            if (begin == end) return true;
+            ptrdiff_t moved = 0;
+            for (It cur = begin + 1; cur != end; ++cur) {
+                if (moved > partial_insertion_limit) return false;
+                if (record_less(*cur, *(cur - 1))) {
+                    Record tmp = *cur;
+                    It sift = cur;
+                    do {
+                        *sift = *(sift - 1);
+                        --sift;
+                    } while (sift != begin && record_less(tmp, *(sift - 1)));
+                    *sift = tmp;
+                    moved += cur - sift;
+                }
+            }
+            return true;
+        }
+
+        void sort2(It a, It b)
+        {
+            if (record_less(*b, *a)) std::iter_swap(a, b);
+        }
+
+        void sort3(It a, It b, It c)
+        {
+            sort2(a, b);
+            sort2(b, c);
+            sort2(a, b);
+        }
+
+        // The pivot is at begin and something not less than it at end - 1, so
+        // the scans from the left need no bounds check.
+        std::pair<It, bool> partition_right(It begin, It end)
+        {
+            const Record pivot = *begin;
+            It first = begin;
+            It last = end;
+            while (record_less(*++first, pivot)) {
+            }
+            if (first - 1 == begin) {
+                while (first < last && !record_less(*--last, pivot)) {
+                }
+            } else {
+                while (!record_less(*--last, pivot)) {
+                }
+            }
+            const bool already_partitioned = first >= last;
+            while (first < last) {
+                std::iter_swap(first, last);
+                while (record_less(*++first, pivot)) {
+                }
+                while (!record_less(*--last, pivot)) {
+                }
+            }
+            It pivot_pos = first - 1;
+            *begin = *pivot_pos;
+            *pivot_pos = pivot;
+            return { pivot_pos, already_partitioned };
+        }
+
+        void loop(It begin, It end, int bad_allowed)
+        {
+            while (true) {
+                const ptrdiff_t size = end - begin;
+                if (size < insertion_threshold) {
+                    insertion_sort(begin, end);
+                    return;
+                }
+                const ptrdiff_t half = size / 2;
+                if (size > ninther_threshold) {
+                    sort3(begin, begin + half, end - 1);
+                    sort3(begin + 1, begin + (half - 1), end - 2);
+                    sort3(begin + 2, begin + (half + 1), end - 3);
+                    sort3(begin + (half - 1), begin + half, begin + (half + 1));
+                    std::iter_swap(begin, begin + half);
+                } else {
+                    sort3(begin + half, begin, end - 1);
+                }
+                const auto [pivot_pos, already_partitioned] = partition_right(begin, end);
+                const ptrdiff_t l_size = pivot_pos - begin;
+                const ptrdiff_t r_size = end - (pivot_pos + 1);
+                if (l_size < size / 8 || r_size < size / 8) {
+                    if (--bad_allowed == 0) {
+                        std::make_heap(begin, end, record_less);
+                        std::sort_heap(begin, end, record_less);
+                        return;
+                    }
+                    if (l_size >= insertion_threshold) {
+                        std::iter_swap(begin, begin + l_size / 4);
+                        std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                    }
+                    if (r_size >= insertion_threshold) {
+                        std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                        std::iter_swap(end - 1, end - r_size / 4);
+                    }
+                } else if (already_partitioned && partial_insertion_sort(begin, pivot_pos)
+                    && partial_insertion_sort(pivot_pos + 1, end)) {
+                    return;
+                }
+                // Recurse into the left part, loop on the right.
+                loop(begin, pivot_pos, bad_allowed);
+                begin = pivot_pos + 1;
+            }
+        }
+
+        void sort(It begin, It end)
+        {
+            int log2n = 0;
+            for (auto n = end - begin; n > 1; n >>= 1) {
+                ++log2n;
+            }
+            loop(begin, end, log2n);
+        }
+    }
+
+    indices_t sort_pdq_tiebreak(const samples_t& X, const labels_t& y)
+    {
+        auto r = records(X, y);
+        pdq::sort(r.begin(), r.end());
+        return positions(r);
+    }
+
+    // LSD radix sort on one 64-bit key per sample: the ordered float bits on
+    // top, the label offset by the smallest one below them, the position in
+    // the low bits. Positions already ascend and LSD passes are stable, so the
+    // passes start above them; a pass whose digit is the same for every key
+    // is skipped, which drops the unused label bits. Empty when the three do
+    // not fit in 64 bits.
+    indices_t sort_radix_packed(const samples_t& X, const labels_t& y)
+    {
+        const size_t n = X.size();
+        int index_bits = 0;
+        while (index_bits < 64 && (uint64_t{ 1 } << index_bits) < n) {
+            ++index_bits;
+        }
+        const auto [ymin, ymax] = std::minmax_element(y.begin(), y.end());
+        const auto label_range = static_cast<uint64_t>(static_cast<int64_t>(*ymax) - *ymin);
+        int label_bits = 0;
+        while ((uint64_t{ 1 } << label_bits) <= label_range) {
+            ++label_bits;
+        }
+        if (index_bits + label_bits > 32) {
+            return {};
+        }
+        const uint64_t index_mask = (uint64_t{ 1 } << index_bits) - 1;
+        std::vector<uint64_t> keys(n);
+        for (size_t i = 0; i < n; ++i) {
+            keys[i] = uint64_t{ ordered_bits(X[i]) } << 32
+                | static_cast<uint64_t>(static_cast<int64_t>(y[i]) - *ymin) << index_bits
+                | i;
+        }
+        std::vector<uint64_t> buffer(n);
+        constexpr int digit_bits = 8;
+        constexpr size_t buckets = size_t{ 1 } << digit_bits;
+        for (int shift = index_bits; shift < 64; shift += digit_bits) {
+            size_t count[buckets] = {};
+            for (const auto key : keys) {
+                ++count[(key >> shift) & (buckets - 1)];
+            }
+            if (count[(keys[0] >> shift) & (buckets - 1)] == n) {
+                continue;
+            }
+            size_t offset = 0;
+            for (auto& c : count) {
+                const size_t here = c;
+                c = offset;
+                offset += here;
+            }
+            for (const auto key : keys) {
+                buffer[count[(key >> shift) & (buckets - 1)]++] = key;
+            }
+            keys.swap(buffer);
+        }
+        indices_t idx(n);
+        for (size_t i = 0; i < n; ++i) {
+            idx[i] = static_cast<size_t>(keys[i] & index_mask);
+        }
+        return idx;
+    }
+
+    // A stable sort of one slice per thread, then rounds of pairwise merges,
+    // each round's merges in parallel. std::merge takes from the left range on
+    // ties, so the result is the stable order without the position in the key.
+    indices_t sort_parallel_merge(const samples_t& X, const labels_t& y, unsigned threads)
+    {
+        auto r = records(X, y);
+        const auto less = [](const Record& a, const Record& b) {
+            return a.x == b.x ? a.y < b.y : a.x < b.x;
+        };
+        const size_t n = r.size();
+        const size_t parts = std::max<size_t>(1, std::min<size_t>(threads, n));
+        std::vector<size_t> bounds(parts + 1);
+        for (size_t p = 0; p <= parts; ++p) {
+            bounds[p] = n * p / parts;
+        }
+        const auto in_parallel = [](size_t tasks, const std::function<void(size_t)>& task) {
+            std::vector<std::thread> pool;
+            for (size_t t = 1; t < tasks; ++t) {
+                pool.emplace_back(task, t);
+            }
+            if (tasks > 0) task(0);
+            for (auto& thread : pool) thread.join();
+        };
+        in_parallel(parts, [&](size_t p) {
+            std::stable_sort(r.begin() + static_cast<ptrdiff_t>(bounds[p]),
+                r.begin() + static_cast<ptrdiff_t>(bounds[p + 1]), less);
+            });
+        std::vector<Record> buffer(n);
+        while (bounds.size() > 2) {
+            const size_t runs = bounds.size() - 1;
+            std::vector<size_t> merged;
+            for (size_t p = 0; p < runs; p += 2) {
+                merged.push_back(bounds[p]);
+            }
+            merged.push_back(n);
+            in_parallel((runs + 1) / 2, [&](size_t m) {
+                const auto at = [](std::vector<Record>& v, size_t i) { return v.begin() + static_cast<ptrdiff_t>(i); };
+                const size_t lo = bounds[2 * m];
+                const size_t mid = bounds[std::min(2 * m + 1, runs)];
+                const size_t hi = bounds[std::min(2 * m + 2, runs)];
+                std::merge(at(r, lo), at(r, mid), at(r, mid), at(r, hi), at(buffer, lo), less);
+                });
+            r.swap(buffer);
+            bounds = merged;
+        }
+        return positions(r);
+    }
+
+    // Sorts the (value, label) pairs themselves, packed into one 64-bit key,
+    // and gives back the sorted columns instead of a permutation. Equal pairs
+    // are indistinguishable, so stability costs nothing. This is the floor for
+    // a fit that worked on sorted copies rather than through an index.
+    Dataset sort_index_free(const samples_t& X, const labels_t& y)
+    {
+        std::vector<uint64_t> keys(X.size());
+        for (size_t i = 0; i < X.size(); ++i) {
+            keys[i] = uint64_t{ ordered_bits(X[i]) } << 32 | (static_cast<uint32_t>(y[i]) ^ 0x80000000u);
+        }
+        std::sort(keys.begin(), keys.end());
+        Dataset sorted;
+        sorted.X.resize(keys.size());
+        sorted.y.resize(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            const auto bits = static_cast<uint32_t>(keys[i] >> 32);
+            const uint32_t raw = bits & 0x80000000u ? bits & 0x7fffffffu : ~bits;
+            std::memcpy(&sorted.X[i], &raw, sizeof raw);
+            sorted.y[i] = static_cast<label_t>(static_cast<uint32_t>(keys[i]) ^ 0x80000000u);
+        }
+        return sorted;
+    }
+
     int reps_for(size_t n) { return n <= 1000 ? 500 : (n <= 10000 ? 200 : 30); }
 
     void emit(const std::string& label, const std::string& toolchain,
@@ -229,15 +612,122 @@ namespace {
             << s.min_ms << "," << s.median_ms << "\n";
     }
 
+    int candidate_reps(size_t n) { return n <= 100000 ? reps_for(n) : 10; }
+
+    struct Candidate {
+        std::string name;
+        std::function<indices_t(const samples_t&, const labels_t&)> sort;
+    };
+
+    // Every candidate on every size and duplicate density: checked against
+    // the library's order, then timed. The table gives the median of each and
+    // the fastest replacement with its speedup over stable_sort; --csv prints
+    // the rows instead. Returns 1 if any candidate gets the order wrong.
+    int run_candidates(const std::string& label, const std::string& toolchain, bool csv, unsigned threads)
+    {
+        const std::vector<Candidate> candidates = {
+            { "stable_sort<index>", sort_stable_index },
+            { "std::sort+tiebreak", sort_std_tiebreak },
+            { "pdqsort+tiebreak", sort_pdq_tiebreak },
+            { "radix<packed>", sort_radix_packed },
+            { "merge x" + std::to_string(threads),
+                [threads](const samples_t& X, const labels_t& y) { return sort_parallel_merge(X, y, threads); } },
+        };
+        const std::string index_free = "index-free";
+        if (csv) {
+            std::cout << "label,toolchain,candidate,n,duplicates,min_ms,median_ms\n";
+        } else {
+            std::cout << "Sort candidates for CPPFImdlp::sortIndices, " << toolchain << ", "
+                << threads << " thread(s) for the merge. Median ms.\n\n";
+            std::cout << std::setw(9) << "n" << std::setw(7) << "dup";
+            for (const auto& c : candidates) std::cout << std::setw(21) << c.name;
+            std::cout << std::setw(12) << index_free << "   winner\n";
+        }
+        for (const size_t n : { size_t(1000), size_t(10000), size_t(100000), size_t(1000000) }) {
+            for (const double duplicates : { 0.0, 0.5, 0.9, 0.99 }) {
+                const auto d = make_duplicated(n, duplicates, 3);
+                const auto expected = sort_stable_index(d.X, d.y);
+                for (const auto& c : candidates) {
+                    const auto got = c.sort(d.X, d.y);
+                    if (!got.empty() && got != expected) {
+                        std::cerr << c.name << " gives a different order at n=" << n
+                            << " duplicates=" << duplicates << "\n";
+                        return 1;
+                    }
+                }
+                const auto flat = sort_index_free(d.X, d.y);
+                for (size_t i = 0; i < n; ++i) {
+                    if (flat.X[i] != d.X[expected[i]] || flat.y[i] != d.y[expected[i]]) {
+                        std::cerr << index_free << " gives different columns at n=" << n
+                            << " duplicates=" << duplicates << "\n";
+                        return 1;
+                    }
+                }
+                const int reps = candidate_reps(n);
+                const int warmup = 3;
+                std::vector<Stats> stats;
+                for (const auto& c : candidates) {
+                    if (c.sort(d.X, d.y).empty()) {
+                        stats.push_back({ -1.0, -1.0 });  // does not apply
+                        continue;
+                    }
+                    stats.push_back(measure([&] { sink += c.sort(d.X, d.y).size(); }, reps, warmup));
+                }
+                const auto floor = measure([&] { sink += sort_index_free(d.X, d.y).X.size(); }, reps, warmup);
+                if (csv) {
+                    for (size_t k = 0; k < candidates.size(); ++k) {
+                        if (stats[k].median_ms < 0) continue;
+                        std::cout << label << "," << toolchain << "," << candidates[k].name << "," << n << ","
+                            << duplicates << "," << stats[k].min_ms << "," << stats[k].median_ms << "\n";
+                    }
+                    std::cout << label << "," << toolchain << "," << index_free << "," << n << ","
+                        << duplicates << "," << floor.min_ms << "," << floor.median_ms << "\n";
+                    continue;
+                }
+                size_t best = 0;
+                std::cout << std::setw(9) << n << std::setw(7) << std::setprecision(2) << duplicates
+                    << std::setprecision(4);
+                for (size_t k = 0; k < candidates.size(); ++k) {
+                    if (stats[k].median_ms < 0) {
+                        std::cout << std::setw(21) << "-";
+                        continue;
+                    }
+                    std::cout << std::setw(21) << stats[k].median_ms;
+                    if (stats[k].median_ms < stats[best].median_ms) best = k;
+                }
+                std::cout << std::setw(12) << floor.median_ms << "   " << candidates[best].name;
+                if (best != 0) {
+                    std::cout << " (" << std::setprecision(2) << stats[0].median_ms / stats[best].median_ms
+                        << "x)" << std::setprecision(4);
+                }
+                std::cout << "\n";
+            }
+        }
+        if (!csv) {
+            std::cout << "\nEvery candidate was checked against stable_sort<index> first. "
+                "index-free returns the\nsorted columns, not a permutation, and is not a "
+                "candidate for the winner.\n";
+        }
+        return 0;
+    }
+
 }  // namespace
 
 int main(int argc, char** argv)
 {
     bool header = false;
+    bool candidates = false;
+    bool csv = false;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
     std::string label = "build";
     for (int i = 1; i < argc; ++i) {
         if (std::strcmp(argv[i], "--header") == 0) header = true;
         else if (std::strcmp(argv[i], "--label") == 0 && i + 1 < argc) label = argv[++i];
+        else if (std::strcmp(argv[i], "--candidates") == 0) candidates = true;
+        else if (std::strcmp(argv[i], "--csv") == 0) csv = true;
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
     }
     // The label is how the build was invoked; the toolchain is what that
     // invocation actually resolved to. On macOS g++ is a symlink to clang, so
@@ -258,6 +748,10 @@ int main(int argc, char** argv)
         while (clock_type::now() < deadline) shape_sort_floats(warm.X);
     }
 
+    if (candidates) {
+        return run_candidates(label, toolchain, csv, threads);
+    }
+
     for (const size_t n : { size_t(1000), size_t(10000), size_t(100000) }) {
         const auto d = make_dataset(n, 3);
         const int reps = reps_for(n);
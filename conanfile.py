@@ -21,12 +21,18 @@ class FimdlpConan(ConanFile):
         "fPIC": [True, False],
         "enable_testing": [True, False],
         "enable_sample": [True, False],
+        "enable_benchmark": [True, False],
+        "with_torch": [True, False],
+        "enable_tracing": [True, False],
     }
     default_options = {
         "shared": False,
         "fPIC": True,
         "enable_testing": False,
         "enable_sample": False,
+        "enable_benchmark": False,
+        "with_torch": True,
+        "enable_tracing": False,
     }
     
     # Sources are located in the same place as this recipe, copy them to the recipe
@@ -50,17 +56,21 @@ class FimdlpConan(ConanFile):
             self.options.rm_safe("fPIC")
     
     def requirements(self):
-        # PyTorch dependency for tensor operations.
-        # transitive_headers because Discretizer.h includes <torch/torch.h>, so any
-        # consumer needs libtorch's include path to compile fimdlp's own headers;
+        # PyTorch dependency for the tensor entry points in fimdlp_torch only.
+        # transitive_headers because DiscretizerTorch.h includes <torch/torch.h>,
+        # so a consumer of fimdlp_torch needs libtorch's include path to compile
+        # fimdlp's own headers;
         # transitive_libs because they then need to link it too. Without these the
         # published package fails to compile in test_package.
-        self.requires("libtorch/2.7.1", transitive_headers=True, transitive_libs=True)
+        if self.options.with_torch:
+            self.requires("libtorch/2.7.1", transitive_headers=True, transitive_libs=True)
         
     def build_requirements(self):
-        self.requires("arff-files/2.0.0") # for tests and sample
+        self.requires("arff-files/2.0.0") # for tests
         if self.options.enable_testing: 
             self.test_requires("gtest/1.16.0")
+        if self.options.enable_benchmark:
+            self.test_requires("benchmark/1.9.1")  # for bench/microbench
     
     def layout(self):
         cmake_layout(self)
@@ -74,6 +84,9 @@ class FimdlpConan(ConanFile):
         # Set CMake variables based on options
         tc.variables["ENABLE_TESTING"] = self.options.enable_testing
         tc.variables["ENABLE_SAMPLE"] = self.options.enable_sample
+        tc.variables["ENABLE_BENCHMARK"] = self.options.enable_benchmark
+        tc.variables["ENABLE_TORCH"] = self.options.with_torch
+        tc.variables["ENABLE_TRACING"] = self.options.enable_tracing
         tc.variables["BUILD_SHARED_LIBS"] = self.options.shared
         tc.generate()
     
@@ -95,21 +108,32 @@ class FimdlpConan(ConanFile):
         copy(self, "LICENSE", src=self.source_folder, dst=os.path.join(self.package_folder, "licenses"))
     
     def package_info(self):
-        # Library configuration
-        self.cpp_info.libs = ["fimdlp"]
-        self.cpp_info.includedirs = ["include"]
-        
         # CMake package configuration
         self.cpp_info.set_property("cmake_file_name", "fimdlp")
-        self.cpp_info.set_property("cmake_target_name", "fimdlp::fimdlp")
-        
-        # Compiler features
-        self.cpp_info.cppstd = "17"
         
-        # System libraries (if needed)
+        # fimdlp_core needs nothing beyond the standard library and threads
+        core = self.cpp_info.components["fimdlp_core"]
+        core.libs = ["fimdlp_core"]
+        core.includedirs = ["include"]
+        core.set_property("cmake_target_name", "fimdlp::fimdlp_core")
+        core.cppstd = "17"
+        if self.options.enable_tracing:
+            core.defines = ["MDLP_TRACE"]
         if self.settings.os in ["Linux", "FreeBSD"]:
-            self.cpp_info.system_libs.append("m")  # Math library
-            self.cpp_info.system_libs.append("pthread")  # Threading
+            core.system_libs.append("m")  # Math library
+            core.system_libs.append("pthread")  # Threading
+        
+        # fimdlp_torch adds the tensor entry points; fimdlp::fimdlp is all of it
+        if self.options.with_torch:
+            tensors = self.cpp_info.components["fimdlp_torch"]
+            tensors.libs = ["fimdlp_torch"]
+            tensors.includedirs = ["include"]
+            tensors.defines = ["MDLP_WITH_TORCH"]
+            tensors.requires = ["fimdlp_core", "libtorch::libtorch"]
+            tensors.set_property("cmake_target_name", "fimdlp::fimdlp_torch")
+            umbrella = self.cpp_info.components["fimdlp"]
+            umbrella.requires = ["fimdlp_torch"]
+            umbrella.set_property("cmake_target_name", "fimdlp::fimdlp")
         
         # Build information for consumers
         self.cpp_info.builddirs = ["lib/cmake/fimdlp"]
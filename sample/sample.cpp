@@ -5,6 +5,7 @@
 // ****************************************************************
 
 #include <iostream>
+#include <map>
 #include <vector>
 #include <iomanip>
 #include <chrono>
@@ -12,8 +13,9 @@
 #include <cstring>
 #include <getopt.h>
 #include <torch/torch.h>
-#include <ArffFiles/ArffFiles.hpp>
 #include "Discretizer.h"
+#include "DiscretizerTorch.h"
+#include "Loader.h"
 #include "CPPFImdlp.h"
 #include "BinDisc.h"
 
@@ -97,21 +99,19 @@ std::tuple<std::string, std::string, int, int, float> parse_arguments(int argc,
 void process_file(const std::string& path, const std::string& file_name, bool class_last, int max_depth, int min_length,
     float max_cutpoints)
 {
-    ArffFiles::ArffFiles file;
-
-    file.load(path + file_name + ".arff", class_last);
-    const auto attributes = file.getAttributes();
-    const auto items = file.getSize();
+    auto dataset = mdlp::load_arff(path + file_name + ".arff", class_last);
+    const auto& attributes = dataset.attributes;
+    const auto items = dataset.size();
     std::cout << "Number of lines: " << items << std::endl;
     std::cout << "Attributes: " << std::endl;
     for (auto attribute : attributes) {
         std::cout << "Name: " << std::get<0>(attribute) << " Type: " << std::get<1>(attribute) << std::endl;
     }
-    std::cout << "Class name: " << file.getClassName() << std::endl;
-    std::cout << "Class type: " << file.getClassType() << std::endl;
+    std::cout << "Class name: " << dataset.class_name << std::endl;
+    std::cout << "Class type: " << dataset.class_type << std::endl;
     std::cout << "Data: " << std::endl;
-    std::vector<mdlp::samples_t>& X = file.getX();
-    mdlp::labels_t& y = file.getY();
+    std::vector<mdlp::samples_t>& X = dataset.X;
+    mdlp::labels_t& y = dataset.y;
     // The dataset is named on the command line, so nothing here guarantees its
     // shape: derive the row count from the data rather than assuming there are
     // at least five rows.
@@ -160,16 +160,16 @@ void process_file(const std::string& path, const std::string& file_name, bool cl
     }
     auto Xt = torch::tensor(X[0], torch::kFloat32);
     auto yt = torch::tensor(y, torch::kInt32);
-    //test.fit_t(Xt, yt);
-    auto result = test.fit_transform_t(Xt, yt);
+    //fit_t(test, Xt, yt);
+    auto result = fit_transform_t(test, Xt, yt);
     std::cout << "Transformed data (torch)...: " << std::endl;
     for (size_t i = tail; i < transformed; i++) {
         std::cout << std::fixed << std::setprecision(1) << Xt[i].item<mdlp::precision_t>() << " " << result[i].item<int>() << std::endl;
     }
     auto disc = mdlp::BinDisc(3);
     auto res_v = disc.fit_transform(X[0], y);
-    disc.fit_t(Xt, yt);
-    auto res_t = disc.transform_t(Xt);
+    fit_t(disc, Xt, yt);
+    auto res_t = transform_t(disc, Xt);
     std::cout << "Transformed data (BinDisc)...: " << std::endl;
     for (size_t i = tail; i < transformed; i++) {
         std::cout << std::fixed << std::setprecision(1) << Xt[i].item<mdlp::precision_t>() << " " << res_v[i] << " " << res_t[i].item<int>() << std::endl;
@@ -184,11 +184,10 @@ void process_all_files(const std::map<std::string, bool>& datasets, const std::s
     printf("%-20s %4s %4s\n", "Dataset", "Feat", "Cuts Time(ms)");
     printf("==================== ==== ==== ========\n");
     for (const auto& dataset : datasets) {
-        ArffFiles::ArffFiles file;
-        file.load(path + dataset.first + ".arff", dataset.second);
-        auto attributes = file.getAttributes();
-        std::vector<mdlp::samples_t>& X = file.getX();
-        mdlp::labels_t& y = file.getY();
+        auto loaded = mdlp::load_arff(path + dataset.first + ".arff", dataset.second);
+        const auto& attributes = loaded.attributes;
+        std::vector<mdlp::samples_t>& X = loaded.X;
+        mdlp::labels_t& y = loaded.y;
         size_t timing = 0;
         size_t cut_points = 0;
         for (auto i = 0; i < attributes.size(); i++) {
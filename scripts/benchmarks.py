@@ -9,8 +9,13 @@
 Two subcommands:
 
   run     execute the benchmark binary, fingerprint this machine, and store the
-          result under docs/benchmarks/results/
+          result under docs/benchmarks/results/; --suite real measures the
+          ARFF files in tests/datasets instead of generated data, --suite
+          scaling the parallel paths at every thread count, --suite
+          workloads a fixed n over class counts, duplicates and distributions
   report  merge every stored result into docs/benchmarks-platforms.md
+  compare test two stored results for significant differences, benchmark by
+          benchmark, and exit 1 on a significant regression
 
 Methodology (see docs/benchmarks.md):
   * Repetition counts are FIXED and identical on every platform. The minimum of a
@@ -29,6 +34,7 @@ import json
 import math
 import os
 import platform
+import random
 import re
 import subprocess
 import sys
@@ -201,7 +207,11 @@ def cmd_run(args):
         print(">>> WARNING: working tree is dirty; this result is not reproducible "
               "from the recorded commit.")
 
-    proc = subprocess.run([str(binary), "--json", str(tmp_json), "--level", args.level])
+    cmd = [str(binary), "--json", str(tmp_json), "--level", args.level,
+           "--suite", args.suite, "--datasets", args.datasets]
+    if args.perf:
+        cmd.append("--perf")
+    proc = subprocess.run(cmd)
     if proc.returncode != 0:
         sys.exit(proc.returncode)
 
@@ -212,7 +222,10 @@ def cmd_run(args):
     payload["source_hash"] = source_hash()
     payload["recorded_at"] = datetime.now(timezone.utc).isoformat(timespec="seconds")
 
-    out = RESULTS_DIR / f"{fp['slug']}__{git['commit']}.json"
+    # The suffix keeps a real-data run from replacing the synthetic run of the
+    # same machine and commit.
+    suffix = "" if args.suite == "synthetic" else f"__{args.suite}"
+    out = RESULTS_DIR / f"{fp['slug']}__{git['commit']}{suffix}.json"
     out.write_text(json.dumps(payload, indent=2) + "\n")
     print(f">>> stored {out.relative_to(REPO_ROOT)}")
     print(">>> regenerate the comparison with: make bench-report")
@@ -247,6 +260,11 @@ def dataset_version_of(run):
     return run.get("dataset_version", 1)
 
 
+def suite_of(run):
+    # Files written before the real-data suite existed are all synthetic.
+    return run.get("suite", "synthetic")
+
+
 def checksums_of(run):
     return {d["n"]: d["checksum"] for d in run.get("datasets", [])}
 
@@ -508,8 +526,179 @@ def render_comparison(runs, add):
     add("")
 
 
+def dataset_median(run, benchmark, dataset):
+    for r in run["results"]:
+        if r["benchmark"] == benchmark and r.get("dataset") == dataset and not r.get("feature"):
+            return r["median_ms"]
+    return None
+
+
+def feature_skew(run, benchmark, dataset):
+    """Slowest feature's median over the median feature's, and the slowest's name."""
+    rows = [r for r in run["results"]
+            if r["benchmark"] == benchmark and r.get("dataset") == dataset and r.get("feature")]
+    if not rows:
+        return None, None
+    medians = sorted(r["median_ms"] for r in rows)
+    typical = medians[len(medians) // 2]
+    slowest = max(rows, key=lambda r: r["median_ms"])
+    if typical <= 0:
+        return None, slowest["feature"]
+    return slowest["median_ms"] / typical, slowest["feature"]
+
+
+def render_real(runs, add):
+    """Whole-dataset medians and per-feature skew of the real-data suite."""
+    groups = {}
+    for r in runs:
+        groups.setdefault(code_of(r), []).append(r)
+    for code, group in groups.items():
+        add(f"## Real datasets · code `{code}`")
+        add("")
+        add("The ARFF files in `tests/datasets`, each fitted and transformed feature "
+            "by feature. Medians in milliseconds for the whole dataset. *Skew* is "
+            "the slowest feature's median fit time over the median feature's, so "
+            "1.0× means every feature costs the same.")
+        add("")
+        names = []
+        for r in group:
+            for d in r.get("datasets", []):
+                if d.get("name") and d["name"] not in names:
+                    names.append(d["name"])
+        sums = {}
+        for r in group:
+            for d in r.get("datasets", []):
+                if d.get("name"):
+                    sums.setdefault(d["name"], set()).add(d["checksum"])
+        for name in names:
+            info = next(d for r in group for d in r.get("datasets", []) if d.get("name") == name)
+            add(f"### {name} ({info['n']:,} samples, {info['features']} features)")
+            add("")
+            if len(sums[name]) > 1:
+                add("> ⚠ The platforms loaded different bytes for this dataset; "
+                    "their times are not comparable.")
+                add("")
+            add("| Benchmark | " + " | ".join(r["platform"]["cpu"] for r in group) + " |")
+            add("|---|" + "---:|" * len(group))
+            benches = []
+            for r in group:
+                for x in r["results"]:
+                    if (x.get("dataset") == name and not x.get("feature")
+                            and x["benchmark"] not in benches):
+                        benches.append(x["benchmark"])
+            for bench in benches:
+                add(f"| {bench} | "
+                    + " | ".join(fmt(dataset_median(r, bench, name)) for r in group) + " |")
+                if bench.endswith("::fit (dataset)"):
+                    per_feature = bench.replace("(dataset)", "(feature)")
+                    cells = []
+                    for r in group:
+                        skew, feature = feature_skew(r, per_feature, name)
+                        cells.append(f"{skew:.1f}× ({feature})" if skew else "—")
+                    add("| &nbsp;&nbsp;skew | " + " | ".join(cells) + " |")
+            add("")
+
+
+def scaling_workloads(run):
+    """Workload name -> (serial baseline row, {threads: row}) of a scaling run."""
+    workloads = {}
+    for r in run["results"]:
+        if r["benchmark"].endswith(" (serial)"):
+            workloads.setdefault(r["benchmark"][:-len(" (serial)")], [None, {}])[0] = r
+    for r in run["results"]:
+        if r.get("threads"):
+            name = r["benchmark"].rsplit(" (", 1)[0]
+            if name in workloads:
+                workloads[name][1][r["threads"]] = r
+    return workloads
+
+
+def render_scaling(runs, add):
+    """Speedup, parallel efficiency and idle time of the thread-scaling suite."""
+    groups = {}
+    for r in runs:
+        groups.setdefault(code_of(r), []).append(r)
+    for code, group in groups.items():
+        add(f"## Thread scaling · code `{code}`")
+        add("")
+        add("Each parallel path at 1, 2, 4 … threads up to the machine's, against "
+            "the same work run serially. Cells are the speedup over the serial "
+            "median, the parallel efficiency (speedup per thread) and the mean "
+            "time each thread sat idle per call. Efficiency falling while idle "
+            "time grows is where a path stops scaling.")
+        add("")
+        per_run = [scaling_workloads(r) for r in group]
+        names = []
+        for workloads in per_run:
+            names += [w for w in workloads if w not in names]
+        for name in names:
+            add(f"### {name}")
+            add("")
+            add("| Threads | " + " | ".join(r["platform"]["cpu"] for r in group) + " |")
+            add("|---|" + "---:|" * len(group))
+            add("| serial | " + " | ".join(
+                fmt(w[name][0]["median_ms"]) + " ms" if name in w and w[name][0] else "—"
+                for w in per_run) + " |")
+            counts = sorted({t for w in per_run if name in w for t in w[name][1]})
+            for t in counts:
+                cells = []
+                for w in per_run:
+                    row = w.get(name, [None, {}])[1].get(t)
+                    cells.append("—" if row is None else
+                                 f"{row['speedup']:.2f}× · {row['efficiency']:.0%} · "
+                                 f"{row['idle_ms']:.3f} ms idle")
+                add(f"| {t} | " + " | ".join(cells) + " |")
+            add("")
+
+
+def render_workloads(runs, add):
+    """Each operation over the workload shapes, against the default workload."""
+    groups = {}
+    for r in runs:
+        groups.setdefault(code_of(r), []).append(r)
+    for code, group in groups.items():
+        add(f"## Workload shapes · code `{code}`")
+        add("")
+        add("One n, and the data varied one dimension at a time from the default "
+            "(3 balanced classes of normal values, no repeats). Cells are the "
+            "median in milliseconds and its ratio to the default workload's, so "
+            "the class-count rows show how a cost grows with k.")
+        add("")
+        workloads = []
+        benches = []
+        for r in group:
+            for x in r["results"]:
+                if x.get("dataset") and x["dataset"] not in workloads:
+                    workloads.append(x["dataset"])
+                if x["benchmark"] not in benches:
+                    benches.append(x["benchmark"])
+        for bench in benches:
+            n = next(x["n"] for r in group for x in r["results"] if x["benchmark"] == bench)
+            add(f"### {bench} (n = {n:,})")
+            add("")
+            add("| Workload | " + " | ".join(r["platform"]["cpu"] for r in group) + " |")
+            add("|---|" + "---:|" * len(group))
+            for workload in workloads:
+                cells = []
+                for r in group:
+                    value = dataset_median(r, bench, workload)
+                    base = dataset_median(r, bench, "default")
+                    if value is None:
+                        cells.append("—")
+                    elif base:
+                        cells.append(f"{fmt(value)} ({value / base:.2f}×)")
+                    else:
+                        cells.append(fmt(value))
+                add(f"| {workload} | " + " | ".join(cells) + " |")
+            add("")
+
+
 def render_report(runs):
     runs = sorted(runs, key=lambda r: r["platform"]["slug"])
+    real = [r for r in runs if suite_of(r) == "real"]
+    scaling = [r for r in runs if suite_of(r) == "scaling"]
+    shapes = [r for r in runs if suite_of(r) == "workloads"]
+    runs = [r for r in runs if suite_of(r) == "synthetic"]
     lines = []
     add = lines.append
 
@@ -518,8 +707,8 @@ def render_report(runs):
     add("Generated by `make bench-report` from every result in "
         "`docs/benchmarks/results/`. Do not edit by hand.")
     add("")
-    machines = {r["platform"]["slug"] for r in runs}
-    add(f"**{len(runs)}** run(s) across **{len(machines)}** machine(s). "
+    machines = {r["platform"]["slug"] for r in runs + real + scaling + shapes}
+    add(f"**{len(runs) + len(real) + len(scaling) + len(shapes)}** run(s) across **{len(machines)}** machine(s). "
         f"Generated {datetime.now(timezone.utc).isoformat(timespec='seconds')}.")
     add("")
 
@@ -536,7 +725,7 @@ def render_report(runs):
     add("")
     add("| # | CPU | Arch | Cores | RAM | OS | Compiler | Dataset | Code | Commit |")
     add("|---|---|---|---:|---:|---|---|---:|---|---|")
-    for i, r in enumerate(runs, 1):
+    for i, r in enumerate(runs + real + scaling + shapes, 1):
         p = r["platform"]
         cores = str(p.get("cpu_count") or "?")
         topo = p.get("cores")
@@ -545,7 +734,8 @@ def render_report(runs):
         ram = f"{p['ram_gib']} GiB" if p.get("ram_gib") else "?"
         add(f"| {i} | {p['cpu']} | {p['arch']} | {cores} | {ram} | "
             f"{p['os_description']} | {r['build']['compiler']} | "
-            f"v{dataset_version_of(r)} | `{code_of(r)}` | `{r['git']['commit']}` |")
+            f"{suite_of(r) if suite_of(r) != 'synthetic' else f'v{dataset_version_of(r)}'} | "
+            f"`{code_of(r)}` | `{r['git']['commit']}` |")
     add("")
     add("> The compiler differs between platforms by design (see "
         "`scripts/benchmarks.py`). Every difference below is hardware **and** "
@@ -589,6 +779,13 @@ def render_report(runs):
             add("")
         render_comparison(group, add)
 
+    if real:
+        render_real(real, add)
+    if scaling:
+        render_scaling(scaling, add)
+    if shapes:
+        render_workloads(shapes, add)
+
     return "\n".join(lines) + "\n"
 
 
@@ -604,6 +801,198 @@ def cmd_report(args):
               f"{r['build']['compiler']}, {r['git']['commit']})")
 
 
+# --------------------------------------------------------------------------- #
+# compare: significance of the difference between two results
+# --------------------------------------------------------------------------- #
+
+# Resamples for the confidence interval of the median ratio. Seeded, so the same
+# two files always print the same interval.
+BOOTSTRAP_RESAMPLES = 2000
+BOOTSTRAP_SEED = 42
+
+
+def row_key(row):
+    return (row["benchmark"], row["n"], row.get("dataset", ""), row.get("feature", ""))
+
+
+def row_label(key):
+    bench, n, dataset, feature = key
+    where = dataset + (f"/{feature}" if feature else "") if dataset else f"n={n:,}"
+    return f"{bench} [{where}]"
+
+
+def median(values):
+    ordered = sorted(values)
+    mid = len(ordered) // 2
+    return ordered[mid] if len(ordered) % 2 else (ordered[mid - 1] + ordered[mid]) / 2
+
+
+def mann_whitney(a, b):
+    """Two-sided p-value of the Mann-Whitney U test of a against b.
+
+    Normal approximation with tie correction and continuity correction, which is
+    accurate for the 10+ repetitions every benchmark row has. Needs no scipy: the
+    script must run on a bare python3.
+    """
+    n1, n2 = len(a), len(b)
+    pooled = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+    ranks_a = 0.0
+    ties = 0.0
+    i = 0
+    while i < len(pooled):
+        j = i
+        while j + 1 < len(pooled) and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+        rank = (i + j) / 2 + 1  # average rank of the run, 1-based
+        ranks_a += rank * sum(1 for k in range(i, j + 1) if pooled[k][1] == 0)
+        t = j - i + 1
+        ties += t ** 3 - t
+        i = j + 1
+    u = ranks_a - n1 * (n1 + 1) / 2
+    total = n1 + n2
+    sigma2 = n1 * n2 / 12 * ((total + 1) - ties / (total * (total - 1)))
+    if sigma2 <= 0:
+        return 1.0  # every sample equal
+    z = (abs(u - n1 * n2 / 2) - 0.5) / math.sqrt(sigma2)
+    return math.erfc(max(z, 0.0) / math.sqrt(2))
+
+
+def bootstrap_ratio(base, new, rng):
+    """95% percentile-bootstrap interval of median(new) / median(base)."""
+    ratios = []
+    for _ in range(BOOTSTRAP_RESAMPLES):
+        b = median(rng.choices(base, k=len(base)))
+        n = median(rng.choices(new, k=len(new)))
+        if b > 0:
+            ratios.append(n / b)
+    ratios.sort()
+    if not ratios:
+        return None, None
+    return ratios[int(0.025 * len(ratios))], ratios[int(0.975 * len(ratios)) - 1]
+
+
+def comparability_notes(base, new):
+    notes = []
+    if base["platform"]["slug"] != new["platform"]["slug"]:
+        notes.append(f"different machines ({base['platform']['slug']} vs "
+                     f"{new['platform']['slug']}): the difference is not the code's alone")
+    if base["build"]["compiler"] != new["build"]["compiler"]:
+        notes.append(f"different compilers ({base['build']['compiler']} vs "
+                     f"{new['build']['compiler']})")
+    if suite_of(base) != suite_of(new):
+        notes.append(f"different suites ({suite_of(base)} vs {suite_of(new)}); "
+                     "only rows present in both are compared")
+    sums_base = {(d.get("name", ""), d["n"]): d["checksum"] for d in base.get("datasets", [])}
+    sums_new = {(d.get("name", ""), d["n"]): d["checksum"] for d in new.get("datasets", [])}
+    changed = [k for k in sums_base if k in sums_new and sums_base[k] != sums_new[k]]
+    if changed:
+        notes.append("the datasets differ, so the two did not measure the same work")
+    return notes
+
+
+def latest_pair(suite):
+    """The two most recent results of this machine for suite, oldest first."""
+    slug = fingerprint()["slug"]
+    mine = [(r.get("recorded_at", ""), path) for path in RESULTS_DIR.glob(f"{slug}__*.json")
+            for r in [json.loads(path.read_text())] if suite_of(r) == suite]
+    mine.sort()
+    if len(mine) < 2:
+        sys.exit(f"need two {suite} results of this machine ({slug}) in "
+                 f"{RESULTS_DIR.relative_to(REPO_ROOT)}; pass BASE and NEW explicitly")
+    return mine[-2][1], mine[-1][1]
+
+
+def cmd_compare(args):
+    if (args.base is None) != (args.new is None):
+        sys.exit("pass both BASE and NEW, or neither to compare this machine's last two runs")
+    base_path, new_path = ((Path(args.base), Path(args.new)) if args.base
+                           else latest_pair(args.suite))
+    base = json.loads(base_path.read_text())
+    new = json.loads(new_path.read_text())
+    print(f">>> base: {base_path.name} ({base['git']['commit']})")
+    print(f">>> new:  {new_path.name} ({new['git']['commit']})")
+    for note in comparability_notes(base, new):
+        print(f">>> WARNING: {note}")
+    print(f">>> regression: new median more than {args.threshold * 100:.0f}% slower "
+          f"with p < {args.alpha}")
+    print()
+
+    base_rows = {row_key(r): r for r in base["results"]}
+    rng = random.Random(BOOTSTRAP_SEED)
+    width = max((len(row_label(row_key(r))) for r in new["results"]), default=20)
+    print(f"{'benchmark':<{width}}  {'base ms':>10} {'new ms':>10} {'speedup':>8} "
+          f"{'95% CI':>17} {'p':>8}  verdict")
+    regressions = 0
+    skipped = 0
+    for row in new["results"]:
+        key = row_key(row)
+        old = base_rows.get(key)
+        if old is None:
+            continue
+        a, b = old.get("samples_ms"), row.get("samples_ms")
+        if not a or not b:
+            skipped += 1
+            continue
+        ratio = median(b) / median(a) if median(a) > 0 else float("inf")
+        low, high = bootstrap_ratio(a, b, rng)
+        p = mann_whitney(a, b)
+        significant = p < args.alpha
+        if significant and ratio > 1 + args.threshold:
+            verdict = "REGRESSION"
+            regressions += 1
+        elif significant and ratio < 1 / (1 + args.threshold):
+            verdict = "faster"
+        elif significant:
+            verdict = "within threshold"
+        else:
+            verdict = "no change"
+        ci = f"{1 / high:.2f}–{1 / low:.2f}×" if low and high else "—"
+        print(f"{row_label(key):<{width}}  {median(a):>10.4f} {median(b):>10.4f} "
+              f"{1 / ratio:>7.2f}× {ci:>17} {p:>8.2g}  {verdict}")
+    print()
+    if skipped:
+        print(f">>> {skipped} row(s) skipped: no raw samples (results before schema 3, "
+              "or per-feature rows)")
+    growths = compare_memory(base_rows, new["results"], args.threshold)
+    if regressions or growths:
+        if regressions:
+            print(f">>> {regressions} significant regression(s)")
+        if growths:
+            print(f">>> {growths} memory regression(s)")
+        sys.exit(1)
+    print(">>> no significant regression")
+
+
+def compare_memory(base_rows, new_rows, threshold):
+    """Print the rows whose heap use changed; return how many grew past threshold.
+
+    Allocation counts and bytes are exact rather than sampled, so there is no
+    test to run: any change is the code's, and growth beyond the threshold is a
+    regression on its own.
+    """
+    changed = []
+    for row in new_rows:
+        old = base_rows.get(row_key(row))
+        if old is None or "peak_bytes" not in old or "peak_bytes" not in row:
+            continue
+        if (old["peak_bytes"], old["alloc_bytes"]) == (row["peak_bytes"], row["alloc_bytes"]):
+            continue
+        grew = any(row[k] > old[k] * (1 + threshold) for k in ("peak_bytes", "alloc_bytes"))
+        changed.append((row_label(row_key(row)), old, row, grew))
+    if not changed:
+        return 0
+    width = max(len(label) for label, *_ in changed)
+    print(f"heap use changed in {len(changed)} row(s):")
+    print(f"{'benchmark':<{width}}  {'base peak':>11} {'new peak':>11} "
+          f"{'base alloc':>11} {'new alloc':>11}  verdict")
+    for label, old, row, grew in changed:
+        print(f"{label:<{width}}  {old['peak_bytes']:>11,.0f} {row['peak_bytes']:>11,.0f} "
+              f"{old['alloc_bytes']:>11,.0f} {row['alloc_bytes']:>11,.0f}  "
+              f"{'MORE MEMORY' if grew else 'changed'}")
+    print()
+    return sum(1 for *_, grew in changed if grew)
+
+
 # --------------------------------------------------------------------------- #
 # sortbench: toolchain diagnostic
 # --------------------------------------------------------------------------- #
@@ -966,11 +1355,27 @@ def main():
     run.add_argument("--level", choices=["quick", "full"], default="full")
     run.add_argument("--label", default=None,
                      help="disambiguate machines with the same CPU, e.g. 'studio'")
+    run.add_argument("--suite", choices=["synthetic", "real", "scaling", "workloads"], default="synthetic")
+    run.add_argument("--datasets", default=str(REPO_ROOT / "tests" / "datasets"),
+                     help="folder of the ARFF files the real suite loads")
+    run.add_argument("--perf", action="store_true",
+                     help="also read the hardware counters (Linux perf_event_open)")
     run.set_defaults(func=cmd_run)
 
     rep = sub.add_parser("report", help="merge stored results into a comparison")
     rep.set_defaults(func=cmd_report)
 
+    cmp = sub.add_parser("compare", help="test two results for significant regressions")
+    cmp.add_argument("base", nargs="?", help="result file to compare against")
+    cmp.add_argument("new", nargs="?", help="result file under test")
+    cmp.add_argument("--threshold", type=float, default=0.05,
+                     help="slowdown of the median that counts, as a fraction (default 0.05)")
+    cmp.add_argument("--alpha", type=float, default=0.01,
+                     help="significance level of the Mann-Whitney test (default 0.01)")
+    cmp.add_argument("--suite", choices=["synthetic", "real", "scaling", "workloads"], default="synthetic",
+                     help="which of this machine's results to pick without BASE and NEW")
+    cmp.set_defaults(func=cmd_compare)
+
     sbs = sub.add_parser("sortbench-store", help="store a sortbench csv with a machine fingerprint")
     sbs.add_argument("--csv", required=True)
     sbs.add_argument("--label", default=None)
@@ -10,6 +10,8 @@
 #include <string>
 #include "BinDisc.h"
 #include "Exceptions.h"
+#include "TransformKernel.h"
+#include "Trace.h"
 
 namespace mdlp {
 
@@ -24,6 +26,7 @@ namespace mdlp {
         Discretizer(), n_bins{ config.n_bins }, strategy{ config.strategy }
     {
         config.validate();
+        sketch = QuantileSketch(config.sketch_error);
     }
 
     labels_t BinDisc::discretize(const samples_t& X, const labels_t& y, const BinDiscConfig& config)
@@ -37,7 +40,7 @@ namespace mdlp {
         return out;
     }
     BinDisc::~BinDisc() = default;
-    void BinDisc::validate_input(const samples_t& X) const
+    ColumnSummary BinDisc::validate_input(const samples_t& X) const
     {
         if (X.empty()) {
             throw ValidationError("Input data X cannot be empty");
@@ -47,28 +50,56 @@ namespace mdlp {
         }
         // QUANTILE sorts, and UNIFORM feeds min/max into linspace; neither
         // tolerates a non-finite sample.
-        validate_finite(X);
+        return summarize(X);
     }
     void BinDisc::fit(samples_t& X)
     {
-        validate_input(X);
+        auto* stats = start_fit_stats();
+        FitTimer timer(stats, &FitStats::total_ns);
+        ColumnSummary summary;
+        {
+            FitTimer validating(stats, &FitStats::validate_ns);
+            summary = validate_input(X);
+        }
+        running = {};
+        sketch.clear();
         cutPoints.clear();
+        width = 0;
         direction = bound_dir_t::RIGHT;
         if (strategy == strategy_t::QUANTILE) {
-            fit_quantile(X);  // copies into fit_quantile's by-value parameter
+            if (summary.sorted) {
+                fit_quantile(X, summary);  // reads only; no copy to reorder
+            } else {
+                samples_t copy = X;
+                if (stats) {
+                    stats->hold(copy.size() * sizeof(precision_t));
+                }
+                fit_quantile(copy, summary);
+            }
         } else if (strategy == strategy_t::UNIFORM) {
-            fit_uniform(X);
+            FitTimer searching(stats, &FitStats::search_ns);
+            fit_uniform(summary);
         }
     }
     void BinDisc::fit(samples_t&& X)
     {
-        validate_input(X);
+        auto* stats = start_fit_stats();
+        FitTimer timer(stats, &FitStats::total_ns);
+        ColumnSummary summary;
+        {
+            FitTimer validating(stats, &FitStats::validate_ns);
+            summary = validate_input(X);
+        }
+        running = {};
+        sketch.clear();
         cutPoints.clear();
+        width = 0;
         direction = bound_dir_t::RIGHT;
         if (strategy == strategy_t::QUANTILE) {
-            fit_quantile(std::move(X));  // adopts the caller's buffer and sorts it
+            fit_quantile(X, summary);  // the caller's buffer, adopted
         } else if (strategy == strategy_t::UNIFORM) {
-            fit_uniform(X);  // reads only; nothing to adopt
+            FitTimer searching(stats, &FitStats::search_ns);
+            fit_uniform(summary);
         }
     }
     // y is accepted and ignored on purpose: every discretizer takes fit(X, y) so
@@ -116,7 +147,66 @@ namespace mdlp {
     {
         return std::max(lower, std::min(n, upper));
     }
-    std::vector<precision_t> BinDisc::percentile(samples_t& data, const std::vector<precision_t>& percentiles)
+    namespace {
+        // The lower of the two order statistics percentile() interpolates
+        // between; the upper is the next one. Shared so the selection in
+        // fit_quantile() puts in place exactly the samples percentile() reads.
+        size_t lower_rank(size_t n, precision_t percentile)
+        {
+            const auto i = static_cast<size_t>(std::floor(static_cast<precision_t>(n - 1) * percentile / 100.));
+            return clip(i, 0, n - 2);
+        }
+
+        // Put the sample of each rank in [rank, rank_end) where a full sort
+        // would, leaving the rest partitioned around them. Ranks are ascending,
+        // unique and inside [first, last). Selecting the middle rank splits both
+        // the data and the ranks in two, so the recursion is log(ranks) deep and
+        // each level is linear: expected O(n log ranks) against the sort's
+        // O(n log n).
+        void select_ranks(precision_t* data, size_t first, size_t last, const size_t* rank, const size_t* rank_end)
+        {
+            // Below this size, or once the ranks are a good fraction of the
+            // samples, sorting the range is cheaper than partitioning it again.
+            constexpr size_t small_range = 32;
+            while (rank != rank_end) {
+                const auto n_ranks = static_cast<size_t>(rank_end - rank);
+                if (last - first <= small_range || n_ranks * 8 >= last - first) {
+                    std::sort(data + first, data + last);
+                    return;
+                }
+                const size_t* middle = rank + n_ranks / 2;
+                std::nth_element(data + first, data + *middle, data + last);
+                select_ranks(data, first, *middle, rank, middle);
+                first = *middle + 1;
+                rank = middle + 1;
+            }
+        }
+    }
+    namespace {
+        // The interpolation percentile() does, over any source of order
+        // statistics: at(i) is the sample at rank i of n.
+        template <typename At>
+        std::vector<precision_t> interpolate(size_t n, const std::vector<precision_t>& percentiles, At at)
+        {
+            // Implementation taken from https://dpilger26.github.io/NumCpp/doxygen/html/percentile_8hpp_source.html
+            std::vector<precision_t> results;
+            bool first = true;
+            results.reserve(percentiles.size());
+            for (auto percentile : percentiles) {
+                const auto indexLower = lower_rank(n, percentile);
+                const precision_t percentI = static_cast<precision_t>(indexLower) / static_cast<precision_t>(n - 1);
+                const precision_t fraction =
+                    (percentile / 100.0 - percentI) /
+                    (static_cast<precision_t>(indexLower + 1) / static_cast<precision_t>(n - 1) - percentI);
+                const precision_t lower = at(indexLower);
+                if (const auto value = lower + (at(indexLower + 1) - lower) * fraction; first || results.empty() || value != results.back()) // Check empty before calling back()
+                    results.push_back(value);
+                first = false;
+            }
+            return results;
+        }
+    }
+    std::vector<precision_t> BinDisc::percentile(const samples_t& data, const std::vector<precision_t>& percentiles)
     {
         // Input validation
         if (data.empty()) {
@@ -125,39 +215,120 @@ namespace mdlp {
         if (percentiles.empty()) {
             throw ValidationError("Percentiles cannot be empty");
         }
-
-        // Implementation taken from https://dpilger26.github.io/NumCpp/doxygen/html/percentile_8hpp_source.html
-        std::vector<precision_t> results;
-        bool first = true;
-        results.reserve(percentiles.size());
-        for (auto percentile : percentiles) {
-            const auto i = static_cast<size_t>(std::floor(static_cast<precision_t>(data.size() - 1) * percentile / 100.));
-            const auto indexLower = clip(i, 0, data.size() - 2);
-            const precision_t percentI = static_cast<precision_t>(indexLower) / static_cast<precision_t>(data.size() - 1);
-            const precision_t fraction =
-                (percentile / 100.0 - percentI) /
-                (static_cast<precision_t>(indexLower + 1) / static_cast<precision_t>(data.size() - 1) - percentI);
-            if (const auto value = data[indexLower] + (data[indexLower + 1] - data[indexLower]) * fraction; first || results.empty() || value != results.back()) // Check empty before calling back()
-                results.push_back(value);
-            first = false;
-        }
-        return results;
-    }
-    void BinDisc::fit_quantile(samples_t data)
-    {
-        auto quantiles = linspace(0.0, 100.0, n_bins + 1);
-        std::sort(data.begin(), data.end());
-        if (data.front() == data.back() || data.size() == 1) {
-            // if X is constant, pass any two given points that shall be ignored in transform
-            cutPoints.push_back(data.front());
-            cutPoints.push_back(data.front());
+        return interpolate(data.size(), percentiles, [&data](size_t i) { return data[i]; });
+    }
+    void BinDisc::fit_constant(precision_t value)
+    {
+        // if X is constant, pass any two given points that shall be ignored in transform
+        cutPoints.push_back(value);
+        cutPoints.push_back(value);
+    }
+    void BinDisc::fit_quantile(samples_t& data, const ColumnSummary& summary)
+    {
+        MDLP_TRACE_SCOPE("fit_quantile");
+        if (summary.min == summary.max) {
+            fit_constant(summary.min);
             return;
         }
-        cutPoints = percentile(data, quantiles);
+        auto* stats = fit_stats_ptr();
+        const auto percentiles = linspace(0.0, 100.0, n_bins + 1);
+        if (!summary.sorted) {
+            FitTimer sorting(stats, &FitStats::sort_ns);
+            // percentile() reads two order statistics per percentile; select
+            // those instead of sorting everything.
+            std::vector<size_t> ranks;
+            ranks.reserve(2 * percentiles.size());
+            for (auto p : percentiles) {
+                const auto rank = lower_rank(data.size(), p);
+                ranks.push_back(rank);
+                ranks.push_back(rank + 1);
+            }
+            std::sort(ranks.begin(), ranks.end());
+            ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+            if (stats) {
+                stats->hold(ranks.capacity() * sizeof(size_t));
+            }
+            select_ranks(data.data(), 0, data.size(), ranks.data(), ranks.data() + ranks.size());
+        }
+        FitTimer searching(stats, &FitStats::search_ns);
+        cutPoints = percentile(data, percentiles);
+    }
+    void BinDisc::partial_fit(const samples_t& chunk)
+    {
+        const auto summary = summarize(chunk);  // throws before anything is added
+        if (strategy == strategy_t::QUANTILE) {
+            sketch.update(chunk);
+        }
+        absorb(summary);
     }
-    void BinDisc::fit_uniform(const samples_t& X)
+    void BinDisc::merge(const BinDisc& other)
     {
-        auto [vmin, vmax] = std::minmax_element(X.begin(), X.end());
-        cutPoints = linspace(*vmin, *vmax, n_bins + 1);
+        if (other.strategy != strategy) {
+            throw InvalidParameter("Cannot merge BinDisc models of different strategies");
+        }
+        if (other.n_bins != n_bins) {
+            throw InvalidParameter("Cannot merge a BinDisc of " + std::to_string(other.n_bins)
+                + " bins into one of " + std::to_string(n_bins));
+        }
+        merge_stream(other);
+    }
+    void BinDisc::merge_stream(const BinDisc& other)
+    {
+        if (strategy == strategy_t::QUANTILE) {
+            sketch.merge(other.sketch);
+        }
+        absorb(other.running);
+    }
+    void BinDisc::absorb(const ColumnSummary& part)
+    {
+        if (part.count == 0) {
+            return;
+        }
+        if (running.count == 0) {
+            running = part;
+        } else {
+            running.min = std::min(running.min, part.min);
+            running.max = std::max(running.max, part.max);
+            running.count += part.count;
+        }
+        running.sorted = false;  // not known across chunks, and not used
+    }
+    void BinDisc::finalize()
+    {
+        if (running.count == 0) {
+            throw ValidationError("Nothing to finalize: no samples were streamed");
+        }
+        if (running.count < static_cast<size_t>(n_bins)) {
+            throw ValidationError("Input data size (" + std::to_string(running.count) + ") must be at least n_bins (" + std::to_string(n_bins) + ")");
+        }
+        cutPoints.clear();
+        width = 0;
+        direction = bound_dir_t::RIGHT;
+        if (strategy == strategy_t::UNIFORM) {
+            fit_uniform(running);  // the extremes are exact, so this is fit()'s grid
+            return;
+        }
+        if (running.min == running.max) {
+            fit_constant(running.min);
+            return;
+        }
+        const auto view = sketch.sorted_view();
+        cutPoints = interpolate(running.count, linspace(0.0, 100.0, n_bins + 1),
+            [&view](size_t rank) { return view.at(rank); });
+    }
+    void BinDisc::fit_uniform(const ColumnSummary& summary)
+    {
+        cutPoints = linspace(summary.min, summary.max, n_bins + 1);
+        // The step linspace used, so bin() lands on the same grid.
+        origin = summary.min;
+        width = (summary.max - summary.min) / static_cast<precision_t>(n_bins);
+    }
+    void BinDisc::bin(const precision_t* data, size_t n, label_t* out) const
+    {
+        if (width > 0) {
+            detail::bin_samples_uniform(cutPoints.data() + 1, cutPoints.size() - 2, origin, width, data, n, out);
+            return;
+        }
+        Discretizer::bin(data, n, out);
     }
 }
\ No newline at end of file
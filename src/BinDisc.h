@@ -10,6 +10,7 @@
 #include "typesFImdlp.h"
 #include "Discretizer.h"
 #include "DiscretizerConfig.h"
+#include "QuantileSketch.h"
 #include <string>
 
 namespace mdlp {
@@ -91,19 +92,94 @@ namespace mdlp {
          * @param X Input samples; surrendered by the caller
          */
         void fit(samples_t&& X);
+
+        /**
+         * @brief Get the parameters this discretizer was constructed with
+         * @return A config that constructs an equivalent, unfitted discretizer
+         *
+         * For a fitted PKIDisc this reports the bin count the fit selected.
+         */
+        inline BinDiscConfig getConfig() const { return BinDiscConfig{}.withNBins(n_bins).withStrategy(strategy).withSketchError(sketch.epsilon()); };
+
+        /**
+         * @brief Add a chunk of a stream to fit on, without keeping it
+         * @param chunk Samples; any size, including fewer than n_bins
+         * @throws ValidationError if a sample is not finite; the chunk is then
+         *         not added
+         *
+         * A UNIFORM model keeps the running minimum and maximum, a QUANTILE
+         * one a QuantileSketch; neither grows with the number of samples, so
+         * a column too long for memory can be fitted a chunk at a time. The
+         * cut points are unchanged until finalize(). fit() discards anything
+         * streamed so far.
+         *
+         * @code
+         * BinDisc disc(BinDiscConfig{}.withNBins(10).withStrategy(strategy_t::QUANTILE));
+         * while (reader.next(chunk)) disc.partial_fit(chunk);
+         * disc.finalize();
+         * @endcode
+         */
+        void partial_fit(const samples_t& chunk);
+
+        /**
+         * @brief Add the stream another discretizer has seen to this one's
+         * @throws InvalidParameter if other has a different strategy or bin
+         *         count, or, for QUANTILE, a different sketch_error
+         *
+         * Lets workers each stream part of a column and combine the results
+         * before finalize().
+         */
+        void merge(const BinDisc& other);
+
+        /**
+         * @brief Compute the cut points from everything streamed so far
+         * @throws ValidationError if fewer than n_bins samples were streamed
+         *
+         * Streaming may continue afterwards; a later finalize() covers it all.
+         * UNIFORM cut points are exactly those of fit() on the whole column.
+         * Each QUANTILE cut point's rank is within sketch_error of that of
+         * fit(), and while the stream has not outgrown the sketch's first
+         * level (3 / sketch_error samples) they are exactly those.
+         */
+        virtual void finalize();
+
+        /** @brief Samples streamed since the last fit(); 0 when none */
+        inline size_t streamed() const { return running.count; }
     protected:
+        /**
+         * @brief Bin by arithmetic when the cut points are equally spaced
+         *
+         * A UNIFORM model computes each label as (x - origin) / width, checked
+         * against the cut points so the labels stay exactly those of the search.
+         * QUANTILE models, and a UNIFORM fit of constant data, use the search.
+         */
+        void bin(const precision_t* data, size_t n, label_t* out) const override;
         std::vector<precision_t> linspace(precision_t start, precision_t end, int num);
-        std::vector<precision_t> percentile(samples_t& data, const std::vector<precision_t>& percentiles);
+        std::vector<precision_t> percentile(const samples_t& data, const std::vector<precision_t>& percentiles);
         int n_bins;
         strategy_t strategy;
         // static constexpr, not a const member: a const non-static member would
         // delete the copy and move assignment operators for this class and PKIDisc.
         static constexpr int min_bins = MIN_BINS;
+        // The grid of a UNIFORM fit; width is 0 when there is none to use.
+        precision_t origin = 0;
+        precision_t width = 0;
+        // What partial_fit() has seen, emptied by fit(): the extremes for
+        // either strategy, and the sketch for QUANTILE.
+        ColumnSummary running;
+        QuantileSketch sketch;
+        // Cut points of a fit, or a finalize(), that found min == max.
+        void fit_constant(precision_t value);
+        // Adds other's stream to this one's, whatever their bin counts.
+        void merge_stream(const BinDisc& other);
     private:
-        void validate_input(const samples_t& X) const;
-        void fit_uniform(const samples_t&);
-        // By value: the caller decides whether that costs a copy or a move.
-        void fit_quantile(samples_t data);
+        ColumnSummary validate_input(const samples_t& X) const;
+        void fit_uniform(const ColumnSummary& summary);
+        void absorb(const ColumnSummary& part);
+        // Reorders data unless summary says it is sorted, so the caller passes
+        // a copy or a buffer it adopted. Only the order statistics the
+        // percentiles read are selected; the data is not sorted.
+        void fit_quantile(samples_t& data, const ColumnSummary& summary);
     };
 }
 #endif
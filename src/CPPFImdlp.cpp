@@ -10,8 +10,23 @@
 #include <cmath>
 #include <stdexcept>
 #include "CPPFImdlp.h"
+#include "Trace.h"
 
 namespace mdlp {
+    namespace {
+        // Points a Metrics at the fit's statistics for the length of the fit,
+        // and away again however it ends, so that no copy of the discretizer
+        // is left counting into this one.
+        class CountInto {
+        public:
+            CountInto(Metrics& metrics_, FitStats* stats) : metrics(metrics_) { metrics.setStats(stats); }
+            ~CountInto() { metrics.setStats(nullptr); }
+            CountInto(const CountInto&) = delete;
+            CountInto& operator=(const CountInto&) = delete;
+        private:
+            Metrics& metrics;
+        };
+    }
 
     // Both constructors funnel through the config one, so validation lives in a
     // single place (MDLPConfig::validate) instead of being duplicated here.
@@ -76,53 +91,132 @@ namespace mdlp {
 
     void CPPFImdlp::fit(samples_t& X_, labels_t& y_)
     {
+        auto* stats = start_fit_stats();
+        FitTimer timer(stats, &FitStats::total_ns);
         X = X_;
         y = y_;
+        if (stats) {
+            stats->hold(X.size() * sizeof(precision_t) + y.size() * sizeof(label_t));
+        }
         fit_impl();
     }
 
     void CPPFImdlp::fit(samples_t&& X_, labels_t&& y_)
     {
+        auto* stats = start_fit_stats();
+        FitTimer timer(stats, &FitStats::total_ns);
         X = std::move(X_);
         y = std::move(y_);
         fit_impl();
     }
 
-    void CPPFImdlp::fit_impl()
+    void CPPFImdlp::fit(samples_t X_, labels_t y_, const indices_t& order)
+    {
+        auto* stats = start_fit_stats();
+        FitTimer timer(stats, &FitStats::total_ns);
+        X = std::move(X_);
+        y = std::move(y_);
+        GivenOrder given;
+        given.wide = order.data();
+        given.size = order.size();
+        fit_impl(&given);
+    }
+
+    void CPPFImdlp::fit(samples_t X_, labels_t y_, const uint32_t* order, size_t n_order, precision_t min, precision_t max)
+    {
+        auto* stats = start_fit_stats();
+        FitTimer timer(stats, &FitStats::total_ns);
+        X = std::move(X_);
+        y = std::move(y_);
+        GivenOrder given;
+        given.narrow = order;
+        given.size = n_order;
+        given.has_bounds = true;
+        given.min = min;
+        given.max = max;
+        fit_impl(&given);
+    }
+
+    void CPPFImdlp::fit_impl(const GivenOrder* order)
     {
-        // Validation order is load-bearing: compute_max_num_cut_points() rejects
-        // an out-of-range proposed_cuts before the size checks run, and tests
-        // depend on which message comes out.
-        num_cut_points = compute_max_num_cut_points();
-        depth = 0;
-        discretizedData.clear();
-        cutPoints.clear();
-        if (X.size() != y.size()) {
-            throw ValidationError("X and y must have the same size: " + std::to_string(X.size()) + " != " + std::to_string(y.size()));
+        MDLP_TRACE_SCOPE("fit_impl");
+        auto* stats = fit_stats_ptr();
+        ColumnSummary summary;
+        {
+            FitTimer timer(stats, &FitStats::validate_ns);
+            // Validation order is load-bearing: compute_max_num_cut_points() rejects
+            // an out-of-range proposed_cuts before the size checks run, and tests
+            // depend on which message comes out.
+            num_cut_points = compute_max_num_cut_points();
+            depth = 0;
+            discretizedData.clear();
+            cutPoints.clear();
+            if (X.size() != y.size()) {
+                throw ValidationError("X and y must have the same size: " + std::to_string(X.size()) + " != " + std::to_string(y.size()));
+            }
+            if (X.empty() || y.empty()) {
+                throw ValidationError("X and y must have at least one element");
+            }
+            // Must precede the sort: a NaN comparison breaks the strict weak ordering
+            // stable_sort requires, which is undefined behaviour rather than a wrong
+            // answer. A given order is checked without sorting, and gives the
+            // range itself.
+            if (order == nullptr) {
+                summary = summarize(X);
+            }
         }
-        if (X.empty() || y.empty()) {
-            throw ValidationError("X and y must have at least one element");
+        {
+            FitTimer timer(stats, &FitStats::sort_ns);
+            // Sorts the members, not the caller's vectors: after a move the latter no
+            // longer hold the data.
+            if (order != nullptr) {
+                if (order->wide != nullptr) {
+                    adopt_order(order->wide, order->size);
+                } else {
+                    adopt_order(order->narrow, order->size);
+                }
+                // Ascending, so the ends are the range, and with both ends finite
+                // so is every value between them.
+                summary = { X.size(), X[indices.front()], X[indices.back()], false };
+                if (!std::isfinite(summary.min) || !std::isfinite(summary.max)) {
+                    validate_finite(X);
+                }
+                if (order->has_bounds && (order->min != summary.min || order->max != summary.max)) {
+                    throw ValidationError("Stored range [" + detail::str(order->min) + ", " + detail::str(order->max)
+                        + "] is not the range of X: [" + detail::str(summary.min) + ", " + detail::str(summary.max) + "]");
+                }
+            } else {
+                indices = summary.sorted ? sortTies(X, y) : sortIndices(X, y);
+            }
         }
-        // Must precede the sort: a NaN comparison breaks the strict weak ordering
-        // stable_sort requires, which is undefined behaviour rather than a wrong
-        // answer.
-        validate_finite(X);
-        // Sorts the members, not the caller's vectors: after a move the latter no
-        // longer hold the data.
-        indices = sortIndices(X, y);
         metrics.setData(y, indices);
-        computeCutPoints(0, X.size(), 1);
-        sort(cutPoints.begin(), cutPoints.end());
+        if (stats) {
+            // The order, and Metrics' copies of it and of the labels.
+            stats->hold(2 * indices.size() * sizeof(size_t) + y.size() * sizeof(label_t));
+        }
+        CountInto counting(metrics, stats);
+        {
+            FitTimer timer(stats, &FitStats::search_ns);
+            computeCutPoints(0, X.size(), 1);
+            sort(cutPoints.begin(), cutPoints.end());
+        }
         if (num_cut_points > 0) {
+            FitTimer timer(stats, &FitStats::prune_ns);
+            const auto found = cutPoints.size();
             // Select the best (with lower entropy) cut points
             while (cutPoints.size() > num_cut_points) {
                 resizeCutPoints();
             }
+            if (stats) {
+                stats->cuts_pruned = found - cutPoints.size();
+            }
+        }
+        if (stats) {
+            stats->max_depth = depth;
         }
         // Insert first & last X value to the cutpoints as them shall be ignored in transform
-        auto [vmin, vmax] = std::minmax_element(X.begin(), X.end());
-        cutPoints.push_back(*vmax);
-        cutPoints.insert(cutPoints.begin(), *vmin);
+        cutPoints.push_back(summary.max);
+        cutPoints.insert(cutPoints.begin(), summary.min);
     }
 
     std::pair<precision_t, size_t> CPPFImdlp::valueCutPoint(size_t start, size_t cut, size_t end)
@@ -138,6 +232,8 @@ namespace mdlp {
         previous = safe_X_access(idxPrev);
         actual = safe_X_access(cut);
         next = safe_X_access(idxNext);
+        const size_t firstPrev = idxPrev;
+        const size_t firstNext = idxNext;
         // definition 2 of the paper => X[t-1] < X[t]
         // get the first equal value of X in the interval
         while (idxPrev > start && actual == previous) {
@@ -150,6 +246,9 @@ namespace mdlp {
             ++idxNext;
             next = safe_X_access(idxNext);
         }
+        if (auto* stats = fit_stats_ptr()) {
+            stats->duplicate_steps += (firstPrev - idxPrev) + (idxNext - firstNext);
+        }
         // # of duplicates before cutpoint
         n = safe_subtract(safe_subtract(cut, 1), idxPrev);
         // # of duplicates after cutpoint
@@ -172,16 +271,23 @@ namespace mdlp {
         // Check if the interval length and the depth are Ok
         if (end < start || safe_subtract(end, start) < min_length || depth_ > max_depth)
             return;
+        MDLP_TRACE_SCOPE_RANGE("computeCutPoints", start, end);
         depth = depth_ > depth ? depth_ : depth;
         cut = getCandidate(start, end);
         if (cut == std::numeric_limits<size_t>::max())
             return;
+        auto* stats = fit_stats_ptr();
         if (mdlp(start, cut, end)) {
+            if (stats) {
+                ++stats->cuts_accepted;
+            }
             result = valueCutPoint(start, cut, end);
             cut = result.second;
             cutPoints.push_back(result.first);
             computeCutPoints(start, cut, depth_ + 1);
             computeCutPoints(cut, end, depth_ + 1);
+        } else if (stats) {
+            ++stats->cuts_rejected;
         }
     }
 
@@ -189,8 +295,14 @@ namespace mdlp {
     {
         /* Definition 1: A binary discretization for A is determined by selecting the cut point TA for which
         E(A, TA; S) is minimal amongst all the candidate cut points. */
+        MDLP_TRACE_SCOPE_RANGE("getCandidate", start, end);
         size_t candidate = std::numeric_limits<size_t>::max();
         size_t elements = safe_subtract(end, start);
+        auto* stats = fit_stats_ptr();
+        if (stats) {
+            ++stats->candidate_calls;
+            stats->elements_scanned += elements;
+        }
         bool sameValues = true;
         // Check if all the values of the variable in the interval are the same
         for (size_t idx = start + 1; idx < end; idx++) {
@@ -226,6 +338,10 @@ namespace mdlp {
         // makes each side's result identical to entropy() over the same range.
         labels_t counts_left(static_cast<size_t>(max_label) + 1, 0);
         labels_t counts_right(static_cast<size_t>(max_label) + 1, 0);
+        const size_t counts_bytes = 2 * counts_left.size() * sizeof(label_t);
+        if (stats) {
+            stats->hold(counts_bytes);
+        }
         int n_left = 0;
         int n_right = 0;
         for (size_t idx = start; idx < end; idx++) {
@@ -252,6 +368,9 @@ namespace mdlp {
                 candidate = idx;
             }
         }
+        if (stats) {
+            stats->release(counts_bytes);
+        }
         return candidate;
     }
 
@@ -279,9 +398,48 @@ namespace mdlp {
         return ig > term;
     }
 
+    template <typename Index>
+    void CPPFImdlp::adopt_order(const Index* order, size_t n)
+    {
+        if (n != X.size()) {
+            throw ValidationError("order must hold one index per sample: " + std::to_string(n) + " != " + std::to_string(X.size()));
+        }
+        indices.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            const size_t b = order[i];
+            if (b >= n) {
+                throw ValidationError("order[" + std::to_string(i) + "] = " + std::to_string(b)
+                    + " is out of range for " + std::to_string(n) + " samples");
+            }
+            // Strictly ascending triples are distinct, so order is also a
+            // permutation; no second pass is needed to rule out repeats.
+            if (i > 0) {
+                const size_t a = indices[i - 1];
+                const bool ascending = X[a] < X[b] || (X[a] == X[b] && (y[a] < y[b] || (y[a] == y[b] && a < b)));
+                if (!ascending) {
+                    // A NaN compares false both ways; name it as summarize() would.
+                    if (std::isnan(X[a]) || std::isnan(X[b])) {
+                        validate_finite(X);
+                    }
+                    throw ValidationError("order is not the sort order of X and y at position " + std::to_string(i));
+                }
+            }
+            indices[i] = b;
+        }
+    }
+
+    indices_t CPPFImdlp::sortOrder(const samples_t& X_, const labels_t& y_)
+    {
+        if (X_.size() != y_.size()) {
+            throw ValidationError("X and y must have the same size: " + std::to_string(X_.size()) + " != " + std::to_string(y_.size()));
+        }
+        return summarize(X_).sorted ? sortTies(X_, y_) : sortIndices(X_, y_);
+    }
+
     // Argsort from https://stackoverflow.com/questions/1577475/c-sorting-and-keeping-track-of-indexes
-    indices_t CPPFImdlp::sortIndices(samples_t& X_, labels_t& y_)
+    indices_t CPPFImdlp::sortIndices(const samples_t& X_, const labels_t& y_)
     {
+        MDLP_TRACE_SCOPE("sortIndices");
         indices_t idx(X_.size());
         std::iota(idx.begin(), idx.end(), 0);
         stable_sort(idx.begin(), idx.end(), [&X_, &y_](size_t i1, size_t i2) {
@@ -296,6 +454,25 @@ namespace mdlp {
         return idx;
     }
 
+    indices_t CPPFImdlp::sortTies(const samples_t& X_, const labels_t& y_)
+    {
+        // The order sortIndices() gives: ascending X, ties by ascending y.
+        indices_t idx(X_.size());
+        std::iota(idx.begin(), idx.end(), 0);
+        for (size_t begin = 0; begin < X_.size();) {
+            size_t end = begin + 1;
+            while (end < X_.size() && X_[end] == X_[begin]) {
+                ++end;
+            }
+            if (end - begin > 1) {
+                std::stable_sort(idx.begin() + static_cast<long>(begin), idx.begin() + static_cast<long>(end),
+                    [&y_](size_t i1, size_t i2) { return y_[i1] < y_[i2]; });
+            }
+            begin = end;
+        }
+        return idx;
+    }
+
     void CPPFImdlp::resizeCutPoints()
     {
         //Compute entropy of each of the whole cutpoint set and discards the biggest value
@@ -8,6 +8,7 @@
 #define CPPFIMDLP_H
 
 #include "typesFImdlp.h"
+#include <cstdint>
 #include <limits>
 #include <utility>
 #include <string>
@@ -49,10 +50,10 @@ namespace mdlp {
      * auto result = disc.transform(X);
      * auto cut_points = disc.getCutPoints();
      * 
-     * // PyTorch tensor support
+     * // PyTorch tensor support, see DiscretizerTorch.h
      * auto X_torch = torch::tensor(X, torch::kFloat32);
      * auto y_torch = torch::tensor(y, torch::kInt32);
-     * auto result_torch = disc.fit_transform_t(X_torch, y_torch);
+     * auto result_torch = fit_transform_t(disc, X_torch, y_torch);
      * @endcode
      * 
      * ## Constructor Parameters
@@ -143,12 +144,60 @@ namespace mdlp {
          */
         void fit(samples_t&& X_, labels_t&& y_) override;
 
+        /**
+         * @brief Fit with the sort order already computed
+         * @param X_ Input samples; pass a temporary to have it moved in
+         * @param y_ Labels; likewise
+         * @param order What sortOrder(X_, y_) returns, computed earlier
+         * @throws ValidationError if order is not that order: another size, an
+         *         index out of range, or two neighbours out of order
+         *
+         * Same cut points as fit(X_, y_), without the sort, which is most of a
+         * fit on large data, and without the pass that finds X_'s range: the
+         * ends of the order are its minimum and maximum. The order is not
+         * trusted: one linear pass checks that every neighbouring pair ascends
+         * by value, label and position, which only the one order does, while
+         * copying it into the positions the search walks.
+         */
+        void fit(samples_t X_, labels_t y_, const indices_t& order);
+
+        /**
+         * @brief Fit from a sort order stored as 32-bit positions
+         * @param order n_order positions, as DatasetFile::order() maps them;
+         *        read in place, never copied as they are
+         * @param min The smallest value of X_, stored with the order
+         * @param max The largest value of X_, stored with the order
+         * @throws ValidationError if order is not sortOrder(X_, y_), or min and
+         *         max are not the values at its two ends
+         *
+         * The overload above, widening each position as it is checked; see
+         * DatasetFile::fit().
+         */
+        void fit(samples_t X_, labels_t y_, const uint32_t* order, size_t n_order, precision_t min, precision_t max);
+
+        /**
+         * @brief The order fit() visits the samples in
+         * @return Positions by ascending X, ties by ascending y, then by position
+         * @throws ValidationError if X_ and y_ differ in size or X_ holds a
+         *         non-finite value
+         */
+        static indices_t sortOrder(const samples_t& X_, const labels_t& y_);
+
         /**
          * @brief Get the maximum depth reached during fitting
          * @return Maximum recursion depth
          */
         inline int get_depth() const { return depth; };
 
+        /**
+         * @brief Get the parameters this discretizer was constructed with
+         * @return A config that constructs an equivalent, unfitted discretizer
+         */
+        inline MDLPConfig getConfig() const
+        {
+            return MDLPConfig{}.withMinLength(min_length).withMaxDepth(max_depth).withProposedCuts(proposed_cuts);
+        };
+
     protected:
         size_t min_length = 3;
         int depth = 0;
@@ -162,7 +211,15 @@ namespace mdlp {
         // which would make the class unsafe to copy or move.
         Metrics metrics;
         size_t num_cut_points = std::numeric_limits<size_t>::max();
-        static indices_t sortIndices(samples_t&, labels_t&);
+        static indices_t sortIndices(const samples_t&, const labels_t&);
+        /**
+         * @brief sortIndices() for X already in ascending order
+         *
+         * Only runs of equal values are out of order — by label — so only they
+         * are sorted: linear for distinct values, where sortIndices() is
+         * n log n whatever the input.
+         */
+        static indices_t sortTies(const samples_t&, const labels_t&);
 
         // Out of line and [[noreturn]] on purpose. These are the cold paths of
         // safe_X_access and safe_y_access, which are inline and called once per
@@ -171,8 +228,23 @@ namespace mdlp {
         [[noreturn]] static void throw_indices_empty();
         [[noreturn]] static void throw_index_out_of_range(const char* array, size_t idx, size_t size);
         [[noreturn]] static void throw_underflow(size_t a, size_t b);
-        // Shared body of both fit() overloads; assumes X and y are already set.
-        void fit_impl();
+        // A sort order handed to fit() instead of computed: full-width or
+        // 32-bit positions, and the bounds stored with the latter.
+        struct GivenOrder {
+            const size_t* wide = nullptr;
+            const uint32_t* narrow = nullptr;
+            size_t size = 0;
+            bool has_bounds = false;
+            precision_t min = 0;
+            precision_t max = 0;
+        };
+        // Shared body of every fit() overload; assumes X and y are already set.
+        // Sorts, unless given the order to use instead.
+        void fit_impl(const GivenOrder* order = nullptr);
+        // Copies order into indices, throwing unless it is the one sortIndices()
+        // would give for X and y.
+        template <typename Index>
+        void adopt_order(const Index* order, size_t n);
         void computeCutPoints(size_t, size_t, int);
         void resizeCutPoints();
         bool mdlp(size_t, size_t, size_t);
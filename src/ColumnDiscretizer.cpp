@@ -0,0 +1,227 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <utility>
+#include "ColumnDiscretizer.h"
+#include "Trace.h"
+
+namespace mdlp {
+
+    namespace {
+        // Called from a catch block: the exception being handled, with column
+        // j named in front of a ValidationError's message.
+        std::exception_ptr column_error(size_t j)
+        {
+            try {
+                throw;
+            }
+            catch (const ValidationError& e) {
+                return std::make_exception_ptr(ValidationError("Column " + std::to_string(j) + ": " + e.what()));
+            }
+            catch (...) {
+                return std::current_exception();
+            }
+        }
+
+        // Rows per transform task. A multiple of 16, so tiles of a 64-byte
+        // aligned result start on a cache line of their own and no two tasks
+        // write the same line; about 64 KiB of labels, so a tile stays in cache
+        // while its columns are scattered into it; and small enough for four
+        // tiles per thread when the data allows.
+        size_t tile_rows(size_t n, size_t n_columns, size_t concurrency)
+        {
+            constexpr size_t line = 16;
+            const auto round_up = [](size_t rows) { return (rows + line - 1) / line * line; };
+            const size_t by_cache = round_up((size_t{ 1 } << 14) / n_columns);
+            const size_t by_threads = round_up((n + 4 * concurrency - 1) / (4 * concurrency));
+            return std::max(line, std::min(by_cache, by_threads));
+        }
+    }
+
+    ColumnDiscretizer::ColumnDiscretizer(factory_t factory_) : factory(std::move(factory_))
+    {
+        if (!factory) {
+            throw InvalidParameter("ColumnDiscretizer needs a factory");
+        }
+    }
+
+    void ColumnDiscretizer::validate_samples(const torch::Tensor& X_)
+    {
+        if (X_.dim() != 2) {
+            throw ValidationError("Only 2D tensors supported");
+        }
+        if (!X_.is_cpu()) {
+            throw ValidationError("X tensor must reside on the CPU"); // LCOV_EXCL_LINE
+        }
+        if (X_.scalar_type() != torch::kFloat32 && X_.scalar_type() != torch::kFloat64) {
+            throw ValidationError("X tensor must be Float32 or Float64 type");
+        }
+        if (X_.numel() == 0) {
+            throw ValidationError("Tensors cannot be empty");
+        }
+    }
+
+    void ColumnDiscretizer::for_each_column(size_t n_columns, Executor& executor, const std::function<void(size_t)>& task)
+    {
+        std::vector<std::exception_ptr> errors(n_columns);
+        executor.run(n_columns, [&](size_t j) {
+            try {
+                task(j);
+            }
+            catch (...) {
+                errors[j] = column_error(j);
+            }
+            });
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    void ColumnDiscretizer::fit_t(const torch::Tensor& X_, const torch::Tensor& y_, size_t n_threads)
+    {
+        ThreadPool pool(n_threads);
+        fit_t(X_, y_, pool);
+    }
+    void ColumnDiscretizer::fit_t(const torch::Tensor& X_, const torch::Tensor& y_, Executor& executor)
+    {
+        validate_samples(X_);
+        detail::validate_tensor(y_, torch::kInt32, torch::kInt64, "y", "Int32 or Int64", "Tensors cannot be empty");
+        const auto n = static_cast<size_t>(X_.size(0));
+        const auto n_columns = static_cast<size_t>(X_.size(1));
+        if (static_cast<size_t>(y_.numel()) != n) {
+            throw ValidationError("y must have one label per row of X: got "
+                + std::to_string(y_.numel()) + " labels for " + std::to_string(n) + " rows");
+        }
+        labels_t y(n);
+        detail::read_labels(y_, y.data());
+        std::vector<std::unique_ptr<Discretizer>> fitted(n_columns);
+        for (auto& model : fitted) {
+            model = factory();
+            if (!model) {
+                throw InvalidParameter("ColumnDiscretizer factory returned no discretizer");
+            }
+        }
+        for_each_column(n_columns, executor, [&](size_t j) {
+            samples_t column(n);
+            detail::read_samples(X_.select(1, static_cast<int64_t>(j)), 0, n, column.data());
+            // Each model may keep the labels it is given, so each gets its own.
+            labels_t labels(y);
+            fitted[j]->fit(std::move(column), std::move(labels));
+            });
+        models = std::move(fitted);
+    }
+
+    torch::Tensor ColumnDiscretizer::transform_t(const torch::Tensor& X_, size_t n_threads) const
+    {
+        ThreadPool pool(n_threads);
+        return transform_t(X_, pool);
+    }
+    torch::Tensor ColumnDiscretizer::transform_t(const torch::Tensor& X_, Executor& executor) const
+    {
+        validate_samples(X_);
+        if (models.empty()) {
+            throw NotFittedError("ColumnDiscretizer not fitted yet");
+        }
+        const auto n_columns = static_cast<size_t>(X_.size(1));
+        if (n_columns != models.size()) {
+            throw ValidationError("X has " + std::to_string(n_columns)
+                + " columns but the discretizer was fitted on " + std::to_string(models.size()));
+        }
+        const auto n = static_cast<size_t>(X_.size(0));
+        std::vector<torch::Tensor> columns;
+        columns.reserve(n_columns);
+        for (size_t j = 0; j < n_columns; ++j) {
+            columns.push_back(X_.select(1, static_cast<int64_t>(j)));
+        }
+        // An unfitted model fails on its whole column, with the error its own
+        // transform_t() would raise: a non-finite sample before the missing
+        // fit. Checked once here rather than by every tile, which then stop
+        // short of that column, since its error wins over any later one.
+        size_t n_ready = n_columns;
+        std::exception_ptr unfitted;
+        for (size_t j = 0; j < n_columns && !unfitted; ++j) {
+            if (models[j]->cutPoints.size() < 2) {
+                n_ready = j;
+                try {
+                    samples_t column(n);
+                    detail::read_samples(columns[j], 0, n, column.data());
+                    Discretizer::validate_transform_input(column, models[j]->cutPoints.size());
+                }
+                catch (...) {
+                    unfitted = column_error(j);
+                }
+            }
+        }
+        auto result = torch::empty({ X_.size(0), X_.size(1) }, torch_label_t);
+        label_t* out = result.data_ptr<label_t>();
+        // Tasks are tiles of rows, each binning every column of its rows into
+        // its own contiguous part of the row-major result. One task per column
+        // would have every thread writing into every cache line of it.
+        const size_t rows = tile_rows(n, n_columns, executor.concurrency());
+        const size_t n_tiles = (n + rows - 1) / rows;
+        std::vector<size_t> failed_column(n_tiles, n_columns);
+        std::vector<std::exception_ptr> errors(n_tiles);
+        executor.run(n_tiles, [&](size_t tile) {
+            const size_t begin = tile * rows;
+            const size_t count = std::min(rows, n - begin);
+            MDLP_TRACE_SCOPE_RANGE("column transform tile", begin, begin + count);
+            samples_t samples(count);
+            labels_t labels(count);
+            label_t* tile_out = out + begin * n_columns;
+            size_t j = 0;
+            try {
+                for (; j < n_ready; ++j) {
+                    detail::read_samples(columns[j], begin, count, samples.data());
+                    Discretizer::validate_finite(samples.data(), count, begin);
+                    models[j]->bin(samples.data(), count, labels.data());
+                    for (size_t i = 0; i < count; ++i) {
+                        tile_out[i * n_columns + j] = labels[i];
+                    }
+                }
+            }
+            catch (...) {
+                failed_column[tile] = j;
+                errors[tile] = column_error(j);
+            }
+            });
+        // Each tile stopped at its lowest bad column; of the tiles that stopped
+        // at the lowest one overall, the first holds its first bad row.
+        size_t first = n_tiles;
+        for (size_t tile = 0; tile < n_tiles; ++tile) {
+            if (errors[tile] && (first == n_tiles || failed_column[tile] < failed_column[first])) {
+                first = tile;
+            }
+        }
+        if (first < n_tiles) {
+            std::rethrow_exception(errors[first]);
+        }
+        if (unfitted) {
+            std::rethrow_exception(unfitted);
+        }
+        return result;
+    }
+
+    torch::Tensor ColumnDiscretizer::fit_transform_t(const torch::Tensor& X_, const torch::Tensor& y_, size_t n_threads)
+    {
+        ThreadPool pool(n_threads);
+        fit_t(X_, y_, pool);
+        return transform_t(X_, pool);
+    }
+
+    const Discretizer& ColumnDiscretizer::model(size_t j) const
+    {
+        if (j >= models.size()) {
+            throw IndexError("Column " + std::to_string(j) + " out of range for "
+                + std::to_string(models.size()) + " fitted columns");
+        }
+        return *models[j];
+    }
+}
@@ -0,0 +1,118 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_COLUMNDISCRETIZER_H
+#define MDLP_COLUMNDISCRETIZER_H
+
+#ifndef MDLP_WITH_TORCH
+#error "ColumnDiscretizer.h needs fimdlp_torch: link fimdlp::fimdlp_torch or fimdlp::fimdlp"
+#endif
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <torch/torch.h>
+#include "DiscretizerTorch.h"
+#include "Executor.h"
+
+namespace mdlp {
+    /**
+     * @brief One discretizer per column of an [n, f] tensor
+     *
+     * Fits f independent models — one per feature, all sharing the labels — and
+     * transforms an [n, f] tensor into an [n, f] label tensor, in one call each.
+     * Both run in parallel on an Executor and read the tensor through its
+     * stride, so neither a row-major nor a column-major dataset is copied
+     * column by column first. Fitting runs one task per column; transforming
+     * runs one per tile of rows, so that each task writes its own part of the
+     * row-major result.
+     *
+     * @code
+     * ColumnDiscretizer disc([] { return std::make_unique<CPPFImdlp>(); });
+     * disc.fit_t(X, y);                 // X: [n, f] Float32, y: [n] Int32
+     * auto labels = disc.transform_t(X); // [n, f] Int32
+     * auto cuts = disc.model(2).getCutPoints();
+     * @endcode
+     */
+    class ColumnDiscretizer {
+    public:
+        /** @brief Makes the unfitted model of one column */
+        using factory_t = std::function<std::unique_ptr<Discretizer>()>;
+
+        /**
+         * @param factory Called once per column on every fit
+         * @throws InvalidParameter if factory is empty
+         */
+        explicit ColumnDiscretizer(factory_t factory);
+
+        /**
+         * @brief Fit one model per column
+         * @param X_ Samples (Float32 or Float64, [n, f], CPU)
+         * @param y_ Labels shared by every column (Int32 or Int64, [n], CPU)
+         * @param n_threads Threads to use, the caller's included; 0 means one
+         *        per hardware thread
+         * @throws ValidationError if a tensor has the wrong rank, dtype or size,
+         *         is empty, or if a column fails its model's checks; the message
+         *         then names the first such column
+         * @throws InvalidParameter if the factory returns no model
+         *
+         * The models are replaced only when every column has been fitted.
+         */
+        void fit_t(const torch::Tensor& X_, const torch::Tensor& y_, size_t n_threads = 0);
+
+        /** @brief Fit one model per column, on an executor; see above */
+        void fit_t(const torch::Tensor& X_, const torch::Tensor& y_, Executor& executor);
+
+        /**
+         * @brief Discretize every column with its model
+         * @param X_ Samples (Float32 or Float64, [n, f], CPU)
+         * @param n_threads Threads to use, the caller's included; 0 means one
+         *        per hardware thread
+         * @return Labels (Int32, [n, f]); column j is transform_t() of model(j)
+         *         of column j
+         * @throws NotFittedError if fit_t() has not succeeded yet
+         * @throws ValidationError if X_ has the wrong rank or dtype, is empty,
+         *         has a column count other than the fitted one, or holds a
+         *         non-finite value; the message names the first such column
+         */
+        torch::Tensor transform_t(const torch::Tensor& X_, size_t n_threads = 0) const;
+
+        /** @brief Discretize every column, on an executor; see above */
+        torch::Tensor transform_t(const torch::Tensor& X_, Executor& executor) const;
+
+        /** @brief fit_t() then transform_t() of the same samples */
+        torch::Tensor fit_transform_t(const torch::Tensor& X_, const torch::Tensor& y_, size_t n_threads = 0);
+
+        /** @brief Number of fitted columns; 0 before the first fit */
+        inline size_t size() const { return models.size(); }
+
+        /**
+         * @brief The model of column j
+         * @throws IndexError if j is not a fitted column
+         */
+        const Discretizer& model(size_t j) const;
+
+    private:
+        /**
+         * @brief Check an [n, f] sample tensor
+         * @throws ValidationError if it is not 2-D, Float32 or Float64, or non-empty
+         */
+        static void validate_samples(const torch::Tensor& X_);
+
+        /**
+         * @brief Run task(j) for every column, then rethrow the lowest column's error
+         *
+         * Executors rethrow an arbitrary task's exception; this keeps the error
+         * of a bad input independent of scheduling. A ValidationError is
+         * rethrown with the column's index in front of its message.
+         */
+        static void for_each_column(size_t n_columns, Executor& executor, const std::function<void(size_t)>& task);
+
+        factory_t factory;
+        std::vector<std::unique_ptr<Discretizer>> models;
+    };
+}
+#endif
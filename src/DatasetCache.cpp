@@ -0,0 +1,367 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include "DatasetCache.h"
+#include "CPPFImdlp.h"
+#include "Exceptions.h"
+
+namespace mdlp {
+
+    namespace {
+        constexpr char MAGIC[8] = { 'F', 'I', 'M', 'D', 'L', 'P', 'D', '\n' };
+        // Reads back as 0x04030201 on a machine of the other byte order.
+        constexpr uint32_t ENDIAN_TAG = 0x01020304u;
+        // Arrays start on a cache line, so a mapped column is as aligned as an
+        // allocated one.
+        constexpr uint64_t ALIGNMENT = 64;
+
+        struct FileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t endian_tag;
+            uint64_t n_samples;
+            uint64_t n_features;
+            uint64_t has_order;       // 0 or 1
+            uint64_t names_offset;    // bytes from the start of the file
+            uint64_t names_size;
+            uint64_t labels_offset;
+            uint64_t file_size;
+        };
+
+        struct ColumnRecord {
+            uint64_t column_offset;
+            uint64_t order_offset;    // zero without orders
+            float min;
+            float max;
+        };
+
+        static_assert(sizeof(FileHeader) == 72, "dataset file header layout changed");
+        static_assert(sizeof(ColumnRecord) == 24, "dataset file record layout changed");
+        static_assert(std::is_trivially_copyable<ColumnRecord>::value, "records are copied as bytes");
+        static_assert(sizeof(precision_t) == 4 && sizeof(label_t) == 4, "values and labels are stored in 32 bits");
+
+        uint64_t aligned(uint64_t offset)
+        {
+            return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        }
+
+        void put_string(std::string& names, const std::string& text)
+        {
+            const auto length = static_cast<uint32_t>(text.size());
+            names.append(reinterpret_cast<const char*>(&length), sizeof(length));
+            names += text;
+        }
+
+        // Reads the names section back, refusing to step outside it.
+        class NameReader {
+        public:
+            NameReader(const unsigned char* begin, size_t size, const std::string& path) : p(begin), last(begin + size), path(path) {}
+
+            uint32_t count()
+            {
+                if (static_cast<size_t>(last - p) < sizeof(uint32_t)) {
+                    throw ValidationError(path + " has a names section that ends early");
+                }
+                uint32_t value;
+                std::memcpy(&value, p, sizeof(value));
+                p += sizeof(value);
+                return value;
+            }
+            std::string text()
+            {
+                const uint32_t length = count();
+                if (length > static_cast<size_t>(last - p)) {
+                    throw ValidationError(path + " has a names section that ends early");
+                }
+                std::string value(reinterpret_cast<const char*>(p), length);
+                p += length;
+                return value;
+            }
+
+        private:
+            const unsigned char* p;
+            const unsigned char* last;
+            const std::string& path;
+        };
+
+        void check_shape(const Dataset& dataset)
+        {
+            if (dataset.X.size() != dataset.attributes.size()) {
+                throw ValidationError("Dataset has " + std::to_string(dataset.X.size()) + " columns and "
+                    + std::to_string(dataset.attributes.size()) + " attribute names");
+            }
+            for (size_t j = 0; j < dataset.X.size(); ++j) {
+                if (dataset.X[j].size() != dataset.y.size()) {
+                    throw ValidationError("Column " + std::to_string(j) + " has " + std::to_string(dataset.X[j].size())
+                        + " values and there are " + std::to_string(dataset.y.size()) + " labels");
+                }
+            }
+        }
+
+        void write_padding(std::ostream& out, uint64_t from, uint64_t to)
+        {
+            static const char zeros[ALIGNMENT] = {};
+            out.write(zeros, static_cast<std::streamsize>(to - from));
+        }
+    }
+
+    void save_dataset(const std::string& path, const Dataset& dataset, bool with_order, Executor& executor)
+    {
+        // Everything that can be rejected is rejected before the file is touched.
+        check_shape(dataset);
+        const size_t n = dataset.y.size();
+        const size_t n_features = dataset.X.size();
+        if (with_order && n > std::numeric_limits<uint32_t>::max()) {
+            throw ValidationError("Dataset has " + std::to_string(n) + " samples; stored orders hold at most "
+                + std::to_string(std::numeric_limits<uint32_t>::max()));
+        }
+        std::vector<ColumnRecord> records(n_features);
+        std::vector<std::vector<uint32_t>> orders(with_order ? n_features : 0);
+        std::vector<std::exception_ptr> errors(n_features);
+        executor.run(n_features, [&](size_t j) {
+            try {
+                const auto& column = dataset.X[j];
+                for (size_t i = 0; i < n; ++i) {
+                    if (!std::isfinite(column[i])) {
+                        throw ValidationError("Column " + std::to_string(j) + ": value " + detail::str(column[i])
+                            + " at index " + std::to_string(i) + " is not finite");
+                    }
+                }
+                if (n > 0) {
+                    const auto [min, max] = std::minmax_element(column.begin(), column.end());
+                    records[j].min = *min;
+                    records[j].max = *max;
+                }
+                if (with_order) {
+                    const auto order = CPPFImdlp::sortOrder(column, dataset.y);
+                    orders[j].assign(order.begin(), order.end());
+                }
+            }
+            catch (...) {
+                errors[j] = std::current_exception();
+            }
+            });
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        std::string names;
+        for (const auto& [name, type] : dataset.attributes) {
+            put_string(names, name);
+            put_string(names, type);
+        }
+        put_string(names, dataset.class_name);
+        put_string(names, dataset.class_type);
+        const auto n_values = static_cast<uint32_t>(dataset.class_values.size());
+        names.append(reinterpret_cast<const char*>(&n_values), sizeof(n_values));
+        for (const auto& value : dataset.class_values) {
+            put_string(names, value);
+        }
+
+        FileHeader header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = DATASET_FORMAT_VERSION;
+        header.endian_tag = ENDIAN_TAG;
+        header.n_samples = n;
+        header.n_features = n_features;
+        header.has_order = with_order ? 1 : 0;
+        header.names_offset = sizeof(FileHeader) + n_features * sizeof(ColumnRecord);
+        header.names_size = names.size();
+        header.labels_offset = aligned(header.names_offset + header.names_size);
+        const uint64_t array_bytes = aligned(n * sizeof(label_t));
+        uint64_t offset = header.labels_offset + array_bytes;
+        for (auto& record : records) {
+            record.column_offset = offset;
+            offset += array_bytes;
+        }
+        for (auto& record : records) {
+            record.order_offset = with_order ? offset : 0;
+            offset += with_order ? array_bytes : 0;
+        }
+        header.file_size = offset;
+
+        replace_file(path, [&](std::ostream& out) {
+            const auto write_array = [&out](const void* data, size_t bytes) {
+                out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+                write_padding(out, bytes, aligned(bytes));
+                };
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(records.data()),
+                static_cast<std::streamsize>(records.size() * sizeof(ColumnRecord)));
+            out.write(names.data(), static_cast<std::streamsize>(names.size()));
+            write_padding(out, header.names_offset + header.names_size, header.labels_offset);
+            write_array(dataset.y.data(), n * sizeof(label_t));
+            for (const auto& column : dataset.X) {
+                write_array(column.data(), n * sizeof(precision_t));
+            }
+            for (const auto& order : orders) {
+                write_array(order.data(), n * sizeof(uint32_t));
+            }
+            });
+    }
+
+    void save_dataset(const std::string& path, const Dataset& dataset, bool with_order, size_t n_threads)
+    {
+        if (!with_order || n_threads == 1 || dataset.X.size() < 2) {
+            ThreadPool caller_only(1);
+            save_dataset(path, dataset, with_order, caller_only);
+            return;
+        }
+        ThreadPool pool(n_threads);
+        save_dataset(path, dataset, with_order, pool);
+    }
+
+    DatasetFile DatasetFile::open(const std::string& path)
+    {
+        DatasetFile result;
+        result.file = MappedFile(path);
+        const unsigned char* base = result.file.data();
+        const size_t size = result.file.size();
+
+        if (size < sizeof(FileHeader)) {
+            throw ValidationError(path + " is too short to be a dataset file");
+        }
+        FileHeader header;
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            throw ValidationError(path + " is not a dataset file");
+        }
+        if (header.endian_tag != ENDIAN_TAG) {
+            throw ValidationError(path + " was written on a machine of the other byte order");
+        }
+        if (header.version != DATASET_FORMAT_VERSION) {
+            throw ValidationError(path + " has dataset format version " + std::to_string(header.version)
+                + ", expected " + std::to_string(DATASET_FORMAT_VERSION));
+        }
+        if (header.file_size != size) {
+            throw ValidationError(path + " is " + std::to_string(size) + " bytes, its header says "
+                + std::to_string(header.file_size) + "; it is truncated or was modified");
+        }
+        // Division, not multiplication: a forged count must not overflow the checks.
+        if (header.n_features > (size - sizeof(FileHeader)) / sizeof(ColumnRecord) || header.has_order > 1) {
+            throw ValidationError(path + " declares more columns than it can hold");
+        }
+        const uint64_t records_end = sizeof(FileHeader) + header.n_features * sizeof(ColumnRecord);
+        if (header.names_offset < records_end || header.names_offset > size || header.names_size > size - header.names_offset) {
+            throw ValidationError(path + " has its names outside the file");
+        }
+        const uint64_t data_start = header.names_offset + header.names_size;
+        const auto inside = [&](uint64_t offset) {
+            return offset >= data_start && offset % ALIGNMENT == 0 && offset <= size
+                && header.n_samples <= (size - offset) / sizeof(uint32_t);
+            };
+        if (!inside(header.labels_offset)) {
+            throw ValidationError(path + " has its labels outside the file");
+        }
+        const auto* records = reinterpret_cast<const ColumnRecord*>(base + sizeof(FileHeader));
+        for (size_t j = 0; j < header.n_features; ++j) {
+            if (!inside(records[j].column_offset) || (header.has_order && !inside(records[j].order_offset))) {
+                throw ValidationError(path + ": column " + std::to_string(j) + " lies outside the file");
+            }
+        }
+
+        NameReader reader(base + header.names_offset, header.names_size, path);
+        result.attributes_.reserve(header.n_features);
+        for (size_t j = 0; j < header.n_features; ++j) {
+            auto name = reader.text();
+            result.attributes_.emplace_back(std::move(name), reader.text());
+        }
+        result.class_name = reader.text();
+        result.class_type = reader.text();
+        const uint32_t n_values = reader.count();
+        for (uint32_t v = 0; v < n_values; ++v) {
+            result.class_values.push_back(reader.text());
+        }
+        result.n_samples = header.n_samples;
+        result.has_order = header.has_order == 1;
+        result.records = records;
+        result.labels_ = reinterpret_cast<const label_t*>(base + header.labels_offset);
+        return result;
+    }
+
+    const void* DatasetFile::record(size_t feature) const
+    {
+        if (feature >= attributes_.size()) {
+            throw IndexError("Column index " + std::to_string(feature) + " out of range for a file of "
+                + std::to_string(attributes_.size()) + " columns");
+        }
+        return static_cast<const ColumnRecord*>(records) + feature;
+    }
+
+    const precision_t* DatasetFile::column(size_t feature) const
+    {
+        const auto* r = static_cast<const ColumnRecord*>(record(feature));
+        return reinterpret_cast<const precision_t*>(file.data() + r->column_offset);
+    }
+
+    const uint32_t* DatasetFile::order(size_t feature) const
+    {
+        const auto* r = static_cast<const ColumnRecord*>(record(feature));
+        return has_order ? reinterpret_cast<const uint32_t*>(file.data() + r->order_offset) : nullptr;
+    }
+
+    precision_t DatasetFile::min(size_t feature) const
+    {
+        return static_cast<const ColumnRecord*>(record(feature))->min;
+    }
+
+    precision_t DatasetFile::max(size_t feature) const
+    {
+        return static_cast<const ColumnRecord*>(record(feature))->max;
+    }
+
+    samples_t DatasetFile::getColumn(size_t feature) const
+    {
+        const auto* values = column(feature);
+        return samples_t(values, values + n_samples);
+    }
+
+    labels_t DatasetFile::getLabels() const
+    {
+        return labels_t(labels_, labels_ + n_samples);
+    }
+
+    indices_t DatasetFile::getOrder(size_t feature) const
+    {
+        const auto* positions = order(feature);
+        if (positions == nullptr) {
+            throw InvalidParameter("Dataset file holds no sort orders; save it with with_order");
+        }
+        return indices_t(positions, positions + n_samples);
+    }
+
+    void DatasetFile::fit(CPPFImdlp& model, size_t feature) const
+    {
+        const auto* positions = order(feature);
+        if (positions == nullptr) {
+            throw InvalidParameter("Dataset file holds no sort orders; save it with with_order");
+        }
+        model.fit(getColumn(feature), getLabels(), positions, n_samples, min(feature), max(feature));
+    }
+
+    Dataset DatasetFile::toDataset() const
+    {
+        Dataset dataset;
+        dataset.attributes = attributes_;
+        for (size_t j = 0; j < attributes_.size(); ++j) {
+            dataset.X.push_back(getColumn(j));
+        }
+        dataset.y = getLabels();
+        dataset.class_name = class_name;
+        dataset.class_type = class_type;
+        dataset.class_values = class_values;
+        return dataset;
+    }
+}
@@ -0,0 +1,184 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_DATASETCACHE_H
+#define MDLP_DATASETCACHE_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "typesFImdlp.h"
+#include "Executor.h"
+#include "Loader.h"
+#include "MappedFile.h"
+
+namespace mdlp {
+
+    class CPPFImdlp;
+
+    /**
+     * @brief Version of the on-disk dataset format written by save_dataset()
+     *
+     * Bumped on any layout change; DatasetFile::open() rejects the others.
+     */
+    inline constexpr uint32_t DATASET_FORMAT_VERSION = 1;
+
+    /**
+     * @brief Write a dataset to one binary columnar file
+     * @param path Destination; replaced if it exists
+     * @param dataset Columns, labels and names, as load_arff() gives them
+     * @param with_order Also store, per column, the order CPPFImdlp::fit()
+     *        sorts it into, so later fits skip the sort
+     * @param executor Sorts the columns when with_order; see ThreadPool
+     * @throws ValidationError, naming the column, if the columns, names and
+     *         labels differ in length or a value is not finite; also with
+     *         with_order for 2^32 samples or more
+     * @throws IOError if the file cannot be written
+     *
+     * Meant to be written once per dataset and opened by every later run, so
+     * they neither parse the text again nor, with the order stored, sort. The
+     * file is replaced with replace_file(), like save_models().
+     *
+     * ## Layout
+     *
+     * Integers and floats in host byte order; a tag in the header makes a file
+     * from a machine of the other endianness fail open() cleanly. Every array
+     * starts on a 64-byte boundary.
+     *
+     * | Section | Size |
+     * |---|---|
+     * | header: magic, version, endian tag, counts, offsets, file size | 72 bytes |
+     * | one record per feature: column and order offsets, min, max | 24 bytes each |
+     * | names: attributes, class, class values, each a length and the bytes | variable |
+     * | labels | 4 bytes per sample |
+     * | each column | 4 bytes per sample |
+     * | each order, when stored | 4 bytes per sample |
+     */
+    void save_dataset(const std::string& path, const Dataset& dataset, bool with_order, Executor& executor);
+
+    /**
+     * @brief Write a dataset, sorting the columns on several threads
+     * @param n_threads Threads to use, the caller's included; 0 means one per
+     *        hardware thread. Used only when with_order
+     *
+     * Same file and exceptions as the Executor overload.
+     */
+    void save_dataset(const std::string& path, const Dataset& dataset, bool with_order = true, size_t n_threads = 0);
+
+    /**
+     * @brief A dataset file written by save_dataset(), mapped into memory
+     *
+     * Opening maps the file, checks its structure and reads the names; the
+     * columns, labels and orders are read in place from the mapping, never
+     * parsed, so a dataset of any size opens in the time the names take.
+     *
+     * @code
+     * save_dataset("letter.fimdlp", load_arff("letter.arff"));
+     * // ...in every later run:
+     * auto cached = DatasetFile::open("letter.fimdlp");
+     * CPPFImdlp disc;
+     * cached.fit(disc, 0);
+     * @endcode
+     *
+     * What fit() still copies: the column and the labels, once each, into the
+     * model, which keeps its own; and the order, widened once to size_t as it
+     * is checked, into the positions the model searches. Metrics then copies
+     * the labels and positions, as in every CPPFImdlp fit. Nothing is sorted
+     * and the column is not scanned for its range.
+     *
+     * @note Structure is validated, contents are not: CPPFImdlp checks a
+     *       stored order and range before using them, but labels and values
+     *       are taken as they are.
+     */
+    class DatasetFile {
+    public:
+        /**
+         * @brief Map and validate a dataset file
+         * @throws IOError if the file cannot be opened or mapped
+         * @throws ValidationError if it is not a dataset file, is truncated,
+         *         was written with another format version or on a machine of
+         *         the other endianness, or holds an array outside the file
+         */
+        static DatasetFile open(const std::string& path);
+
+        /** @brief Number of samples */
+        inline size_t size() const { return n_samples; };
+        /** @brief Number of feature columns */
+        inline size_t features() const { return attributes_.size(); };
+        /** @brief Whether the file holds a sort order for every column */
+        inline bool hasOrder() const { return has_order; };
+
+        inline const std::vector<std::pair<std::string, std::string>>& attributes() const { return attributes_; };
+        inline const std::string& className() const { return class_name; };
+        inline const std::string& classType() const { return class_type; };
+        inline const std::vector<std::string>& classValues() const { return class_values; };
+
+        /**
+         * @brief A column's size() values, in the mapped file
+         * @throws IndexError if feature is out of range
+         */
+        const precision_t* column(size_t feature) const;
+        /** @brief The labels, size() of them, in the mapped file */
+        inline const label_t* labels() const { return labels_; };
+        /**
+         * @brief A column's sort order, size() positions, in the mapped file
+         * @return nullptr when the file holds no orders
+         * @throws IndexError if feature is out of range
+         */
+        const uint32_t* order(size_t feature) const;
+        /**
+         * @brief Smallest value of a column, stored when it was saved
+         * @throws IndexError if feature is out of range
+         */
+        precision_t min(size_t feature) const;
+        /**
+         * @brief Largest value of a column, stored when it was saved
+         * @throws IndexError if feature is out of range
+         */
+        precision_t max(size_t feature) const;
+
+        /**
+         * @brief Copy of a column, for the discretizers' fit()
+         * @throws IndexError if feature is out of range
+         */
+        samples_t getColumn(size_t feature) const;
+        /** @brief Copy of the labels */
+        labels_t getLabels() const;
+        /**
+         * @brief Copy of a column's sort order, widened to size_t
+         * @throws InvalidParameter if the file holds no orders
+         * @throws IndexError if feature is out of range
+         *
+         * For a fit, fit() reads the stored order in place instead.
+         */
+        indices_t getOrder(size_t feature) const;
+        /**
+         * @brief Fit a CPPFImdlp on a column, from its stored order and range
+         * @throws InvalidParameter if the file holds no orders
+         * @throws IndexError if feature is out of range
+         * @throws ValidationError if the stored order or range is not the
+         *         column's, as from CPPFImdlp::fit()
+         */
+        void fit(CPPFImdlp& model, size_t feature) const;
+        /** @brief Copy of everything, as load_arff() would have returned it */
+        Dataset toDataset() const;
+
+    private:
+        DatasetFile() = default;
+        const void* record(size_t feature) const;
+        MappedFile file;
+        size_t n_samples = 0;
+        bool has_order = false;
+        const void* records = nullptr;
+        const label_t* labels_ = nullptr;
+        std::vector<std::pair<std::string, std::string>> attributes_;
+        std::string class_name;
+        std::string class_type;
+        std::vector<std::string> class_values;
+    };
+}
+#endif
@@ -4,136 +4,236 @@
 // SPDX - License - Identifier: MIT
 // ****************************************************************
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include "Discretizer.h"
+#include "TransformKernel.h"
+#include "Trace.h"
 
 namespace mdlp {
 
-    void Discretizer::validate_finite(const samples_t& data)
-    {
+    namespace {
         // Branch-free reduction so the compiler can vectorize the common case.
         // The obvious version — test and throw per element — cost 14% on
         // CPPFImdlp::fit and 16% on BinDisc::fit, because the throw inside the
         // loop blocks vectorization. Locating the offender is left to a second
         // pass that only runs when there is one.
-        bool all_finite = true;
-        for (const precision_t value : data) {
-            all_finite &= std::isfinite(value);
+        bool all_finite(const precision_t* data, size_t n)
+        {
+            bool finite = true;
+            for (size_t i = 0; i < n; ++i) {
+                finite &= std::isfinite(data[i]);
+            }
+            return finite;
+        }
+
+        // Independent accumulators per lane, so the loop vectorizes: the
+        // single-accumulator version compiles to scalar code and ran at a third
+        // of the speed. A NaN leaves min and max unspecified; it fails the
+        // finite check, and the caller throws before using them.
+        struct Summary {
+            precision_t min;
+            precision_t max;
+            bool finite;
+            bool sorted;
+        };
+        Summary summarize_lanes(const precision_t* x, size_t n)
+        {
+            constexpr size_t lanes = 16;
+            constexpr precision_t largest = std::numeric_limits<precision_t>::max();
+            precision_t lo[lanes];
+            precision_t hi[lanes];
+            int bad[lanes];
+            int unsorted[lanes];
+            for (size_t k = 0; k < lanes; ++k) {
+                lo[k] = hi[k] = x[0];
+                bad[k] = unsorted[k] = 0;
+            }
+            // |v| <= max is false for both infinities and NaN.
+            const auto step = [&](size_t k, size_t i) {
+                const precision_t v = x[i];
+                bad[k] |= !(std::fabs(v) <= largest);
+                unsorted[k] |= !(x[i - 1] <= v);
+                lo[k] = v < lo[k] ? v : lo[k];
+                hi[k] = v > hi[k] ? v : hi[k];
+            };
+            size_t i = 1;
+            for (; i + lanes <= n; i += lanes) {
+                for (size_t k = 0; k < lanes; ++k) {
+                    step(k, i + k);
+                }
+            }
+            for (; i < n; ++i) {
+                step(0, i);
+            }
+            Summary s{ x[0], x[0], std::fabs(x[0]) <= largest, true };
+            for (size_t k = 0; k < lanes; ++k) {
+                s.min = lo[k] < s.min ? lo[k] : s.min;
+                s.max = hi[k] > s.max ? hi[k] : s.max;
+                s.finite = s.finite && !bad[k];
+                s.sorted = s.sorted && !unsorted[k];
+            }
+            return s;
         }
-        if (all_finite) {
+    }
+
+    void Discretizer::validate_finite(const samples_t& data)
+    {
+        validate_finite(data.data(), data.size(), 0);
+    }
+    void Discretizer::validate_finite(const precision_t* data, size_t n, size_t first_index)
+    {
+        if (all_finite(data, n)) {
             return;
         }
-        for (size_t i = 0; i < data.size(); ++i) {
+        for (size_t i = 0; i < n; ++i) {
             if (!std::isfinite(data[i])) {
-                throw ValidationError("Sample at index " + std::to_string(i)
+                throw ValidationError("Sample at index " + std::to_string(first_index + i)
                     + " is not a finite number: " + detail::str(data[i]));
             }
         }
     }
 
-    void Discretizer::transform(const samples_t& data, labels_t& out) const
+    ColumnSummary Discretizer::summarize(const samples_t& data)
     {
-        // Input validation
         if (data.empty()) {
-            throw ValidationError("Data for transformation cannot be empty");
+            return {};
         }
-        validate_finite(data);
-        if (cutPoints.size() < 2) {
-            throw NotFittedError("Discretizer not fitted yet or no valid cut points found");
+        const auto s = summarize_lanes(data.data(), data.size());
+        if (!s.finite) {
+            validate_finite(data);  // names the first offender
         }
+        return { data.size(), s.min, s.max, s.sorted };
+    }
 
-        out.clear();
-        out.reserve(data.size());
-        // CutPoints always have at least two items
-        // Have to ignore first and last cut points provided
-        auto first = cutPoints.begin() + 1;
-        auto last = cutPoints.end() - 1;
-        auto bound = direction == bound_dir_t::LEFT ? std::lower_bound<std::vector<precision_t>::const_iterator, precision_t> : std::upper_bound<std::vector<precision_t>::const_iterator, precision_t>;
-        for (const precision_t& item : data) {
-            auto pos = bound(first, last, item);
-            auto number = pos - first;
-            out.push_back(static_cast<label_t>(number));
+    void Discretizer::transform(const samples_t& data, labels_t& out) const
+    {
+        MDLP_TRACE_SCOPE("transform");
+        validate_transform_input(data, cutPoints.size());
+        // Reuses the buffer when it already has the size; bin() writes every
+        // element.
+        out.resize(data.size());
+        bin(data.data(), data.size(), out.data());
+    }
+    void Discretizer::transform(const samples_t& data, labels_t& out, size_t n_threads) const
+    {
+        if (n_threads == 1 || data.size() <= transform_chunk) {
+            transform(data, out);
+            return;
         }
+        ThreadPool pool(n_threads);
+        transform(data, out, pool);
     }
-    labels_t& Discretizer::transform(const samples_t& data)
+    void Discretizer::transform(const samples_t& data, labels_t& out, Executor& executor) const
     {
-        transform(data, discretizedData);
-        return discretizedData;
+        MDLP_TRACE_SCOPE("transform");
+        if (data.empty() || cutPoints.size() < 2) {
+            // Throws, in the order the serial checks run.
+            validate_transform_input(data, cutPoints.size());
+        }
+        const size_t n = data.size();
+        // Binned into a buffer of its own: chunks bin before the others are
+        // checked, and out must be left as it was when one of them throws.
+        labels_t labels(n);
+        std::atomic<bool> finite{ true };
+        executor.run((n + transform_chunk - 1) / transform_chunk, [&](size_t chunk) {
+            const size_t begin = chunk * transform_chunk;
+            const size_t count = std::min(transform_chunk, n - begin);
+            MDLP_TRACE_SCOPE_RANGE("transform chunk", begin, begin + count);
+            if (!all_finite(data.data() + begin, count)) {
+                finite.store(false, std::memory_order_relaxed);
+                return;
+            }
+            bin(data.data() + begin, count, labels.data() + begin);
+            });
+        if (!finite.load()) {
+            // Chunks finish in any order; this names the first offender.
+            validate_finite(data);
+        }
+        out.swap(labels);
     }
-    void Discretizer::fit(samples_t&& X_, labels_t&& y_)
+    template <typename T>
+    void Discretizer::transform_narrow(const samples_t& data, std::vector<T>& out, const char* type_name) const
     {
-        // Default: no move-specific handling. Named rvalue references are
-        // lvalues, so this binds to the copying overload.
-        fit(X_, y_);
+        MDLP_TRACE_SCOPE("transform");
+        validate_transform_input(data, cutPoints.size());
+        constexpr size_t max_bins = size_t{ std::numeric_limits<T>::max() } + 1;
+        if (getBins() > max_bins) {
+            throw InvalidParameter("Model has " + std::to_string(getBins()) + " bins; "
+                + type_name + " labels hold at most " + std::to_string(max_bins));
+        }
+        out.resize(data.size());
+        // Binned a chunk at a time into a label_t buffer that stays in cache,
+        // and narrowed from it, so the kernels need no variant per label type.
+        labels_t labels(std::min(data.size(), transform_chunk));
+        for (size_t begin = 0; begin < data.size(); begin += transform_chunk) {
+            const size_t count = std::min(transform_chunk, data.size() - begin);
+            bin(data.data() + begin, count, labels.data());
+            std::copy(labels.begin(), labels.begin() + count, out.begin() + begin);
+        }
     }
-    labels_t& Discretizer::fit_transform(samples_t& X_, labels_t& y_)
+    void Discretizer::transform(const samples_t& data, std::vector<uint8_t>& out) const
     {
-        fit(X_, y_);
-        return transform(X_);
+        transform_narrow(data, out, "uint8_t");
     }
-    torch::Tensor Discretizer::validate_tensor(
-        const torch::Tensor& t,
-        torch::ScalarType expected_type,
-        const std::string& name,
-        const std::string& type_name,
-        const std::string& empty_message)
+    void Discretizer::transform(const samples_t& data, std::vector<uint16_t>& out) const
     {
-        if (t.dim() != 1) {
-            throw ValidationError("Only 1D tensors supported");
-        }
-        if (!t.is_cpu()) {
-            throw ValidationError(name + " tensor must reside on the CPU"); // LCOV_EXCL_LINE
+        transform_narrow(data, out, "uint16_t");
+    }
+    void Discretizer::transform(const samples_t& data, PackedLabels& out) const
+    {
+        MDLP_TRACE_SCOPE("transform");
+        validate_transform_input(data, cutPoints.size());
+        out.reset(getBins(), data.size());
+        // Whole words per chunk, so every chunk starts at the first label of one.
+        const size_t chunk = transform_chunk / out.per_word() * out.per_word();
+        labels_t labels(std::min(data.size(), chunk));
+        for (size_t begin = 0; begin < data.size(); begin += chunk) {
+            const size_t count = std::min(chunk, data.size() - begin);
+            bin(data.data() + begin, count, labels.data());
+            out.pack_words(begin / out.per_word(), labels.data(), count);
         }
-        if (t.scalar_type() != expected_type) {
-            throw ValidationError(name + " tensor must be " + type_name + " type");
+    }
+    void Discretizer::transform(const precision_t* cuts, size_t n_cuts, bound_dir_t direction_,
+        const samples_t& data, labels_t& out)
+    {
+        validate_transform_input(data, n_cuts);
+        out.resize(data.size());
+        // CutPoints always have at least two items
+        // Have to ignore first and last cut points provided
+        detail::bin_samples(cuts + 1, n_cuts - 2, direction_, data.data(), data.size(), out.data());
+    }
+    void Discretizer::validate_transform_input(const samples_t& data, size_t n_cuts)
+    {
+        if (data.empty()) {
+            throw ValidationError("Data for transformation cannot be empty");
         }
-        if (t.numel() == 0) {
-            throw ValidationError(empty_message);
+        validate_finite(data);
+        if (n_cuts < 2) {
+            throw NotFittedError("Discretizer not fitted yet or no valid cut points found");
         }
-        // Accept non-contiguous inputs. A column view of a 2-D dataset has a
-        // stride greater than one, so walking data_ptr() + numel() would read
-        // unrelated memory and silently produce wrong cut points. contiguous()
-        // returns the tensor unchanged when it is already contiguous, so the
-        // common case costs nothing. The caller must keep the returned tensor
-        // alive while it reads through data_ptr().
-        return t.contiguous();
     }
-
-    std::pair<torch::Tensor, torch::Tensor> Discretizer::validate_pair(
-        const torch::Tensor& X_,
-        const torch::Tensor& y_)
-    {
-        auto X_valid = validate_tensor(X_, torch::kFloat32, "X", "Float32", "Tensors cannot be empty");
-        auto y_valid = validate_tensor(y_, torch::kInt32, "y", "Int32", "Tensors cannot be empty");
-        if (X_valid.numel() != y_valid.numel()) {
-            throw ValidationError("X and y tensors must have same number of elements");
-        }
-        return { X_valid, y_valid };
+    void Discretizer::bin(const precision_t* data, size_t n, label_t* out) const
+    {
+        detail::bin_samples(cutPoints.data() + 1, cutPoints.size() - 2, direction, data, n, out);
     }
-
-    void Discretizer::fit_t(const torch::Tensor& X_, const torch::Tensor& y_)
+    labels_t& Discretizer::transform(const samples_t& data)
     {
-        auto [X_valid, y_valid] = validate_pair(X_, y_);
-        auto num_elements = X_valid.numel();
-        samples_t X(X_valid.data_ptr<precision_t>(), X_valid.data_ptr<precision_t>() + num_elements);
-        labels_t y(y_valid.data_ptr<int>(), y_valid.data_ptr<int>() + num_elements);
-        fit(X, y);
+        transform(data, discretizedData);
+        return discretizedData;
     }
-    torch::Tensor Discretizer::transform_t(const torch::Tensor& X_)
+    void Discretizer::fit(samples_t&& X_, labels_t&& y_)
     {
-        auto X_valid = validate_tensor(X_, torch::kFloat32, "X", "Float32", "Tensor cannot be empty");
-        auto num_elements = X_valid.numel();
-        samples_t X(X_valid.data_ptr<precision_t>(), X_valid.data_ptr<precision_t>() + num_elements);
-        auto result = transform(X);
-        return torch::tensor(result, torch_label_t);
+        // Default: no move-specific handling. Named rvalue references are
+        // lvalues, so this binds to the copying overload.
+        fit(X_, y_);
     }
-    torch::Tensor Discretizer::fit_transform_t(const torch::Tensor& X_, const torch::Tensor& y_)
+    labels_t& Discretizer::fit_transform(samples_t& X_, labels_t& y_)
     {
-        auto [X_valid, y_valid] = validate_pair(X_, y_);
-        auto num_elements = X_valid.numel();
-        samples_t X(X_valid.data_ptr<precision_t>(), X_valid.data_ptr<precision_t>() + num_elements);
-        labels_t y(y_valid.data_ptr<int>(), y_valid.data_ptr<int>() + num_elements);
-        auto result = fit_transform(X, y);
-        return torch::tensor(result, torch_label_t);
+        fit(X_, y_);
+        return transform(X_);
     }
-}
\ No newline at end of file
+}
@@ -10,16 +10,13 @@
 #include <string>
 #include <algorithm>
 #include "typesFImdlp.h"
-#include <torch/torch.h>
 #include "config.h"
 #include "Exceptions.h"
+#include "Executor.h"
+#include "FitStats.h"
+#include "PackedLabels.h"
 
 namespace mdlp {
-    enum class bound_dir_t {
-        LEFT,
-        RIGHT
-    };
-    const auto torch_label_t = torch::kInt32;
 
     /**
      * @brief Abstract base class for all discretization algorithms
@@ -61,10 +58,10 @@ namespace mdlp {
      * bin_disc.fit(X, y);  // y is ignored
      * auto result2 = bin_disc.transform(X);
      * 
-     * // PyTorch tensor support
+     * // PyTorch tensor support, with fimdlp_torch and DiscretizerTorch.h
      * auto X_torch = torch::tensor(X, torch::kFloat32);
      * auto y_torch = torch::tensor(y, torch::kInt32);
-     * auto result3 = mdlp_disc.fit_transform_t(X_torch, y_torch);
+     * auto result3 = fit_transform_t(mdlp_disc, X_torch, y_torch);
      * @endcode
      */
     class Discretizer {
@@ -78,6 +75,30 @@ namespace mdlp {
          */
         inline cutPoints_t getCutPoints() const { return cutPoints; };
 
+        /**
+         * @brief Get the bound direction transform() applies at a cut point
+         * @return RIGHT if a value equal to a cut point goes to the upper bin
+         */
+        inline bound_dir_t getBoundDirection() const { return direction; };
+        /**
+         * @brief Number of bins transform() labels into; 0 before fit
+         */
+        inline size_t getBins() const { return cutPoints.size() < 2 ? 0 : cutPoints.size() - 1; };
+
+        /**
+         * @brief Collect FitStats in the fits that follow; off by default
+         *
+         * Off, a fit neither reads the clock nor counts anything: every
+         * instrumented step tests one pointer, once per call and never per
+         * sample. CPPFImdlp and BinDisc (with PKIDisc) collect.
+         */
+        inline void collectFitStats(bool collect) { collect_stats = collect; };
+        inline bool collectsFitStats() const { return collect_stats; };
+        /**
+         * @brief Statistics of the last fit; all zero unless it collected them
+         */
+        inline const FitStats& getFitStats() const { return fit_stats; };
+
         /**
          * @brief Fit the discretizer to data (pure virtual)
          * @param X_ Input samples (continuous values)
@@ -134,52 +155,85 @@ namespace mdlp {
         void transform(const samples_t& data, labels_t& out) const;
 
         /**
-         * @brief Fit and transform in a single call
-         * @param X_ Input samples
-         * @param y_ Labels (required for interface consistency)
-         * @return Discretized labels
+         * @brief Transform data on several threads
+         * @param data Input samples to discretize
+         * @param out Destination; cleared and resized to match data
+         * @param n_threads Threads to use, the caller's included; 0 means one per
+         *        hardware thread
+         *
+         * Same labels and same exceptions as the two-argument overload. Starts a
+         * ThreadPool for the call, and skips it when data fits in one chunk;
+         * pass an Executor instead when calling repeatedly.
          */
-        labels_t& fit_transform(samples_t& X_, labels_t& y_);
+        void transform(const samples_t& data, labels_t& out, size_t n_threads) const;
 
         /**
-         * @brief Fit the discretizer using PyTorch tensors
-         * @param X_ Input tensor (Float32, 1D, CPU)
-         * @param y_ Labels tensor (Int32, 1D, CPU)
-         * @throws ValidationError (also a `std::invalid_argument`) if a tensor is
-         *         not 1D, not on the CPU, has the wrong dtype, is empty, or if
-         *         sizes do not match
+         * @brief Transform data on an executor
+         * @param data Input samples to discretize
+         * @param out Destination; replaced by the labels, and left untouched when
+         *        an exception is thrown, as by the two-argument overload
+         * @param executor Runs the chunks; see ThreadPool
          *
-         * @note Non-contiguous tensors are accepted. A column view of a 2-D
-         *       dataset (e.g. `dataset.select(1, col)`) is not contiguous, and
-         *       this is the most natural way to feed one feature at a time, so
-         *       such inputs are copied into contiguous storage rather than
-         *       rejected. The copy is only made when the input is not already
-         *       contiguous.
+         * The input is split into chunks of transform_chunk samples, each checked
+         * for non-finite values and binned as one task into its own range of a
+         * new buffer, so the threads share no writes; the buffer is swapped into
+         * out once every chunk has passed. If any chunk holds a non-finite value,
+         * the serial check then runs to report the first one, so the message is
+         * the one the two-argument overload gives. Unlike that overload, out's
+         * old storage is not reused.
          */
-        void fit_t(const torch::Tensor& X_, const torch::Tensor& y_);
+        void transform(const samples_t& data, labels_t& out, Executor& executor) const;
 
         /**
-         * @brief Transform PyTorch tensor using previously computed cut points
-         * @param X_ Input tensor (Float32, 1D, CPU)
-         * @return Discretized tensor (Int32)
-         * @throws ValidationError (also a `std::invalid_argument`) if X_ is not 1D,
-         *         not on the CPU, has the wrong dtype, or is empty
+         * @brief Transform data into 8-bit labels
+         * @param data Input samples to discretize
+         * @param out Destination; cleared and resized to match data
+         * @throws InvalidParameter if the model has more than 256 bins
          *
-         * @note Non-contiguous tensors are accepted; see fit_t().
+         * Same labels, checks and messages as the labels_t overload, in a
+         * quarter of the memory.
+         */
+        void transform(const samples_t& data, std::vector<uint8_t>& out) const;
+
+        /**
+         * @brief Transform data into 16-bit labels
+         * @throws InvalidParameter if the model has more than 65536 bins
+         * @see transform(const samples_t&, std::vector<uint8_t>&) const
+         */
+        void transform(const samples_t& data, std::vector<uint16_t>& out) const;
+
+        /**
+         * @brief Transform data into labels of getBins() bits each; see PackedLabels
+         * @param data Input samples to discretize
+         * @param out Destination; replaced
          */
-        torch::Tensor transform_t(const torch::Tensor& X_);
+        void transform(const samples_t& data, PackedLabels& out) const;
 
         /**
-         * @brief Fit and transform PyTorch tensors in a single call
-         * @param X_ Input tensor (Float32, 1D, CPU)
-         * @param y_ Labels tensor (Int32, 1D, CPU)
-         * @return Discretized tensor (Int32)
-         * @throws ValidationError (also a `std::invalid_argument`) under the same
-         *         conditions as fit_t()
+         * @brief Discretize against an explicit array of cut points
+         * @param cuts First of n_cuts ascending cut points; the first and the last
+         *        are ignored, exactly as in a fitted model's getCutPoints()
+         * @param n_cuts Number of cut points; at least two
+         * @param direction Which bin a value equal to a cut point goes to
+         * @param data Input samples to discretize
+         * @param out Destination; cleared and resized to match data
+         * @throws ValidationError if data is empty or holds a non-finite value
+         * @throws NotFittedError if fewer than two cut points are given
          *
-         * @note Non-contiguous tensors are accepted; see fit_t().
+         * The body of transform(), exposed so that cut points which do not live in
+         * a Discretizer — a model mapped from disk, see Serialization.h — are
+         * binned by the same code and give the same labels.
          */
-        torch::Tensor fit_transform_t(const torch::Tensor& X_, const torch::Tensor& y_);
+        static void transform(const precision_t* cuts, size_t n_cuts, bound_dir_t direction,
+            const samples_t& data, labels_t& out);
+
+        /**
+         * @brief Fit and transform in a single call
+         * @param X_ Input samples
+         * @param y_ Labels (required for interface consistency)
+         * @return Discretized labels
+         */
+        labels_t& fit_transform(samples_t& X_, labels_t& y_);
 
         /**
          * @brief Get the library version
@@ -201,39 +255,86 @@ namespace mdlp {
          */
         static void validate_finite(const samples_t& data);
 
+        /**
+         * @brief Reject non-finite samples and collect what fit() needs, in one pass
+         * @param data Samples to check
+         * @return Count, min, max and whether data is already sorted; all zero
+         *         and sorted for empty data
+         * @throws ValidationError naming the index and value of the first
+         *         non-finite sample, as validate_finite() does
+         *
+         * A fit used to read its input once to validate it and again for
+         * minmax_element, which does not vectorize. This reads it once, sixteen
+         * lanes at a time, and the sortedness flag lets a fit skip its sort.
+         */
+        static ColumnSummary summarize(const samples_t& data);
+
+        /**
+         * @brief Label n samples with the fitted cut points
+         * @param data First of n finite samples
+         * @param n Number of samples
+         * @param out First of n labels to write
+         *
+         * The binning step of transform(), called after its checks, so an
+         * override may assume a fitted model and finite input. Overridden by a
+         * discretizer that knows a faster way to bin its own cut points; it must
+         * give the labels this default gives.
+         */
+        virtual void bin(const precision_t* data, size_t n, label_t* out) const;
+
+        /**
+         * @brief Zero the statistics at the start of a fit
+         * @return Where the fit records them, or nullptr when collection is off
+         */
+        inline FitStats* start_fit_stats()
+        {
+            fit_stats = FitStats();
+            return fit_stats_ptr();
+        }
+        /** @brief Where a fit under way records its statistics; nullptr when off */
+        inline FitStats* fit_stats_ptr() { return collect_stats ? &fit_stats : nullptr; }
+
+        // Samples per task in the parallel transform: 256 KiB of input and as
+        // much output, which stays within a core's L2 cache while it is binned.
+        static constexpr size_t transform_chunk = size_t{ 1 } << 16;
+
         labels_t discretizedData = labels_t();
         cutPoints_t cutPoints; // At least two cutpoints must be provided, the first and the last will be ignored in transform
         // Used in transform. Must have an initializer: a default-constructed
         // CPPFImdlp never assigns it, and transform() would otherwise branch on
         // an indeterminate value.
         bound_dir_t direction = bound_dir_t::RIGHT;
+        FitStats fit_stats;
+        bool collect_stats = false;
 
     private:
+        friend class ColumnDiscretizer;
+        // transform_t() of DiscretizerTorch.h bins as transform() does.
+        friend struct TensorAccess;
+
         /**
-         * @brief Validate a 1-D CPU tensor and return a contiguous equivalent
-         * @param t Tensor to validate
-         * @param expected_type Required scalar type
-         * @param name Tensor name used in error messages ("X" or "y")
-         * @param type_name Human-readable type name used in error messages
-         * @param empty_message Message thrown when the tensor has no elements
-         * @return A contiguous tensor; the input itself when already contiguous
-         * @throws ValidationError (also a `std::invalid_argument`) if any check fails
-         */
-        static torch::Tensor validate_tensor(
-            const torch::Tensor& t,
-            torch::ScalarType expected_type,
-            const std::string& name,
-            const std::string& type_name,
-            const std::string& empty_message);
-
-        /**
-         * @brief Validate an (X, y) tensor pair and return contiguous equivalents
-         * @throws ValidationError (also a `std::invalid_argument`) if either tensor is
-         *         invalid or the sizes differ
-         */
-        static std::pair<torch::Tensor, torch::Tensor> validate_pair(
-            const torch::Tensor& X_,
-            const torch::Tensor& y_);
+         * @brief The checks every transform() makes before binning
+         * @throws ValidationError if data is empty or holds a non-finite value
+         * @throws NotFittedError if there are fewer than two cut points
+         */
+        static void validate_transform_input(const samples_t& data, size_t n_cuts);
+
+        /**
+         * @brief transform() into a narrower unsigned label type
+         * @param type_name Name of T for the error message
+         */
+        template <typename T>
+        void transform_narrow(const samples_t& data, std::vector<T>& out, const char* type_name) const;
+
+        /**
+         * @brief Reject samples that are not finite
+         * @param data First of n samples to check
+         * @param n Number of samples
+         * @param first_index Index of data[0] in the caller's input, so that a
+         *        chunk names its offender by its position in the whole input
+         * @throws ValidationError naming the index and value of the first offender
+         */
+        static void validate_finite(const precision_t* data, size_t n, size_t first_index);
     };
 }
 #endif
@@ -111,6 +111,11 @@ namespace mdlp {
         int n_bins = 3;
         /** @brief Equal width or equal frequency */
         strategy_t strategy = strategy_t::UNIFORM;
+        /**
+         * @brief Rank error of a streaming QUANTILE fit, in (0, 0.5]
+         * @see BinDisc::partial_fit(), QuantileSketch
+         */
+        double sketch_error = 0.01;
 
         BinDiscConfig withNBins(int value) const
         {
@@ -126,6 +131,13 @@ namespace mdlp {
             return copy;
         }
 
+        BinDiscConfig withSketchError(double value) const
+        {
+            auto copy = *this;
+            copy.sketch_error = value;
+            return copy;
+        }
+
         /**
          * @brief Reject an invalid combination before it reaches a constructor
          * @throws InvalidParameter with the same message the constructor would give
@@ -135,6 +147,9 @@ namespace mdlp {
             if (n_bins < MIN_BINS) {
                 throw InvalidParameter("n_bins must be at least " + std::to_string(MIN_BINS) + ", got " + std::to_string(n_bins));
             }
+            if (!(sketch_error > 0 && sketch_error <= 0.5)) {
+                throw InvalidParameter("sketch_error must be in (0, 0.5], got " + detail::str(sketch_error));
+            }
         }
     };
 
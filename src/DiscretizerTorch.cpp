@@ -0,0 +1,156 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+// The tensor entry points of DiscretizerTorch.h, built into fimdlp_torch only,
+// so that fimdlp_core neither includes nor links libtorch.
+
+#ifndef MDLP_WITH_TORCH
+#error "DiscretizerTorch.cpp belongs to fimdlp_torch, which defines MDLP_WITH_TORCH"
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include "DiscretizerTorch.h"
+
+namespace mdlp {
+
+    namespace {
+        // Reads count elements of a 1-D tensor from index begin, converting
+        // each to U. Follows stride(0), so a column view of a 2-D dataset is
+        // read where it lies instead of being made contiguous first.
+        template <typename T, typename U>
+        void gather_as(const torch::Tensor& t, size_t begin, size_t count, U* dst)
+        {
+            const T* src = t.data_ptr<T>();
+            const int64_t stride = t.stride(0);
+            for (size_t i = 0; i < count; ++i) {
+                dst[i] = static_cast<U>(src[static_cast<int64_t>(begin + i) * stride]);
+            }
+        }
+    }
+
+    namespace detail {
+        void validate_tensor(
+            const torch::Tensor& t,
+            torch::ScalarType narrow_type,
+            torch::ScalarType wide_type,
+            const std::string& name,
+            const std::string& type_names,
+            const std::string& empty_message)
+        {
+            if (t.dim() != 1) {
+                throw ValidationError("Only 1D tensors supported");
+            }
+            if (!t.is_cpu()) {
+                throw ValidationError(name + " tensor must reside on the CPU"); // LCOV_EXCL_LINE
+            }
+            if (t.scalar_type() != narrow_type && t.scalar_type() != wide_type) {
+                throw ValidationError(name + " tensor must be " + type_names + " type");
+            }
+            if (t.numel() == 0) {
+                throw ValidationError(empty_message);
+            }
+        }
+        void validate_pair(const torch::Tensor& X_, const torch::Tensor& y_)
+        {
+            validate_tensor(X_, torch::kFloat32, torch::kFloat64, "X", "Float32 or Float64", "Tensors cannot be empty");
+            validate_tensor(y_, torch::kInt32, torch::kInt64, "y", "Int32 or Int64", "Tensors cannot be empty");
+            if (X_.numel() != y_.numel()) {
+                throw ValidationError("X and y tensors must have same number of elements");
+            }
+        }
+        void read_samples(const torch::Tensor& X_, size_t begin, size_t count, precision_t* dst)
+        {
+            // A double beyond the range of float becomes an infinity, which the
+            // finite check then rejects.
+            if (X_.scalar_type() == torch::kFloat64) {
+                gather_as<double>(X_, begin, count, dst);
+            } else {
+                gather_as<float>(X_, begin, count, dst);
+            }
+        }
+        void read_labels(const torch::Tensor& y_, label_t* dst)
+        {
+            const auto n = static_cast<size_t>(y_.numel());
+            if (y_.scalar_type() == torch::kInt32) {
+                gather_as<int32_t>(y_, 0, n, dst);
+                return;
+            }
+            // Truncating an Int64 label would silently merge two classes.
+            const int64_t* src = y_.data_ptr<int64_t>();
+            const int64_t stride = y_.stride(0);
+            for (size_t i = 0; i < n; ++i) {
+                const int64_t label = src[static_cast<int64_t>(i) * stride];
+                if (label < std::numeric_limits<label_t>::min() || label > std::numeric_limits<label_t>::max()) {
+                    throw ValidationError("Label at index " + std::to_string(i)
+                        + " does not fit in 32 bits: " + std::to_string(label));
+                }
+                dst[i] = static_cast<label_t>(label);
+            }
+        }
+    }
+
+    // Holds transform_t()'s access to the protected and private members that
+    // transform() uses; Discretizer names it a friend.
+    struct TensorAccess {
+        static void transform_into(const Discretizer& disc, const torch::Tensor& X_, label_t* out)
+        {
+            const auto n = static_cast<size_t>(X_.numel());
+            if (disc.cutPoints.size() < 2) {
+                // Throws, in the order the vector checks run: a non-finite sample
+                // is reported before the missing fit.
+                samples_t X(n);
+                detail::read_samples(X_, 0, n, X.data());
+                Discretizer::validate_transform_input(X, disc.cutPoints.size());
+            }
+            // A contiguous Float32 tensor is the layout bin() reads, so it is
+            // binned where it lies.
+            if (X_.scalar_type() == torch::kFloat32 && X_.stride(0) == 1) {
+                const precision_t* data = X_.data_ptr<precision_t>();
+                Discretizer::validate_finite(data, n, 0);
+                disc.bin(data, n, out);
+                return;
+            }
+            // Anything else goes a chunk at a time through a buffer that stays in
+            // cache while it is checked and binned.
+            const size_t chunk = Discretizer::transform_chunk;
+            samples_t samples(std::min(n, chunk));
+            for (size_t begin = 0; begin < n; begin += chunk) {
+                const size_t count = std::min(chunk, n - begin);
+                detail::read_samples(X_, begin, count, samples.data());
+                Discretizer::validate_finite(samples.data(), count, begin);
+                disc.bin(samples.data(), count, out + begin);
+            }
+        }
+    };
+
+    void fit_t(Discretizer& disc, const torch::Tensor& X_, const torch::Tensor& y_)
+    {
+        detail::validate_pair(X_, y_);
+        const auto n = static_cast<size_t>(X_.numel());
+        samples_t X(n);
+        labels_t y(n);
+        detail::read_samples(X_, 0, n, X.data());
+        detail::read_labels(y_, y.data());
+        // The vectors are ours: the discretizer may keep them rather than copy.
+        disc.fit(std::move(X), std::move(y));
+    }
+    torch::Tensor transform_t(const Discretizer& disc, const torch::Tensor& X_)
+    {
+        detail::validate_tensor(X_, torch::kFloat32, torch::kFloat64, "X", "Float32 or Float64", "Tensor cannot be empty");
+        auto result = torch::empty({ X_.numel() }, torch_label_t);
+        TensorAccess::transform_into(disc, X_, result.data_ptr<label_t>());
+        return result;
+    }
+    torch::Tensor fit_transform_t(Discretizer& disc, const torch::Tensor& X_, const torch::Tensor& y_)
+    {
+        fit_t(disc, X_, y_);
+        return transform_t(disc, X_);
+    }
+}
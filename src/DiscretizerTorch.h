@@ -0,0 +1,122 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_DISCRETIZERTORCH_H
+#define MDLP_DISCRETIZERTORCH_H
+
+#ifndef MDLP_WITH_TORCH
+#error "DiscretizerTorch.h needs fimdlp_torch: link fimdlp::fimdlp_torch or fimdlp::fimdlp"
+#endif
+
+// The tensor entry points of every Discretizer. Free functions rather than
+// members, so that Discretizer has one definition whether or not a translation
+// unit sees libtorch.
+
+#include <string>
+#include <torch/torch.h>
+#include "Discretizer.h"
+
+namespace mdlp {
+    const auto torch_label_t = torch::kInt32;
+
+    /**
+     * @brief Fit a discretizer on PyTorch tensors
+     * @param disc Discretizer to fit
+     * @param X_ Input tensor (Float32 or Float64, 1D, CPU)
+     * @param y_ Labels tensor (Int32 or Int64, 1D, CPU)
+     * @throws ValidationError (also a `std::invalid_argument`) if a tensor is
+     *         not 1D, not on the CPU, has the wrong dtype, is empty, if
+     *         sizes do not match, or if an Int64 label does not fit in 32 bits
+     *
+     * @code
+     * CPPFImdlp disc;
+     * fit_t(disc, torch::tensor(X, torch::kFloat32), torch::tensor(y, torch::kInt32));
+     * @endcode
+     *
+     * @note Non-contiguous tensors are accepted. A column view of a 2-D
+     *       dataset (e.g. `dataset.select(1, col)`) is not contiguous, and
+     *       this is the most natural way to feed one feature at a time, so
+     *       such inputs are read through their stride rather than rejected.
+     *       Float64 samples are narrowed to float as they are read; one
+     *       beyond the range of float is rejected as not finite.
+     */
+    void fit_t(Discretizer& disc, const torch::Tensor& X_, const torch::Tensor& y_);
+
+    /**
+     * @brief Transform a PyTorch tensor with a fitted discretizer
+     * @param disc Fitted discretizer
+     * @param X_ Input tensor (Float32 or Float64, 1D, CPU)
+     * @return Discretized tensor (Int32)
+     * @throws ValidationError (also a `std::invalid_argument`) if X_ is not 1D,
+     *         not on the CPU, has the wrong dtype, is empty, or holds a
+     *         non-finite value
+     * @throws NotFittedError if the discretizer has not been fitted
+     *
+     * A contiguous Float32 tensor is binned in place, straight into the
+     * storage of the returned tensor; other inputs are converted a chunk
+     * at a time. See fit_t() for the accepted layouts.
+     */
+    torch::Tensor transform_t(const Discretizer& disc, const torch::Tensor& X_);
+
+    /**
+     * @brief Fit and transform PyTorch tensors in a single call
+     * @param disc Discretizer to fit
+     * @param X_ Input tensor (Float32 or Float64, 1D, CPU)
+     * @param y_ Labels tensor (Int32 or Int64, 1D, CPU)
+     * @return Discretized tensor (Int32)
+     * @throws ValidationError (also a `std::invalid_argument`) under the same
+     *         conditions as fit_t()
+     *
+     * @note Non-contiguous tensors are accepted; see fit_t().
+     */
+    torch::Tensor fit_transform_t(Discretizer& disc, const torch::Tensor& X_, const torch::Tensor& y_);
+
+    namespace detail {
+        /**
+         * @brief Validate a 1-D CPU tensor
+         * @param t Tensor to validate
+         * @param narrow_type First accepted scalar type
+         * @param wide_type Second accepted scalar type
+         * @param name Tensor name used in error messages ("X" or "y")
+         * @param type_names Human-readable accepted types used in error messages
+         * @param empty_message Message thrown when the tensor has no elements
+         * @throws ValidationError (also a `std::invalid_argument`) if any check fails
+         */
+        void validate_tensor(
+            const torch::Tensor& t,
+            torch::ScalarType narrow_type,
+            torch::ScalarType wide_type,
+            const std::string& name,
+            const std::string& type_names,
+            const std::string& empty_message);
+
+        /**
+         * @brief Validate an (X, y) tensor pair
+         * @throws ValidationError (also a `std::invalid_argument`) if either tensor is
+         *         invalid or the sizes differ
+         */
+        void validate_pair(const torch::Tensor& X_, const torch::Tensor& y_);
+
+        /**
+         * @brief Read count samples of a Float32 or Float64 1-D tensor as floats
+         * @param X_ Validated tensor; read through its stride, so a column view
+         *        of a 2-D dataset is read where it lies
+         * @param begin Index of the first sample to read
+         * @param count Number of samples
+         * @param dst Destination for count samples
+         */
+        void read_samples(const torch::Tensor& X_, size_t begin, size_t count, precision_t* dst);
+
+        /**
+         * @brief Read every label of an Int32 or Int64 1-D tensor
+         * @param y_ Validated tensor; read through its stride
+         * @param dst Destination for y_.numel() labels
+         * @throws ValidationError if an Int64 label does not fit in label_t
+         */
+        void read_labels(const torch::Tensor& y_, label_t* dst);
+    }
+}
+#endif
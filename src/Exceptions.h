@@ -58,7 +58,7 @@ namespace mdlp {
         }
     }
 
-    // The five concrete types are spelled out rather than generated from a
+    // The concrete types are spelled out rather than generated from a
     // template, for the same lcov reason noted above. Each pairs the library tag
     // with the std:: exception it replaces.
 
@@ -116,5 +116,17 @@ namespace mdlp {
         ~UnderflowError() override = default;
         const char* message() const noexcept override { return what(); }
     };
+
+    /**
+     * @brief A file could not be opened, mapped, read or written
+     * @note Also a `std::runtime_error`. A file that opens but holds the wrong
+     *       bytes is a ValidationError instead: the I/O worked, the data did not.
+     */
+    class IOError : public std::runtime_error, public DiscretizerError {
+    public:
+        explicit IOError(const std::string& what_arg) : std::runtime_error(what_arg) {}
+        ~IOError() override = default;
+        const char* message() const noexcept override { return what(); }
+    };
 }
 #endif
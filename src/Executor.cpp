@@ -0,0 +1,106 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <algorithm>
+#include <utility>
+#include "Executor.h"
+
+namespace mdlp {
+
+    ThreadPool::ThreadPool(size_t n_threads)
+    {
+        if (n_threads == 0) {
+            // hardware_concurrency() may report 0 when it cannot tell.
+            n_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+        workers.reserve(n_threads - 1);
+        for (size_t i = 1; i < n_threads; ++i) {
+            workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::run(size_t count, const std::function<void(size_t)>& fn)
+    {
+        if (count == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> serial(run_mutex);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = &fn;
+            n_tasks = count;
+            next = 0;
+            finished = 0;
+            error = nullptr;
+            ++generation;
+        }
+        wake.notify_all();
+        drain();
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return finished == n_tasks; });
+        // A worker that wakes late finds no task and goes back to sleep.
+        task = nullptr;
+        if (error) {
+            std::rethrow_exception(std::exchange(error, nullptr));
+        }
+    }
+
+    void ThreadPool::drain()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (task != nullptr && next < n_tasks) {
+            const size_t index = next++;
+            const auto* fn = task;
+            lock.unlock();
+            std::exception_ptr thrown;
+            try {
+                (*fn)(index);
+            }
+            catch (...) {
+                thrown = std::current_exception();
+            }
+            lock.lock();
+            ++finished;
+            if (thrown && !error) {
+                error = thrown;
+                // Skip what has not started: the run has failed already.
+                finished += n_tasks - next;
+                next = n_tasks;
+            }
+            if (finished == n_tasks) {
+                done.notify_all();
+            }
+        }
+    }
+
+    void ThreadPool::work()
+    {
+        size_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            lock.unlock();
+            drain();
+            lock.lock();
+        }
+    }
+}
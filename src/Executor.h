@@ -0,0 +1,91 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_EXECUTOR_H
+#define MDLP_EXECUTOR_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mdlp {
+    /**
+     * @brief Where the library runs work that can be split into tasks
+     *
+     * The one extension point for parallelism: an application that already owns
+     * a scheduler — TBB, a task system, a fixed set of pinned threads — wraps it
+     * in an Executor and passes it in, instead of the library starting threads
+     * of its own. ThreadPool is the implementation provided.
+     */
+    class Executor {
+    public:
+        virtual ~Executor() = default;
+
+        /** @brief How many tasks run() may execute at once; at least 1 */
+        virtual size_t concurrency() const = 0;
+
+        /**
+         * @brief Call task(i) once for every i in [0, n_tasks), return when all have
+         * @param n_tasks Number of tasks; zero returns at once
+         * @param task Called concurrently from several threads, with distinct i
+         *
+         * If tasks throw, every task still runs or is skipped before run()
+         * returns, and the exception of one of them is rethrown; which one is
+         * unspecified. Callers that need a deterministic error decide it
+         * themselves after run() returns.
+         */
+        virtual void run(size_t n_tasks, const std::function<void(size_t)>& task) = 0;
+    };
+
+    /**
+     * @brief A fixed set of worker threads, reused across run() calls
+     *
+     * The calling thread works too, so a pool of n threads keeps n - 1 workers.
+     * Tasks are handed out one at a time from a shared counter, which balances
+     * uneven tasks without any queue.
+     *
+     * Starting threads costs tens of microseconds each; construct one pool and
+     * pass it to every call rather than a thread count per call, when calls are
+     * many or small. One run() at a time: concurrent run() calls on the same
+     * pool are serialized.
+     */
+    class ThreadPool : public Executor {
+    public:
+        /**
+         * @param n_threads Threads to run tasks on, the caller's included; 0
+         *        means std::thread::hardware_concurrency()
+         */
+        explicit ThreadPool(size_t n_threads = 0);
+        ~ThreadPool() override;
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        inline size_t concurrency() const override { return workers.size() + 1; };
+        void run(size_t n_tasks, const std::function<void(size_t)>& task) override;
+
+    private:
+        void work();
+        void drain();
+
+        std::vector<std::thread> workers;
+        std::mutex run_mutex;      // one run() at a time
+        std::mutex mutex;          // guards everything below
+        std::condition_variable wake;
+        std::condition_variable done;
+        const std::function<void(size_t)>* task = nullptr;
+        size_t n_tasks = 0;
+        size_t next = 0;
+        size_t finished = 0;
+        size_t generation = 0;
+        bool stopping = false;
+        std::exception_ptr error;
+    };
+}
+#endif
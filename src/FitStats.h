@@ -0,0 +1,99 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_FITSTATS_H
+#define MDLP_FITSTATS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace mdlp {
+    /**
+     * @brief Where the time and memory of one fit() went
+     *
+     * Filled by CPPFImdlp and BinDisc (and so PKIDisc) when collection is on;
+     * see Discretizer::collectFitStats(). Every fit() starts from zero, so the
+     * figures are those of the last fit. Counters a discretizer has no use for
+     * stay zero: BinDisc neither scans candidates nor consults Metrics.
+     *
+     * The phases do not overlap, and total_ns also covers what lies between
+     * them, so their sum is at most total_ns.
+     */
+    struct FitStats {
+        // Nanoseconds per phase.
+        uint64_t validate_ns = 0;  ///< Input checks and the one-pass summary
+        uint64_t sort_ns = 0;      ///< MDLP's argsort; the order statistics a QUANTILE fit selects
+        uint64_t search_ns = 0;    ///< MDLP's recursive cut search; a BinDisc's percentiles or grid
+        uint64_t prune_ns = 0;     ///< MDLP's trimming to proposed_cuts
+        uint64_t total_ns = 0;     ///< The whole fit()
+
+        // CPPFImdlp's cut search.
+        uint64_t candidate_calls = 0;   ///< getCandidate() calls
+        uint64_t elements_scanned = 0;  ///< Lengths of the intervals those calls scanned, summed
+        uint64_t duplicate_steps = 0;   ///< Steps over runs of equal values placing accepted cuts
+        uint64_t cuts_accepted = 0;     ///< Candidates the MDL criterion kept
+        uint64_t cuts_rejected = 0;     ///< Candidates it refused
+        uint64_t cuts_pruned = 0;       ///< Accepted cuts dropped to honour proposed_cuts
+        int max_depth = 0;              ///< Deepest recursion reached
+
+        // Metrics' memoized entropies and information gains.
+        uint64_t cache_hits = 0;
+        uint64_t cache_misses = 0;
+
+        /**
+         * @brief Most scratch memory held at once, in bytes
+         *
+         * Buffers a fit allocates beyond its input: the copies it sorts, the
+         * index order, Metrics' copies and the per-class counts of a scan.
+         * Container overhead and the cut points are not counted.
+         */
+        size_t peak_scratch_bytes = 0;
+
+        /** @brief Record bytes of scratch taken; the peak follows */
+        inline void hold(size_t bytes)
+        {
+            scratch_bytes += bytes;
+            peak_scratch_bytes = std::max(peak_scratch_bytes, scratch_bytes);
+        }
+        /** @brief Record bytes of scratch given back */
+        inline void release(size_t bytes) { scratch_bytes -= std::min(bytes, scratch_bytes); }
+
+    private:
+        size_t scratch_bytes = 0;  // held now
+    };
+
+    /**
+     * @brief Adds the nanoseconds of its own lifetime to a FitStats phase
+     *
+     * Does nothing, not even read the clock, when stats is null, which is what
+     * keeps collection free when it is off.
+     */
+    class FitTimer {
+    public:
+        FitTimer(FitStats* stats, uint64_t FitStats::* phase) : target(stats ? &(stats->*phase) : nullptr)
+        {
+            if (target) {
+                start = std::chrono::steady_clock::now();
+            }
+        }
+        ~FitTimer()
+        {
+            if (target) {
+                *target += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+            }
+        }
+        FitTimer(const FitTimer&) = delete;
+        FitTimer& operator=(const FitTimer&) = delete;
+
+    private:
+        uint64_t* target;
+        std::chrono::steady_clock::time_point start;
+    };
+}
+#endif
@@ -0,0 +1,738 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include "Loader.h"
+#include "MappedFile.h"
+#include "Exceptions.h"
+#include "Trace.h"
+
+namespace mdlp {
+
+    namespace {
+        // Below this a file is parsed on the calling thread: starting a pool
+        // costs more than the parse.
+        constexpr size_t min_chunk = size_t{ 1 } << 16;
+        // Chunks per thread, so a chunk of long rows does not hold up the rest.
+        constexpr size_t chunks_per_thread = 8;
+
+        constexpr double powers_of_ten[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        class InlineExecutor : public Executor {
+        public:
+            inline size_t concurrency() const override { return 1; };
+            void run(size_t n_tasks, const std::function<void(size_t)>& task) override
+            {
+                for (size_t i = 0; i < n_tasks; ++i) {
+                    task(i);
+                }
+            }
+        };
+
+        inline bool is_digit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+        inline bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+        std::string_view trim(std::string_view text)
+        {
+            while (!text.empty() && is_blank(text.front())) {
+                text.remove_prefix(1);
+            }
+            while (!text.empty() && is_blank(text.back())) {
+                text.remove_suffix(1);
+            }
+            return text;
+        }
+
+        bool starts_with_keyword(std::string_view line, std::string_view keyword)
+        {
+            if (line.size() < keyword.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < keyword.size(); ++i) {
+                if (std::tolower(static_cast<unsigned char>(line[i])) != keyword[i]) {
+                    return false;
+                }
+            }
+            return line.size() == keyword.size() || is_blank(line[keyword.size()]);
+        }
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        // Eight ASCII digits in one word: a check and three multiplications
+        // instead of eight dependent multiply-adds.
+        inline bool eight_digits(const char* p, uint64_t& value)
+        {
+            uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            if ((((word & 0xF0F0F0F0F0F0F0F0ull) | (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4))
+                != 0x3333333333333333ull)) {
+                return false;
+            }
+            word -= 0x3030303030303030ull;
+            word = (word * 10) + (word >> 8);
+            value = (((word & 0x000000FF000000FFull) * (100 + (1000000ull << 32)))
+                + (((word >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+            return true;
+        }
+#else
+        inline bool eight_digits(const char*, uint64_t&) { return false; }
+#endif
+
+        // Digits go into mantissa while it has room for them; count is how
+        // many went in, leading zeros of the number excepted.
+        inline const char* gather_digits(const char* p, const char* last, uint64_t& mantissa, int& count)
+        {
+            uint64_t eight;
+            while (last - p >= 8 && count <= 11 && eight_digits(p, eight)) {
+                mantissa = mantissa * 100000000 + eight;
+                count += 8;
+                p += 8;
+            }
+            for (; p < last && is_digit(*p); ++p) {
+                if (mantissa != 0 || *p != '0') {
+                    ++count;
+                }
+                if (count <= 19) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                }
+            }
+            return p;
+        }
+
+        bool parse_with_strtod(const char* first, const char* last, precision_t& value)
+        {
+            const std::string token(first, last);
+            char* end = nullptr;
+            const double parsed = std::strtod(token.c_str(), &end);
+            if (end == token.c_str() || end != token.c_str() + token.size()) {
+                return false;
+            }
+            value = static_cast<precision_t>(parsed);
+            return true;
+        }
+
+        // Where a row or header went wrong, so the error that reaches the
+        // caller can be the first in the file, whichever thread found it.
+        struct ParseFailure {
+            const char* at;
+            std::string message;
+        };
+
+        [[noreturn]] void fail(const char* at, std::string message)
+        {
+            throw ParseFailure{ at, std::move(message) };
+        }
+
+        std::string quoted(std::string_view text)
+        {
+            return "'" + std::string(text) + "'";
+        }
+
+        // The delimited fields of one line, trimmed and unquoted.
+        class Fields {
+        public:
+            Fields(std::string_view line, char delimiter) : p(line.data()), last(line.data() + line.size()), delimiter(delimiter) {}
+
+            bool next(std::string_view& field)
+            {
+                if (exhausted) {
+                    return false;
+                }
+                while (p < last && is_blank(*p)) {
+                    ++p;
+                }
+                const char* begin = p;
+                const char* end;
+                if (p < last && (*p == '\'' || *p == '"')) {
+                    const char quote = *p;
+                    begin = ++p;
+                    p = static_cast<const char*>(std::memchr(p, quote, static_cast<size_t>(last - p)));
+                    if (p == nullptr) {
+                        fail(begin - 1, "unterminated quote");
+                    }
+                    end = p++;
+                    while (p < last && is_blank(*p)) {
+                        ++p;
+                    }
+                    if (p < last && *p != delimiter) {
+                        fail(p, "text after a quoted value");
+                    }
+                } else {
+                    while (p < last && *p != delimiter) {
+                        ++p;
+                    }
+                    end = p;
+                    while (end > begin && is_blank(end[-1])) {
+                        --end;
+                    }
+                }
+                field = std::string_view(begin, static_cast<size_t>(end - begin));
+                if (p < last) {
+                    ++p;  // the delimiter
+                } else {
+                    exhausted = true;
+                }
+                return true;
+            }
+
+        private:
+            const char* p;
+            const char* last;
+            char delimiter;
+            bool exhausted = false;
+        };
+
+        using value_index_t = std::unordered_map<std::string_view, int>;
+
+        enum class Kind { numeric, nominal, label };
+
+        struct Column {
+            Kind kind = Kind::numeric;
+            std::string_view name;
+            const value_index_t* values = nullptr;  // nominal
+            size_t feature = 0;                     // numeric, nominal
+        };
+
+        struct Schema {
+            std::vector<Column> columns;
+            size_t features = 0;
+            char delimiter = ',';
+            bool comments = false;     // % starts a comment line
+            bool arff = false;
+            std::vector<std::string_view> attribute_names;
+            std::vector<std::string_view> attribute_types;
+            std::vector<std::string_view> declared;            // nominal values of each attribute, flattened
+            std::vector<size_t> declared_begin;               // where each attribute's values start in declared
+            std::vector<value_index_t> value_indices;          // per attribute
+            size_t class_column = 0;
+            const char* data = nullptr;                        // first byte after the header
+        };
+
+        inline const char* end_of_line(const char* p, const char* last)
+        {
+            const void* newline = std::memchr(p, '\n', static_cast<size_t>(last - p));
+            return newline ? static_cast<const char*>(newline) : last;
+        }
+
+        inline bool is_record(std::string_view line, bool comments)
+        {
+            const auto text = trim(line);
+            return !text.empty() && !(comments && text.front() == '%');
+        }
+
+        // What one chunk found: its rows, and the class values it met, each
+        // numbered in the order the chunk first saw it.
+        struct ChunkResult {
+            size_t first_row = 0;
+            size_t rows = 0;
+            std::vector<std::string_view> vocabulary;
+            std::vector<const char*> first_seen;
+            value_index_t ids;
+            bool failed = false;
+            ParseFailure failure{ nullptr, {} };
+        };
+
+        void parse_chunk(const Schema& schema, const char* p, const char* last,
+            const std::vector<precision_t*>& columns, label_t* labels, ChunkResult& result)
+        {
+            size_t row = result.first_row;
+            std::string_view last_label;
+            int last_id = -1;
+            while (p < last) {
+                const char* eol = end_of_line(p, last);
+                const std::string_view line(p, static_cast<size_t>(eol - p));
+                const char* line_start = p;
+                p = eol + 1;
+                if (!is_record(line, schema.comments)) {
+                    continue;
+                }
+                if (schema.arff && trim(line).front() == '{') {
+                    fail(line_start, "sparse rows are not supported");
+                }
+                Fields fields(line, schema.delimiter);
+                std::string_view field;
+                size_t index = 0;
+                for (const auto& column : schema.columns) {
+                    if (!fields.next(field)) {
+                        fail(line_start, "expected " + std::to_string(schema.columns.size()) + " values, found " + std::to_string(index));
+                    }
+                    ++index;
+                    switch (column.kind) {
+                        case Kind::numeric:
+                            if (!parse_float(field.data(), field.data() + field.size(), columns[column.feature][row])) {
+                                fail(field.data(), field == "?" ? "missing value in " + std::string(column.name) + ", which is not supported"
+                                    : quoted(field) + " in " + std::string(column.name) + " is not a number");
+                            }
+                            break;
+                        case Kind::nominal: {
+                            const auto found = column.values->find(field);
+                            if (found == column.values->end()) {
+                                fail(field.data(), field == "?" ? "missing value in " + std::string(column.name) + ", which is not supported"
+                                    : quoted(field) + " is not a declared value of " + std::string(column.name));
+                            }
+                            columns[column.feature][row] = static_cast<precision_t>(found->second);
+                            break;
+                        }
+                        case Kind::label:
+                            // Rows of one class often come together.
+                            if (last_id < 0 || field != last_label) {
+                                const auto inserted = result.ids.emplace(field, static_cast<int>(result.vocabulary.size()));
+                                if (inserted.second) {
+                                    result.vocabulary.push_back(field);
+                                    result.first_seen.push_back(field.data());
+                                }
+                                last_label = field;
+                                last_id = inserted.first->second;
+                            }
+                            labels[row] = last_id;
+                            break;
+                    }
+                }
+                if (fields.next(field)) {
+                    fail(line_start, "expected " + std::to_string(schema.columns.size()) + " values, found more");
+                }
+                ++row;
+            }
+        }
+
+        std::string where(const MappedFile& file, const std::string& path, const char* at)
+        {
+            if (at == nullptr) {
+                return path + ": ";
+            }
+            const auto begin = reinterpret_cast<const char*>(file.data());
+            const auto line = 1 + std::count(begin, at, '\n');
+            return path + ":" + std::to_string(line) + ": ";
+        }
+
+        // Chunks of the data section, each ending just after a newline.
+        std::vector<const char*> split(const char* data, const char* last, size_t concurrency)
+        {
+            const size_t bytes = static_cast<size_t>(last - data);
+            const size_t chunk = std::max(min_chunk, (bytes + concurrency * chunks_per_thread - 1) / (concurrency * chunks_per_thread));
+            std::vector<const char*> bounds{ data };
+            while (bounds.back() < last) {
+                const char* p = bounds.back() + std::min(chunk, static_cast<size_t>(last - bounds.back()));
+                bounds.push_back(p < last ? std::min(last, end_of_line(p, last) + 1) : last);
+            }
+            return bounds;
+        }
+
+        bool as_integer(std::string_view text, int& value)
+        {
+            const char* first = text.data();
+            const char* last = text.data() + text.size();
+            if (first < last && *first == '+') {
+                ++first;
+            }
+            const auto result = std::from_chars(first, last, value);
+            return first < last && result.ec == std::errc() && result.ptr == last;
+        }
+
+        Dataset parse(const MappedFile& file, const std::string& path, const Schema& schema, Executor& executor)
+        {
+            MDLP_TRACE_SCOPE("load");
+            const char* last = reinterpret_cast<const char*>(file.data()) + file.size();
+            const auto bounds = split(schema.data, last, executor.concurrency());
+            const size_t n_chunks = bounds.size() - 1;
+            std::vector<ChunkResult> chunks(n_chunks);
+            const auto first_failure = [&]() {
+                const ChunkResult* first = nullptr;
+                for (const auto& chunk : chunks) {
+                    if (chunk.failed && (first == nullptr || chunk.failure.at < first->failure.at)) {
+                        first = &chunk;
+                    }
+                }
+                return first;
+                };
+            // Pass 1: rows per chunk, so every chunk knows where its rows go.
+            executor.run(n_chunks, [&](size_t c) {
+                size_t rows = 0;
+                for (const char* p = bounds[c]; p < bounds[c + 1];) {
+                    const char* eol = end_of_line(p, bounds[c + 1]);
+                    rows += is_record(std::string_view(p, static_cast<size_t>(eol - p)), schema.comments) ? 1 : 0;
+                    p = eol + 1;
+                }
+                chunks[c].rows = rows;
+                });
+            size_t n_rows = 0;
+            for (auto& chunk : chunks) {
+                chunk.first_row = n_rows;
+                n_rows += chunk.rows;
+            }
+            Dataset dataset;
+            dataset.X.resize(schema.features);
+            std::vector<precision_t*> columns;
+            for (auto& column : dataset.X) {
+                column.resize(n_rows);
+                columns.push_back(column.data());
+            }
+            dataset.y.resize(n_rows);
+            // Pass 2: every chunk straight into its rows.
+            executor.run(n_chunks, [&](size_t c) {
+                MDLP_TRACE_SCOPE_RANGE("load chunk", chunks[c].first_row, chunks[c].first_row + chunks[c].rows);
+                try {
+                    parse_chunk(schema, bounds[c], bounds[c + 1], columns, dataset.y.data(), chunks[c]);
+                }
+                catch (ParseFailure& failure) {
+                    chunks[c].failed = true;
+                    chunks[c].failure = std::move(failure);
+                }
+                });
+            if (const auto failed = first_failure()) {
+                throw ValidationError(where(file, path, failed->failure.at) + failed->failure.message);
+            }
+            // Class values, numbered across chunks in the order the file has them.
+            std::vector<std::string_view> names;
+            std::vector<const char*> first_seen;
+            value_index_t global;
+            std::vector<std::vector<int>> remap(n_chunks);
+            for (size_t c = 0; c < n_chunks; ++c) {
+                for (size_t v = 0; v < chunks[c].vocabulary.size(); ++v) {
+                    const auto inserted = global.emplace(chunks[c].vocabulary[v], static_cast<int>(names.size()));
+                    if (inserted.second) {
+                        names.push_back(chunks[c].vocabulary[v]);
+                        first_seen.push_back(chunks[c].first_seen[v]);
+                    }
+                    remap[c].push_back(inserted.first->second);
+                }
+            }
+            const auto& class_column = schema.columns[schema.class_column];
+            std::vector<int> labels(names.size());
+            if (class_column.values != nullptr) {
+                for (size_t i = 0; i < names.size(); ++i) {
+                    const auto found = class_column.values->find(names[i]);
+                    if (found == class_column.values->end()) {
+                        throw ValidationError(where(file, path, first_seen[i]) + quoted(names[i])
+                            + " is not a declared value of " + std::string(class_column.name));
+                    }
+                    labels[i] = found->second;
+                }
+                const size_t a = schema.class_column;
+                for (size_t v = schema.declared_begin[a]; v < schema.declared_begin[a + 1]; ++v) {
+                    dataset.class_values.emplace_back(schema.declared[v]);
+                }
+            } else {
+                bool integers = true;
+                for (size_t i = 0; i < names.size() && integers; ++i) {
+                    integers = as_integer(names[i], labels[i]);
+                    if (!integers && schema.arff) {
+                        throw ValidationError(where(file, path, first_seen[i]) + "class value " + quoted(names[i])
+                            + " is neither declared nor an integer");
+                    }
+                }
+                if (!integers) {
+                    for (size_t i = 0; i < names.size(); ++i) {
+                        labels[i] = static_cast<int>(i);
+                        dataset.class_values.emplace_back(names[i]);
+                    }
+                }
+            }
+            for (auto& table : remap) {
+                for (auto& id : table) {
+                    id = labels[static_cast<size_t>(id)];
+                }
+            }
+            executor.run(n_chunks, [&](size_t c) {
+                const auto& table = remap[c];
+                label_t* y = dataset.y.data() + chunks[c].first_row;
+                for (size_t i = 0; i < chunks[c].rows; ++i) {
+                    y[i] = table[static_cast<size_t>(y[i])];
+                }
+                });
+            for (size_t i = 0; i < schema.columns.size(); ++i) {
+                if (i != schema.class_column) {
+                    dataset.attributes.emplace_back(schema.attribute_names[i], schema.attribute_types[i]);
+                }
+            }
+            dataset.class_name = std::string(schema.attribute_names[schema.class_column]);
+            dataset.class_type = std::string(schema.attribute_types[schema.class_column]);
+            return dataset;
+        }
+
+        // Puts the class column where class_last says and numbers the features
+        // around it.
+        void place_class(Schema& schema, bool class_last)
+        {
+            schema.class_column = class_last ? schema.columns.size() - 1 : 0;
+            for (size_t i = 0; i < schema.columns.size(); ++i) {
+                auto& column = schema.columns[i];
+                if (i == schema.class_column) {
+                    column.kind = Kind::label;
+                } else {
+                    column.feature = schema.features++;
+                }
+            }
+        }
+
+        Schema arff_schema(const MappedFile& file, const std::string& path, bool class_last)
+        {
+            Schema schema;
+            schema.comments = true;
+            schema.arff = true;
+            const char* p = reinterpret_cast<const char*>(file.data());
+            const char* last = p + file.size();
+            std::vector<Kind> kinds;
+            schema.declared_begin.push_back(0);
+            try {
+                while (schema.data == nullptr) {
+                    if (p >= last) {
+                        fail(nullptr, "no @data section");
+                    }
+                    const char* eol = end_of_line(p, last);
+                    const auto line = trim(std::string_view(p, static_cast<size_t>(eol - p)));
+                    const char* line_start = p;
+                    p = eol + 1;
+                    if (line.empty() || line.front() == '%' || starts_with_keyword(line, "@relation")) {
+                        continue;
+                    }
+                    if (starts_with_keyword(line, "@data")) {
+                        schema.data = std::min(p, last);
+                        break;
+                    }
+                    if (!starts_with_keyword(line, "@attribute")) {
+                        fail(line_start, "expected @attribute or @data, found " + quoted(line));
+                    }
+                    auto rest = trim(line.substr(10));
+                    std::string_view name;
+                    if (!rest.empty() && (rest.front() == '\'' || rest.front() == '"')) {
+                        const auto close = rest.find(rest.front(), 1);
+                        if (close == std::string_view::npos) {
+                            fail(rest.data(), "unterminated quote");
+                        }
+                        name = rest.substr(1, close - 1);
+                        rest = trim(rest.substr(close + 1));
+                    } else {
+                        const auto space = std::min(rest.find(' '), rest.find('\t'));
+                        name = rest.substr(0, space);
+                        rest = space == std::string_view::npos ? std::string_view() : trim(rest.substr(space));
+                    }
+                    if (name.empty() || rest.empty()) {
+                        fail(line_start, "attribute needs a name and a type");
+                    }
+                    std::string type(rest);
+                    std::transform(type.begin(), type.end(), type.begin(), [](unsigned char c) { return std::tolower(c); });
+                    if (rest.front() == '{') {
+                        if (rest.back() != '}') {
+                            fail(rest.data(), "unterminated list of values");
+                        }
+                        Fields values(rest.substr(1, rest.size() - 2), ',');
+                        std::string_view value;
+                        while (values.next(value)) {
+                            schema.declared.push_back(value);
+                        }
+                        kinds.push_back(Kind::nominal);
+                    } else if (type == "real" || type == "numeric" || type == "integer") {
+                        kinds.push_back(Kind::numeric);
+                    } else {
+                        fail(rest.data(), "attribute " + quoted(name) + " of type " + quoted(rest) + " is not supported");
+                    }
+                    schema.declared_begin.push_back(schema.declared.size());
+                    schema.attribute_names.push_back(name);
+                    schema.attribute_types.push_back(rest);
+                }
+                if (kinds.empty()) {
+                    fail(schema.data, "no attributes before @data");
+                }
+            }
+            catch (const ParseFailure& failure) {
+                throw ValidationError(where(file, path, failure.at) + failure.message);
+            }
+            // Built once every value is in place: the indices point into the file.
+            schema.value_indices.resize(kinds.size());
+            schema.columns.resize(kinds.size());
+            for (size_t a = 0; a < kinds.size(); ++a) {
+                auto& column = schema.columns[a];
+                column.name = schema.attribute_names[a];
+                if (kinds[a] == Kind::nominal) {
+                    for (size_t v = schema.declared_begin[a]; v < schema.declared_begin[a + 1]; ++v) {
+                        schema.value_indices[a].emplace(schema.declared[v], static_cast<int>(v - schema.declared_begin[a]));
+                    }
+                    column.kind = Kind::nominal;
+                    column.values = &schema.value_indices[a];
+                }
+            }
+            place_class(schema, class_last);
+            return schema;
+        }
+
+        Schema csv_schema(const MappedFile& file, const std::string& path, const CsvOptions& options, std::vector<std::string>& generated)
+        {
+            Schema schema;
+            schema.delimiter = options.delimiter;
+            const char* p = reinterpret_cast<const char*>(file.data());
+            const char* last = p + file.size();
+            std::string_view first_line;
+            const char* after = p;
+            while (p < last) {
+                const char* eol = end_of_line(p, last);
+                const std::string_view line(p, static_cast<size_t>(eol - p));
+                p = eol + 1;
+                if (is_record(line, false)) {
+                    first_line = line;
+                    after = std::min(p, last);
+                    break;
+                }
+            }
+            if (first_line.empty()) {
+                throw ValidationError(path + ": no rows");
+            }
+            std::vector<std::string_view> names;
+            try {
+                Fields fields(first_line, options.delimiter);
+                std::string_view field;
+                while (fields.next(field)) {
+                    names.push_back(field);
+                }
+            }
+            catch (const ParseFailure& failure) {
+                throw ValidationError(where(file, path, failure.at) + failure.message);
+            }
+            schema.data = options.header ? after : first_line.data();
+            if (!options.header) {
+                // Reserved first, so the views below stay put.
+                generated.reserve(names.size());
+                for (size_t i = 0; i + 1 < names.size(); ++i) {
+                    generated.push_back("x" + std::to_string(i));
+                }
+                generated.insert(options.class_last ? generated.end() : generated.begin(), "class");
+                names.assign(generated.begin(), generated.end());
+            }
+            schema.attribute_names = names;
+            schema.columns.resize(names.size());
+            for (size_t i = 0; i < names.size(); ++i) {
+                schema.columns[i].name = names[i];
+                schema.attribute_types.push_back("numeric");
+            }
+            place_class(schema, options.class_last);
+            schema.attribute_types[schema.class_column] = "";
+            return schema;
+        }
+
+        Dataset load_csv(const MappedFile& file, const std::string& path, const CsvOptions& options, Executor& executor)
+        {
+            std::vector<std::string> generated;
+            const auto schema = csv_schema(file, path, options, generated);
+            auto dataset = parse(file, path, schema, executor);
+            if (dataset.class_values.empty()) {
+                dataset.class_type = "integer";
+            } else {
+                std::string type = "{";
+                for (const auto& value : dataset.class_values) {
+                    type += (type.size() > 1 ? "," : "") + value;
+                }
+                dataset.class_type = type + "}";
+            }
+            return dataset;
+        }
+
+        bool small(const MappedFile& file, size_t n_threads)
+        {
+            return n_threads == 1 || file.size() <= min_chunk;
+        }
+    }
+
+    bool parse_float(const char* first, const char* last, precision_t& value)
+    {
+        const char* p = first;
+        const bool negative = p < last && *p == '-';
+        if (p < last && (*p == '-' || *p == '+')) {
+            ++p;
+        }
+        uint64_t mantissa = 0;
+        int count = 0;
+        const char* digits = p;
+        p = gather_digits(p, last, mantissa, count);
+        size_t n_digits = static_cast<size_t>(p - digits);
+        int exponent = 0;
+        if (p < last && *p == '.') {
+            const char* fraction = ++p;
+            p = gather_digits(p, last, mantissa, count);
+            n_digits += static_cast<size_t>(p - fraction);
+            // Every fraction digit went into mantissa, leading zeros included
+            // as a multiplication by ten; past the nineteenth, the fallback
+            // below takes over.
+            exponent = -static_cast<int>(p - fraction);
+        }
+        if (n_digits == 0) {
+            return parse_with_strtod(first, last, value);  // inf, nan, or not a number
+        }
+        if (p < last && (*p == 'e' || *p == 'E')) {
+            const char* q = p + 1;
+            const bool exponent_negative = q < last && *q == '-';
+            if (q < last && (*q == '-' || *q == '+')) {
+                ++q;
+            }
+            if (q == last || !is_digit(*q)) {
+                return parse_with_strtod(first, last, value);
+            }
+            int written = 0;
+            for (; q < last && is_digit(*q); ++q) {
+                written = std::min(written * 10 + (*q - '0'), 100000);
+            }
+            exponent += exponent_negative ? -written : written;
+            p = q;
+        }
+        if (p != last) {
+            return parse_with_strtod(first, last, value);
+        }
+        if (mantissa == 0) {
+            value = negative ? -precision_t{ 0 } : precision_t{ 0 };
+            return true;
+        }
+        if (count > 19 || mantissa > (uint64_t{ 1 } << 53) || exponent < -22 || exponent > 22) {
+            return parse_with_strtod(first, last, value);
+        }
+        double result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / powers_of_ten[-exponent] : result * powers_of_ten[exponent];
+        value = static_cast<precision_t>(negative ? -result : result);
+        return true;
+    }
+
+    Dataset load_arff(const std::string& path, bool class_last, Executor& executor)
+    {
+        const MappedFile file(path);
+        return parse(file, path, arff_schema(file, path, class_last), executor);
+    }
+
+    Dataset load_arff(const std::string& path, bool class_last, size_t n_threads)
+    {
+        const MappedFile file(path);
+        const auto schema = arff_schema(file, path, class_last);
+        if (small(file, n_threads)) {
+            InlineExecutor inline_executor;
+            return parse(file, path, schema, inline_executor);
+        }
+        ThreadPool pool(n_threads);
+        return parse(file, path, schema, pool);
+    }
+
+    Dataset load_csv(const std::string& path, const CsvOptions& options, Executor& executor)
+    {
+        const MappedFile file(path);
+        return load_csv(file, path, options, executor);
+    }
+
+    Dataset load_csv(const std::string& path, const CsvOptions& options, size_t n_threads)
+    {
+        const MappedFile file(path);
+        if (small(file, n_threads)) {
+            InlineExecutor inline_executor;
+            return load_csv(file, path, options, inline_executor);
+        }
+        ThreadPool pool(n_threads);
+        return load_csv(file, path, options, pool);
+    }
+}
@@ -0,0 +1,123 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_LOADER_H
+#define MDLP_LOADER_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "typesFImdlp.h"
+#include "Executor.h"
+
+namespace mdlp {
+
+    /**
+     * @brief A labelled dataset stored by column, as the discretizers take it
+     *
+     * The fields follow ArffFiles' accessors, so code that read getX(), getY()
+     * and getAttributes() reads X, y and attributes instead.
+     */
+    struct Dataset {
+        std::vector<std::pair<std::string, std::string>> attributes; ///< Name and declared type of each feature, in file order
+        std::vector<samples_t> X;                ///< One column per feature, attributes.size() of them
+        labels_t y;                              ///< The class of every sample
+        std::string class_name;
+        std::string class_type;                  ///< As declared; for a CSV "integer", or the names in braces
+        std::vector<std::string> class_values;   ///< Label i stands for class_values[i]; empty when the labels are the integers in the file
+
+        /** @brief Number of samples */
+        inline size_t size() const { return y.size(); };
+    };
+
+    /** @brief How a CSV file is laid out */
+    struct CsvOptions {
+        char delimiter = ',';
+        bool header = true;      ///< The first line names the columns
+        bool class_last = true;  ///< The class is the last column; false, the first
+
+        CsvOptions& withDelimiter(char delimiter_) { delimiter = delimiter_; return *this; }
+        CsvOptions& withHeader(bool header_) { header = header_; return *this; }
+        CsvOptions& withClassLast(bool class_last_) { class_last = class_last_; return *this; }
+    };
+
+    /**
+     * @brief Read an ARFF file into columns
+     * @param path File to read
+     * @param class_last The class is the last attribute; false, the first
+     * @param executor Runs the chunks; see ThreadPool
+     * @throws IOError if the file cannot be opened or mapped
+     * @throws ValidationError, naming the file and line, for a malformed
+     *         header or row, a missing value ('?'), a string, date or sparse
+     *         attribute, or a class value that was not declared
+     *
+     * The file is mapped, not read: the header is parsed on the calling thread
+     * and the data section is cut into chunks that end on line boundaries. One
+     * pass counts the rows of every chunk, so each knows where its rows start;
+     * a second parses every chunk straight into its rows of the columns. No
+     * row is ever held as a row, and no value as a string.
+     *
+     * Numeric values come out bit for bit as std::stod() then a cast to
+     * precision_t give them; see parse_float(). A nominal feature holds the
+     * index of its value in the declaration, and so does a nominal class; a
+     * numeric class must hold integers, which become the labels.
+     */
+    Dataset load_arff(const std::string& path, bool class_last, Executor& executor);
+
+    /**
+     * @brief Read an ARFF file into columns on several threads
+     * @param n_threads Threads to use, the caller's included; 0 means one per
+     *        hardware thread
+     *
+     * Same result and exceptions as the Executor overload. Starts a ThreadPool
+     * for the call, and skips it for a file of one chunk.
+     */
+    Dataset load_arff(const std::string& path, bool class_last = true, size_t n_threads = 0);
+
+    /**
+     * @brief Read a CSV file of numeric features and a class column
+     * @param path File to read
+     * @param options Delimiter, header and class position
+     * @param executor Runs the chunks; see ThreadPool
+     * @throws IOError if the file cannot be opened or mapped
+     * @throws ValidationError, naming the file and line, for a row of the
+     *         wrong width or a feature that is not a number
+     *
+     * Parsed the way load_arff() parses its data section. Without a header the
+     * features are named x0, x1, ... and the class "class". When every class
+     * value is an integer those are the labels; otherwise the values are
+     * numbered in the order they first appear, and listed in class_values.
+     * Fields may be quoted with ' or ", but a quote inside a field cannot be
+     * escaped.
+     */
+    Dataset load_csv(const std::string& path, const CsvOptions& options, Executor& executor);
+
+    /**
+     * @brief Read a CSV file on several threads
+     * @param n_threads Threads to use, the caller's included; 0 means one per
+     *        hardware thread
+     *
+     * Same result and exceptions as the Executor overload.
+     */
+    Dataset load_csv(const std::string& path, const CsvOptions& options = CsvOptions{}, size_t n_threads = 0);
+
+    /**
+     * @brief Parse [first, last) as one decimal number
+     * @param value Set to the number, rounded to precision_t, on success
+     * @return Whether the whole range was a number
+     *
+     * Gives exactly what std::stod() followed by a cast gives, for every
+     * text std::stod() accepts without overflow or underflow. Up to 19
+     * significant digits are gathered eight at a time with integer arithmetic;
+     * a mantissa below 2^53 with a power of ten up to 22 is then one exact
+     * multiplication or division in double, which is correctly rounded
+     * (Clinger's fast path). Longer mantissas, larger exponents, inf, nan and
+     * hexadecimal fall back to std::strtod().
+     */
+    bool parse_float(const char* first, const char* last, precision_t& value);
+}
+#endif
@@ -0,0 +1,156 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <streambuf>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MappedFile.h"
+#include "Exceptions.h"
+
+namespace mdlp {
+
+    namespace {
+        // An ostream's buffer over a file descriptor, so that the staging file
+        // is written through the descriptor that created it rather than
+        // reopened by name.
+        class DescriptorBuffer : public std::streambuf {
+        public:
+            explicit DescriptorBuffer(int fd_) : fd(fd_) { setp(buffer, buffer + sizeof(buffer)); }
+
+        protected:
+            int_type overflow(int_type c) override
+            {
+                if (sync() != 0) {
+                    return traits_type::eof();
+                }
+                if (!traits_type::eq_int_type(c, traits_type::eof())) {
+                    *pptr() = traits_type::to_char_type(c);
+                    pbump(1);
+                }
+                return traits_type::not_eof(c);
+            }
+            int sync() override
+            {
+                for (const char* next = pbase(); next < pptr();) {
+                    const ssize_t written = ::write(fd, next, static_cast<size_t>(pptr() - next));
+                    if (written < 0 && errno != EINTR) {
+                        return -1; // LCOV_EXCL_LINE
+                    }
+                    next += written > 0 ? written : 0;
+                }
+                setp(buffer, buffer + sizeof(buffer));
+                return 0;
+            }
+
+        private:
+            int fd;
+            char buffer[1 << 16];
+        };
+    }
+
+    MappedFile::MappedFile(const std::string& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw IOError("Cannot open " + path + ": " + std::strerror(errno));
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            const int error = errno; // LCOV_EXCL_LINE
+            ::close(fd); // LCOV_EXCL_LINE
+            throw IOError("Cannot stat " + path + ": " + std::strerror(error)); // LCOV_EXCL_LINE
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        // mmap rejects a zero length, and there is nothing to map anyway.
+        if (size_ > 0) {
+            void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                const int error = errno; // LCOV_EXCL_LINE
+                ::close(fd); // LCOV_EXCL_LINE
+                throw IOError("Cannot map " + path + ": " + std::strerror(error)); // LCOV_EXCL_LINE
+            }
+            data_ = static_cast<const unsigned char*>(mapped);
+        }
+        // The mapping keeps its own reference to the file; the descriptor is no
+        // longer needed.
+        ::close(fd);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        release();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept :
+        data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    void MappedFile::release() noexcept
+    {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<unsigned char*>(data_), size_);
+            data_ = nullptr;
+        }
+        size_ = 0;
+    }
+
+    void replace_file(const std::string& path, const std::function<void(std::ostream&)>& write)
+    {
+        // The process id keeps the names of two processes apart, the counter
+        // those of two threads. O_EXCL makes any leftover of that name, or a
+        // user's file, a collision to step past rather than a file to reuse.
+        // Mode 0666 is narrowed by the umask, as std::ofstream's would be.
+        static std::atomic<unsigned long> counter{ 0 };
+        std::string staging;
+        int fd = -1;
+        for (int attempt = 0; fd < 0; ++attempt) {
+            staging = path + ".tmp." + std::to_string(::getpid()) + "." + std::to_string(counter++);
+            fd = ::open(staging.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+            if (fd < 0 && (errno != EEXIST || attempt == 100)) {
+                throw IOError("Cannot write " + staging + ": " + std::strerror(errno));
+            }
+        }
+        bool written = false;
+        try {
+            DescriptorBuffer buffer(fd);
+            std::ostream out(&buffer);
+            write(out);
+            written = static_cast<bool>(out.flush());
+        }
+        catch (...) {
+            ::close(fd);
+            ::unlink(staging.c_str());
+            throw;
+        }
+        if (::close(fd) != 0 || !written) {
+            ::unlink(staging.c_str()); // LCOV_EXCL_LINE
+            throw IOError("Cannot write " + staging); // LCOV_EXCL_LINE
+        }
+        if (std::rename(staging.c_str(), path.c_str()) != 0) {
+            const int error = errno;
+            ::unlink(staging.c_str());
+            throw IOError("Cannot replace " + path + ": " + std::strerror(error));
+        }
+    }
+}
@@ -0,0 +1,71 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_MAPPEDFILE_H
+#define MDLP_MAPPEDFILE_H
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+
+namespace mdlp {
+    /**
+     * @brief A whole file mapped read-only into memory, unmapped on destruction
+     *
+     * Opening costs a system call and a page-table entry, not a read: pages are
+     * faulted in when first touched, so a large file "loads" in the time it takes
+     * to look at the part of it that is used.
+     *
+     * Move-only. Copying would either map the file twice or unmap it under the
+     * other copy's feet.
+     *
+     * @note POSIX only, like the rest of the build.
+     */
+    class MappedFile {
+    public:
+        MappedFile() = default;
+
+        /**
+         * @brief Map the file at path
+         * @throws IOError if it cannot be opened, inspected or mapped
+         */
+        explicit MappedFile(const std::string& path);
+
+        ~MappedFile();
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /** @brief First byte of the mapping; nullptr for an empty file */
+        inline const unsigned char* data() const { return data_; };
+        /** @brief Length of the file in bytes */
+        inline size_t size() const { return size_; };
+
+    private:
+        void release() noexcept;
+        const unsigned char* data_ = nullptr;
+        size_t size_ = 0;
+    };
+
+    /**
+     * @brief Replace the file at path with what write puts in a stream
+     * @param path File to create or replace
+     * @param write Writes the whole new contents
+     * @throws IOError if the staging file cannot be created or written, or
+     *         cannot be renamed over path
+     *
+     * The contents go to a staging file beside path, created under a name no
+     * other call uses, and are then renamed over path. A process that has path
+     * mapped keeps the old contents; two saves to the same path never share a
+     * staging file, and no existing file is ever used as one. On any failure,
+     * including an exception from write, which is rethrown, the staging file
+     * is removed and path is left as it was.
+     */
+    void replace_file(const std::string& path, const std::function<void(std::ostream&)>& write);
+}
+#endif
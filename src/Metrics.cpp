@@ -44,6 +44,9 @@ namespace mdlp {
             return 0;
 
         if (const auto cached = entropyCache.find({ start, end }); cached != entropyCache.end()) {
+            if (stats) {
+                ++stats->cache_hits;
+            }
             return cached->second;
         }
 
@@ -77,6 +80,9 @@ namespace mdlp {
             nElements++;
         }
         const precision_t ventropy = entropyFromCounts(counts, nElements);
+        if (stats) {
+            ++stats->cache_misses;
+        }
 
         entropyCache[{start, end}] = ventropy;
         return ventropy;
@@ -100,8 +106,14 @@ namespace mdlp {
     precision_t Metrics::informationGain(size_t start, size_t cut, size_t end)
     {
         if (const auto cached = igCache.find(std::make_tuple(start, cut, end)); cached != igCache.end()) {
+            if (stats) {
+                ++stats->cache_hits;
+            }
             return cached->second;
         }
+        if (stats) {
+            ++stats->cache_misses;
+        }
 
         precision_t iGain;
         precision_t entropyInterval;
@@ -8,6 +8,7 @@
 #define CCMETRICS_H
 
 #include "typesFImdlp.h"
+#include "FitStats.h"
 
 namespace mdlp {
     /**
@@ -49,6 +50,7 @@ namespace mdlp {
         indices_t indices;
         cacheEnt_t entropyCache = cacheEnt_t();
         cacheIg_t igCache = cacheIg_t();
+        FitStats* stats = nullptr;
     public:
         Metrics() = default;
 
@@ -69,6 +71,14 @@ namespace mdlp {
          */
         void setData(const labels_t& y, const indices_t& indices);
 
+        /**
+         * @brief Count cache hits and misses into stats; nullptr stops counting
+         *
+         * Not owned. CPPFImdlp points it at its FitStats for the length of a
+         * fit and clears it afterwards.
+         */
+        inline void setStats(FitStats* stats_) { stats = stats_; }
+
         /**
          * @brief Count distinct labels in [start, end)
          * @return Number of distinct labels, or 0 if the interval is out of range
@@ -4,13 +4,20 @@
 // SPDX - License - Identifier: MIT
 // ****************************************************************
 
+#include <cmath>
 #include <utility>
 #include "PKIDisc.h"
 
 namespace mdlp {
 
     PKIDisc::PKIDisc(compute_strategy_t compute_strategy_)
-        : BinDisc(), compute_strategy(compute_strategy_) {}
+        : PKIDisc(compute_strategy_, BinDiscConfig{}.sketch_error) {}
+
+    // QUANTILE from the start, not only once fit() runs, so partial_fit()
+    // accepts samples before any bin count has been chosen.
+    PKIDisc::PKIDisc(compute_strategy_t compute_strategy_, double sketch_error)
+        : BinDisc(BinDiscConfig{}.withStrategy(strategy_t::QUANTILE).withSketchError(sketch_error)),
+        compute_strategy(compute_strategy_) {}
 
     void PKIDisc::select_bins(size_t n_samples)
     {
@@ -48,4 +55,20 @@ namespace mdlp {
         select_bins(y.size());
         BinDisc::fit(std::move(X), std::move(y));
     }
+
+    void PKIDisc::merge(const PKIDisc& other)
+    {
+        if (other.compute_strategy != compute_strategy) {
+            throw InvalidParameter("Cannot merge PKIDisc models of different compute strategies");
+        }
+        merge_stream(other);
+    }
+
+    void PKIDisc::finalize()
+    {
+        if (streamed() > 0) {  // BinDisc::finalize() reports the empty stream
+            select_bins(streamed());
+        }
+        BinDisc::finalize();
+    }
 }
@@ -26,6 +26,12 @@ namespace mdlp {
          * The strategy defaults to SQRT which provides good results for most datasets.
          */
         explicit PKIDisc(compute_strategy_t compute_strategy_ = compute_strategy_t::SQRT);
+        /**
+         * @brief Construct with the rank error of a streaming fit
+         * @param sketch_error As BinDiscConfig::sketch_error
+         * @throws InvalidParameter if sketch_error is outside (0, 0.5]
+         */
+        PKIDisc(compute_strategy_t compute_strategy_, double sketch_error);
         ~PKIDisc() = default;
         /**
          * @brief Fit the discretizer to data
@@ -72,6 +78,24 @@ namespace mdlp {
         // Without this, declaring fit() above would hide BinDisc's samples-only
         // overloads from PKIDisc's users.
         using BinDisc::fit;
+
+        /**
+         * @brief Add the stream another PKIDisc has seen to this one's
+         * @throws InvalidParameter if other has a different compute strategy
+         *         or sketch_error
+         *
+         * The bin counts are not compared: each is chosen by finalize() from
+         * the merged stream's length.
+         */
+        void merge(const PKIDisc& other);
+        /**
+         * @brief Pick the bin count from the streamed sample count, then
+         *        compute the cut points as BinDisc::finalize() does
+         */
+        void finalize() override;
+
+        /** @brief Get the strategy that derives the bin count from the sample count */
+        inline compute_strategy_t getComputeStrategy() const { return compute_strategy; };
     private:
         // Picks n_bins from the sample count; shared by both fit() overloads.
         void select_bins(size_t n_samples);
@@ -0,0 +1,167 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <algorithm>
+#include <string>
+#include "PackedLabels.h"
+#include "Exceptions.h"
+
+namespace mdlp {
+
+    unsigned PackedLabels::bits_for(size_t n_bins)
+    {
+        // Labels are label_t, so 32 bits hold any of them whatever n_bins says.
+        unsigned bits = 1;
+        while (bits < 32 && (uint64_t{ 1 } << bits) < n_bins) {
+            ++bits;
+        }
+        return bits;
+    }
+
+    PackedLabels::PackedLabels(const labels_t& labels, size_t n_bins)
+    {
+        if (n_bins == 0) {
+            throw InvalidParameter("n_bins must be at least 1, got 0");
+        }
+        for (size_t i = 0; i < labels.size(); ++i) {
+            if (labels[i] < 0 || static_cast<size_t>(labels[i]) >= n_bins) {
+                throw ValidationError("Label at index " + std::to_string(i) + " is outside [0, "
+                    + std::to_string(n_bins) + "): " + std::to_string(labels[i]));
+            }
+        }
+        reset(n_bins, labels.size());
+        pack_words(0, labels.data(), labels.size());
+    }
+
+    void PackedLabels::reset(size_t n_bins, size_t n)
+    {
+        bins = n_bins;
+        n_labels = n;
+        width = bits_for(n_bins);
+        labels_per_word = 64 / width;
+        mask = (uint64_t{ 1 } << width) - 1;
+        storage.assign((n + labels_per_word - 1) / labels_per_word, 0);
+    }
+
+    namespace {
+        // With the width a compile-time constant the shifts are fixed and the
+        // loop over a word unrolls and vectorizes.
+        template <unsigned Width>
+        void pack_fixed(uint64_t* word, const label_t* labels, size_t count)
+        {
+            constexpr unsigned per_word = 64 / Width;
+            for (size_t begin = 0; begin + per_word <= count; begin += per_word, ++word) {
+                uint64_t packed = 0;
+                for (unsigned k = 0; k < per_word; ++k) {
+                    packed |= static_cast<uint64_t>(static_cast<uint32_t>(labels[begin + k])) << (k * Width);
+                }
+                *word = packed;
+            }
+        }
+
+        template <unsigned Width>
+        void unpack_fixed(const uint64_t* word, size_t n_words, label_t* out)
+        {
+            constexpr unsigned per_word = 64 / Width;
+            constexpr uint64_t mask = (uint64_t{ 1 } << Width) - 1;
+            for (size_t w = 0; w < n_words; ++w, out += per_word) {
+                for (unsigned k = 0; k < per_word; ++k) {
+                    out[k] = static_cast<label_t>((word[w] >> (k * Width)) & mask);
+                }
+            }
+        }
+    }
+
+    void PackedLabels::pack_words(size_t first_word, const label_t* labels, size_t count)
+    {
+        uint64_t* word = storage.data() + first_word;
+        // Bin counts up to 256 are the common case; wider labels pack generically.
+        size_t begin = 0;
+        switch (width) {
+            case 1: pack_fixed<1>(word, labels, count); break;
+            case 2: pack_fixed<2>(word, labels, count); break;
+            case 3: pack_fixed<3>(word, labels, count); break;
+            case 4: pack_fixed<4>(word, labels, count); break;
+            case 5: pack_fixed<5>(word, labels, count); break;
+            case 6: pack_fixed<6>(word, labels, count); break;
+            case 7: pack_fixed<7>(word, labels, count); break;
+            case 8: pack_fixed<8>(word, labels, count); break;
+            default: break;
+        }
+        if (width <= 8) {
+            begin = count / labels_per_word * labels_per_word;
+            word += begin / labels_per_word;
+        }
+        for (; begin < count; begin += labels_per_word, ++word) {
+            const size_t end = std::min(count, begin + labels_per_word);
+            uint64_t packed = 0;
+            unsigned shift = 0;
+            for (size_t i = begin; i < end; ++i, shift += width) {
+                packed |= static_cast<uint64_t>(static_cast<uint32_t>(labels[i])) << shift;
+            }
+            *word = packed;
+        }
+    }
+
+    label_t PackedLabels::at(size_t i) const
+    {
+        if (i >= n_labels) {
+            throw IndexError("Index " + std::to_string(i) + " out of bounds for "
+                + std::to_string(n_labels) + " packed labels");
+        }
+        return (*this)[i];
+    }
+
+    labels_t PackedLabels::unpack() const
+    {
+        labels_t out(n_labels);
+        unpack(0, n_labels, out.data());
+        return out;
+    }
+
+    void PackedLabels::unpack(size_t begin, size_t count, label_t* out) const
+    {
+        if (begin > n_labels || count > n_labels - begin) {
+            throw IndexError("Range [" + std::to_string(begin) + ", " + std::to_string(begin + count)
+                + ") out of bounds for " + std::to_string(n_labels) + " packed labels");
+        }
+        // Word at a time, so the division in operator[] is paid once per word.
+        size_t i = begin;
+        const auto widen = [&](size_t stop) {
+            while (i < stop) {
+                const size_t word = i / labels_per_word;
+                size_t slot = i - word * labels_per_word;
+                uint64_t bits = storage[word] >> (slot * width);
+                for (; slot < labels_per_word && i < stop; ++slot, ++i) {
+                    *out++ = static_cast<label_t>(bits & mask);
+                    bits >>= width;
+                }
+            }
+        };
+        const size_t end = begin + count;
+        if (width > 8) {
+            widen(end);
+            return;
+        }
+        // Up to a word boundary, then whole words at a fixed width.
+        widen(std::min(end, (begin + labels_per_word - 1) / labels_per_word * labels_per_word));
+        const size_t n_words = (end - i) / labels_per_word;
+        const uint64_t* word = storage.data() + i / labels_per_word;
+        switch (width) {
+            case 1: unpack_fixed<1>(word, n_words, out); break;
+            case 2: unpack_fixed<2>(word, n_words, out); break;
+            case 3: unpack_fixed<3>(word, n_words, out); break;
+            case 4: unpack_fixed<4>(word, n_words, out); break;
+            case 5: unpack_fixed<5>(word, n_words, out); break;
+            case 6: unpack_fixed<6>(word, n_words, out); break;
+            case 7: unpack_fixed<7>(word, n_words, out); break;
+            default: unpack_fixed<8>(word, n_words, out); break;
+        }
+        i += n_words * labels_per_word;
+        out += n_words * labels_per_word;
+        widen(end);
+    }
+}
@@ -0,0 +1,129 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_PACKEDLABELS_H
+#define MDLP_PACKEDLABELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include "typesFImdlp.h"
+
+namespace mdlp {
+    /**
+     * @brief Discretized labels stored in the fewest bits their bin count needs
+     *
+     * A model with k bins writes labels in [0, k), which need ceil(log2 k) bits,
+     * not the 32 of label_t: 2 bits for 3 or 4 bins, 4 bits for up to 16. Labels
+     * are packed into 64-bit words, as many whole labels per word as fit, so
+     * none straddles two words and reading one is a shift and a mask. A matrix
+     * of discretized features is one PackedLabels per column.
+     *
+     * Filled by Discretizer::transform(data, PackedLabels&), or from labels
+     * already at hand with the constructor. Read with operator[], iteration or
+     * unpack().
+     */
+    class PackedLabels {
+    public:
+        PackedLabels() = default;
+
+        /**
+         * @brief Pack labels already computed
+         * @param labels Labels in [0, n_bins)
+         * @param n_bins Number of bins the labels come from
+         * @throws InvalidParameter if n_bins is 0
+         * @throws ValidationError if a label is outside [0, n_bins)
+         */
+        PackedLabels(const labels_t& labels, size_t n_bins);
+
+        /** @brief Bits each label takes for n_bins bins; between 1 and 32 */
+        static unsigned bits_for(size_t n_bins);
+
+        inline size_t size() const { return n_labels; }
+        inline bool empty() const { return n_labels == 0; }
+        inline size_t n_bins() const { return bins; }
+        inline unsigned bits() const { return width; }
+        /** @brief Labels stored per 64-bit word */
+        inline unsigned per_word() const { return labels_per_word; }
+        /** @brief The packed storage, for writing it out or handing it over */
+        inline const std::vector<uint64_t>& words() const { return storage; }
+        /** @brief Bytes of packed storage */
+        inline size_t bytes() const { return storage.size() * sizeof(uint64_t); }
+
+        /** @brief Label i; no bounds check */
+        inline label_t operator[](size_t i) const
+        {
+            const size_t word = i / labels_per_word;
+            const unsigned shift = static_cast<unsigned>(i - word * labels_per_word) * width;
+            return static_cast<label_t>((storage[word] >> shift) & mask);
+        }
+
+        /**
+         * @brief Label i
+         * @throws IndexError if i is not below size()
+         */
+        label_t at(size_t i) const;
+
+        /** @brief Every label, widened back to label_t */
+        labels_t unpack() const;
+
+        /**
+         * @brief Widen count labels from index begin into out
+         * @throws IndexError if the range goes past size()
+         *
+         * Lets a consumer walk a large column a cache-sized block at a time
+         * without widening all of it.
+         */
+        void unpack(size_t begin, size_t count, label_t* out) const;
+
+        /** @brief Reads the labels in order; dereferences to a label_t value */
+        class const_iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = label_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = label_t;
+
+            const_iterator() = default;
+            inline label_t operator*() const { return (*labels)[index]; }
+            inline const_iterator& operator++() { ++index; return *this; }
+            inline const_iterator operator++(int) { auto copy = *this; ++index; return copy; }
+            inline bool operator==(const const_iterator& other) const { return index == other.index; }
+            inline bool operator!=(const const_iterator& other) const { return index != other.index; }
+
+        private:
+            friend class PackedLabels;
+            const_iterator(const PackedLabels* labels_, size_t index_) : labels(labels_), index(index_) {}
+            const PackedLabels* labels = nullptr;
+            size_t index = 0;
+        };
+
+        inline const_iterator begin() const { return const_iterator(this, 0); }
+        inline const_iterator end() const { return const_iterator(this, n_labels); }
+
+    private:
+        friend class Discretizer;
+
+        /** @brief Size for n labels of n_bins bins, all zero */
+        void reset(size_t n_bins, size_t n);
+
+        /**
+         * @brief Pack count trusted labels starting at the first label of a word
+         * @param first_word Word that receives labels[0]
+         */
+        void pack_words(size_t first_word, const label_t* labels, size_t count);
+
+        std::vector<uint64_t> storage;
+        size_t n_labels = 0;
+        size_t bins = 0;
+        unsigned width = 1;
+        unsigned labels_per_word = 64;
+        uint64_t mask = 1;
+    };
+}
+#endif
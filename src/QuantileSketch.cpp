@@ -0,0 +1,219 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include "QuantileSketch.h"
+#include "Exceptions.h"
+
+namespace mdlp {
+
+    namespace {
+        // k = rank_error_scale / epsilon keeps the worst rank error within
+        // epsilon: over a million samples, shuffled, sorted, reversed or
+        // sketched in parts and merged, the worst was 0.4 to 0.75 of it.
+        constexpr double rank_error_scale = 3.0;
+        constexpr double shrink = 2.0 / 3.0;
+    }
+
+    QuantileSketch::QuantileSketch(double epsilon) : levels(1), error(epsilon)
+    {
+        if (!(epsilon > 0 && epsilon <= 0.5)) {
+            throw InvalidParameter("epsilon must be in (0, 0.5], got " + detail::str(epsilon));
+        }
+        top_capacity = static_cast<size_t>(std::ceil(rank_error_scale / epsilon));
+        clear();
+    }
+
+    void QuantileSketch::clear()
+    {
+        levels.assign(1, samples_t());
+        held = 0;
+        n = 0;
+        lowest = highest = 0;
+        random_state = 0x9e3779b97f4a7c15ULL;
+        set_limit();
+    }
+
+    void QuantileSketch::set_limit()
+    {
+        // Computed once per new level, not on every compaction: std::pow per
+        // check cost more than the compactions themselves.
+        capacities.resize(levels.size());
+        limit = 0;
+        for (size_t level = 0; level < levels.size(); ++level) {
+            const auto depth = static_cast<double>(levels.size() - 1 - level);
+            capacities[level] = std::max<size_t>(2,
+                static_cast<size_t>(std::ceil(static_cast<double>(top_capacity) * std::pow(shrink, depth))));
+            limit += capacities[level];
+        }
+    }
+
+    size_t QuantileSketch::retained() const
+    {
+        return held;
+    }
+
+    bool QuantileSketch::coin()
+    {
+        // xorshift64: the sketch needs a fair bit per compaction, not quality
+        // randomness, and a fixed seed keeps results reproducible.
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        return (random_state >> 32) & 1;
+    }
+
+    void QuantileSketch::update(const precision_t* data, size_t count)
+    {
+        if (count == 0) {
+            return;
+        }
+        // Checked first, so a rejected chunk leaves the sketch as it was.
+        precision_t chunk_min = data[0];
+        precision_t chunk_max = data[0];
+        bool finite = true;
+        for (size_t i = 0; i < count; ++i) {
+            finite &= std::isfinite(data[i]);
+            chunk_min = std::min(chunk_min, data[i]);
+            chunk_max = std::max(chunk_max, data[i]);
+        }
+        if (!finite) {
+            for (size_t i = 0; i < count; ++i) {
+                if (!std::isfinite(data[i])) {
+                    throw ValidationError("Sample at index " + std::to_string(i)
+                        + " is not a finite number: " + detail::str(data[i]));
+                }
+            }
+        }
+        lowest = n == 0 ? chunk_min : std::min(lowest, chunk_min);
+        highest = n == 0 ? chunk_max : std::max(highest, chunk_max);
+        n += count;
+        // As many at a time as fit before the sketch is over its limit.
+        for (size_t i = 0; i < count;) {
+            const size_t take = std::min(count - i, held < limit ? limit - held + 1 : 1);
+            levels[0].insert(levels[0].end(), data + i, data + i + take);
+            held += take;
+            i += take;
+            compress();
+        }
+    }
+
+    void QuantileSketch::merge(const QuantileSketch& other)
+    {
+        if (other.error != error) {
+            throw InvalidParameter("Cannot merge sketches of different accuracy: epsilon "
+                + detail::str(error) + " and " + detail::str(other.error));
+        }
+        if (other.n == 0) {
+            return;
+        }
+        if (&other == this) {
+            const QuantileSketch copy(other);
+            merge(copy);
+            return;
+        }
+        if (n == 0) {
+            lowest = other.lowest;
+            highest = other.highest;
+        } else {
+            lowest = std::min(lowest, other.lowest);
+            highest = std::max(highest, other.highest);
+        }
+        n += other.n;
+        if (levels.size() < other.levels.size()) {
+            levels.resize(other.levels.size());
+            set_limit();
+        }
+        for (size_t level = 0; level < other.levels.size(); ++level) {
+            levels[level].insert(levels[level].end(), other.levels[level].begin(), other.levels[level].end());
+            held += other.levels[level].size();
+        }
+        compress();
+    }
+
+    void QuantileSketch::compress()
+    {
+        while (held > limit) {
+            for (size_t level = 0; level < levels.size(); ++level) {
+                if (levels[level].size() >= capacities[level]) {
+                    compact(level);
+                    break;
+                }
+            }
+        }
+    }
+
+    void QuantileSketch::compact(size_t level)
+    {
+        if (level + 1 == levels.size()) {
+            levels.emplace_back();
+            set_limit();
+        }
+        auto& items = levels[level];
+        auto& above = levels[level + 1];
+        std::sort(items.begin(), items.end());
+        // An odd sample out stays behind, so weight is conserved exactly.
+        const size_t keep = items.size() % 2;
+        for (size_t i = keep + (coin() ? 1 : 0); i < items.size(); i += 2) {
+            above.push_back(items[i]);
+        }
+        held -= (items.size() - keep) / 2;
+        items.resize(keep);
+    }
+
+    QuantileSketch::SortedView QuantileSketch::sorted_view() const
+    {
+        if (n == 0) {
+            throw ValidationError("Quantile sketch is empty");
+        }
+        SortedView view;
+        view.n = n;
+        view.lowest = lowest;
+        view.highest = highest;
+        view.items.reserve(held);
+        for (size_t level = 0; level < levels.size(); ++level) {
+            for (auto value : levels[level]) {
+                view.items.emplace_back(value, uint64_t{ 1 } << level);
+            }
+        }
+        std::sort(view.items.begin(), view.items.end());
+        uint64_t total = 0;
+        for (auto& item : view.items) {
+            total += item.second;
+            item.second = total;
+        }
+        return view;
+    }
+
+    precision_t QuantileSketch::SortedView::at(size_t rank) const
+    {
+        if (rank >= n) {
+            throw IndexError("Rank " + std::to_string(rank) + " out of bounds for "
+                + std::to_string(n) + " samples");
+        }
+        // The ends are known exactly; a compaction may have dropped them.
+        if (rank == 0) {
+            return lowest;
+        }
+        if (rank == n - 1) {
+            return highest;
+        }
+        // The sample whose span of ranks [previous total, total) holds rank.
+        const auto it = std::upper_bound(items.begin(), items.end(), static_cast<uint64_t>(rank),
+            [](uint64_t r, const std::pair<precision_t, uint64_t>& item) { return r < item.second; });
+        return it->first;
+    }
+
+    precision_t QuantileSketch::SortedView::quantile(double q) const
+    {
+        if (!(q >= 0 && q <= 1)) {
+            throw InvalidParameter("q must be in [0, 1], got " + detail::str(q));
+        }
+        return at(static_cast<size_t>(std::llround(q * static_cast<double>(n - 1))));
+    }
+}
@@ -0,0 +1,127 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_QUANTILESKETCH_H
+#define MDLP_QUANTILESKETCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "typesFImdlp.h"
+
+namespace mdlp {
+    /**
+     * @brief Approximate quantiles of a stream in memory that does not grow with it
+     *
+     * A KLL sketch (Karnin, Lang & Liberty, "Optimal Quantile Approximation in
+     * Streams", 2016). Samples enter level 0 with weight 1. A level that
+     * outgrows its capacity is sorted and every other sample, starting at a
+     * random one of the first two, moves up a level with twice the weight.
+     * Capacities shrink by 2/3 per level below the top, so the sketch holds
+     * about 3k samples plus two per level, whatever the stream length.
+     *
+     * The estimated rank of any value is within epsilon * count() of its true
+     * rank with high probability. Until the stream outgrows level 0 nothing is
+     * compacted and every rank is exact. min() and max() are always exact.
+     *
+     * Sketches of the same accuracy merge, so workers can each sketch a part
+     * of a stream and combine the results; the merge is as accurate as a sketch
+     * of the whole. Compaction draws from a generator with a fixed seed, so the
+     * same updates in the same order give the same sketch.
+     */
+    class QuantileSketch {
+    public:
+        static constexpr double default_error = 0.01;
+
+        /**
+         * @brief Empty sketch with the given rank error
+         * @param epsilon Normalized rank error, in (0, 0.5]; 0.01 holds about
+         *        900 samples, and halving it doubles that
+         * @throws InvalidParameter if epsilon is outside (0, 0.5]
+         */
+        explicit QuantileSketch(double epsilon = default_error);
+
+        /**
+         * @brief Add n samples
+         * @throws ValidationError if a sample is not finite; none is added then
+         */
+        void update(const precision_t* data, size_t n);
+        inline void update(const samples_t& chunk) { update(chunk.data(), chunk.size()); }
+
+        /**
+         * @brief Add every sample other has seen
+         * @throws InvalidParameter if other was built with a different epsilon
+         */
+        void merge(const QuantileSketch& other);
+
+        /** @brief Forget every sample, keeping the accuracy */
+        void clear();
+
+        inline size_t count() const { return n; }
+        inline bool empty() const { return n == 0; }
+        /** @brief Smallest sample seen; 0 when empty */
+        inline precision_t min() const { return lowest; }
+        /** @brief Largest sample seen; 0 when empty */
+        inline precision_t max() const { return highest; }
+        inline double epsilon() const { return error; }
+        /** @brief Capacity of the top level, which sets the accuracy */
+        inline size_t k() const { return top_capacity; }
+        /** @brief Samples held; bounded by about 3k + 2 per level */
+        size_t retained() const;
+
+        /**
+         * @brief The retained samples in order, ready to answer rank queries
+         *
+         * Building it sorts the retained samples once; each query is then a
+         * binary search.
+         */
+        class SortedView {
+        public:
+            /**
+             * @brief Estimated sample at 0-based rank in the sorted stream
+             * @param rank Below count(); rank 0 is min() and count() - 1 is max()
+             * @throws IndexError if rank is not below count()
+             */
+            precision_t at(size_t rank) const;
+            /** @brief Estimated q-quantile, the sample at rank q * (count() - 1) */
+            precision_t quantile(double q) const;
+            inline size_t count() const { return n; }
+
+        private:
+            friend class QuantileSketch;
+            std::vector<std::pair<precision_t, uint64_t>> items;  // value, cumulative weight
+            size_t n = 0;
+            precision_t lowest = 0;
+            precision_t highest = 0;
+        };
+
+        /** @throws ValidationError if the sketch is empty */
+        SortedView sorted_view() const;
+
+    private:
+        // Compacts the lowest level at or over capacity while the sketch holds
+        // more than it may.
+        void compress();
+        void compact(size_t level);
+        bool coin();
+
+        // Recomputes the capacities after the number of levels changes.
+        void set_limit();
+
+        std::vector<samples_t> levels;
+        std::vector<size_t> capacities;
+        double error;
+        size_t top_capacity;
+        size_t limit = 0;  // sum of the level capacities
+        size_t held = 0;
+        size_t n = 0;
+        precision_t lowest = 0;
+        precision_t highest = 0;
+        uint64_t random_state;
+    };
+}
+#endif
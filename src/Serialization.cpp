@@ -0,0 +1,255 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <cstring>
+#include <ostream>
+#include <type_traits>
+#include "Serialization.h"
+#include "CPPFImdlp.h"
+#include "BinDisc.h"
+#include "PKIDisc.h"
+#include "Exceptions.h"
+
+namespace mdlp {
+
+    namespace {
+        constexpr char MAGIC[8] = { 'F', 'I', 'M', 'D', 'L', 'P', 'M', '\n' };
+        // Reads back as 0x04030201 on a machine of the other byte order.
+        constexpr uint32_t ENDIAN_TAG = 0x01020304u;
+
+        struct FileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t endian_tag;
+            uint64_t n_models;
+            uint64_t file_size;
+        };
+
+        // Fields a kind does not use are written as zero. Fixed-width members in
+        // decreasing alignment order, so the layout has no padding to leak.
+        struct ModelRecord {
+            uint64_t min_length;      // MDLP
+            uint64_t cuts_offset;     // bytes from the start of the file
+            uint64_t n_cuts;
+            uint32_t kind;            // model_kind_t
+            uint32_t direction;       // bound_dir_t
+            int32_t max_depth;        // MDLP
+            float proposed_cuts;      // MDLP
+            int32_t n_bins;           // BIN, PKI
+            uint32_t strategy;        // strategy_t for BIN, compute_strategy_t for PKI
+        };
+
+        static_assert(sizeof(FileHeader) == 32, "model file header layout changed");
+        static_assert(sizeof(ModelRecord) == 48, "model file record layout changed");
+        static_assert(std::is_trivially_copyable<ModelRecord>::value, "records are copied as bytes");
+        static_assert(sizeof(precision_t) == 4, "cut points are stored as 32-bit floats");
+
+        ModelRecord describe(const Discretizer& model, size_t index)
+        {
+            ModelRecord record{};
+            record.direction = static_cast<uint32_t>(model.getBoundDirection());
+            // Most derived first: a PKIDisc is also a BinDisc.
+            if (const auto* pki = dynamic_cast<const PKIDisc*>(&model)) {
+                record.kind = static_cast<uint32_t>(model_kind_t::PKI);
+                record.n_bins = pki->getConfig().n_bins;
+                record.strategy = static_cast<uint32_t>(pki->getComputeStrategy());
+            } else if (const auto* bin = dynamic_cast<const BinDisc*>(&model)) {
+                const auto config = bin->getConfig();
+                record.kind = static_cast<uint32_t>(model_kind_t::BIN);
+                record.n_bins = config.n_bins;
+                record.strategy = static_cast<uint32_t>(config.strategy);
+            } else if (const auto* mdlp = dynamic_cast<const CPPFImdlp*>(&model)) {
+                const auto config = mdlp->getConfig();
+                record.kind = static_cast<uint32_t>(model_kind_t::MDLP);
+                record.min_length = config.min_length;
+                record.max_depth = config.max_depth;
+                record.proposed_cuts = config.proposed_cuts;
+            } else {
+                throw InvalidParameter("Model " + std::to_string(index)
+                    + " is not a CPPFImdlp, BinDisc or PKIDisc and cannot be saved");
+            }
+            return record;
+        }
+
+        const char* kind_name(model_kind_t kind)
+        {
+            switch (kind) {
+                case model_kind_t::MDLP: return "CPPFImdlp";
+                case model_kind_t::BIN: return "BinDisc";
+                default: return "PKIDisc";
+            }
+        }
+    }
+
+    void save_models(const std::string& path, const std::vector<const Discretizer*>& models)
+    {
+        // Everything that can be rejected is rejected before the file is touched.
+        std::vector<ModelRecord> records;
+        std::vector<cutPoints_t> cuts;
+        records.reserve(models.size());
+        cuts.reserve(models.size());
+        uint64_t offset = sizeof(FileHeader) + models.size() * sizeof(ModelRecord);
+        for (size_t i = 0; i < models.size(); ++i) {
+            if (models[i] == nullptr) {
+                throw InvalidParameter("Model " + std::to_string(i) + " is null");
+            }
+            auto record = describe(*models[i], i);
+            cuts.push_back(models[i]->getCutPoints());
+            if (cuts.back().size() < 2) {
+                throw NotFittedError("Model " + std::to_string(i) + " is not fitted and cannot be saved");
+            }
+            record.cuts_offset = offset;
+            record.n_cuts = cuts.back().size();
+            offset += record.n_cuts * sizeof(precision_t);
+            records.push_back(record);
+        }
+
+        FileHeader header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = MODEL_FORMAT_VERSION;
+        header.endian_tag = ENDIAN_TAG;
+        header.n_models = models.size();
+        header.file_size = offset;
+
+        replace_file(path, [&](std::ostream& out) {
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(records.data()),
+                static_cast<std::streamsize>(records.size() * sizeof(ModelRecord)));
+            for (const auto& model_cuts : cuts) {
+                out.write(reinterpret_cast<const char*>(model_cuts.data()),
+                    static_cast<std::streamsize>(model_cuts.size() * sizeof(precision_t)));
+            }
+            });
+    }
+
+    ModelFile ModelFile::open(const std::string& path)
+    {
+        ModelFile result;
+        result.file = MappedFile(path);
+        const unsigned char* base = result.file.data();
+        const size_t size = result.file.size();
+
+        if (size < sizeof(FileHeader)) {
+            throw ValidationError(path + " is too short to be a model file");
+        }
+        FileHeader header;
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            throw ValidationError(path + " is not a model file");
+        }
+        if (header.endian_tag != ENDIAN_TAG) {
+            throw ValidationError(path + " was written on a machine of the other byte order");
+        }
+        if (header.version != MODEL_FORMAT_VERSION) {
+            throw ValidationError(path + " has model format version " + std::to_string(header.version)
+                + ", expected " + std::to_string(MODEL_FORMAT_VERSION));
+        }
+        if (header.file_size != size) {
+            throw ValidationError(path + " is " + std::to_string(size) + " bytes, its header says "
+                + std::to_string(header.file_size) + "; it is truncated or was modified");
+        }
+        // Division, not multiplication: a forged count must not overflow the check.
+        if (header.n_models > (size - sizeof(FileHeader)) / sizeof(ModelRecord)) {
+            throw ValidationError(path + " declares more models than it can hold");
+        }
+
+        const auto* records = reinterpret_cast<const ModelRecord*>(base + sizeof(FileHeader));
+        const uint64_t data_start = sizeof(FileHeader) + header.n_models * sizeof(ModelRecord);
+        result.views.resize(header.n_models);
+        for (size_t i = 0; i < header.n_models; ++i) {
+            const ModelRecord& record = records[i];
+            const auto where = [&path, i] { return path + ": model " + std::to_string(i); };
+            if (record.kind < static_cast<uint32_t>(model_kind_t::MDLP) || record.kind > static_cast<uint32_t>(model_kind_t::PKI)) {
+                throw ValidationError(where() + " has unknown kind " + std::to_string(record.kind));
+            }
+            if (record.direction > static_cast<uint32_t>(bound_dir_t::RIGHT)) {
+                throw ValidationError(where() + " has unknown bound direction " + std::to_string(record.direction));
+            }
+            // binDiscConfig() and computeStrategy() cast these fields, so they
+            // are checked here rather than trusted there.
+            if (record.kind != static_cast<uint32_t>(model_kind_t::MDLP)) {
+                const uint32_t last = record.kind == static_cast<uint32_t>(model_kind_t::PKI)
+                    ? static_cast<uint32_t>(compute_strategy_t::SQRT) : static_cast<uint32_t>(strategy_t::QUANTILE);
+                if (record.strategy > last) {
+                    throw ValidationError(where() + " has unknown strategy " + std::to_string(record.strategy));
+                }
+                if (record.n_bins < MIN_BINS) {
+                    throw ValidationError(where() + " has " + std::to_string(record.n_bins) + " bins, fewer than "
+                        + std::to_string(MIN_BINS));
+                }
+            }
+            if (record.n_cuts < 2 || record.cuts_offset < data_start || record.cuts_offset % sizeof(precision_t) != 0
+                || record.cuts_offset > size || record.n_cuts > (size - record.cuts_offset) / sizeof(precision_t)) {
+                throw ValidationError(where() + " has cut points outside the file");
+            }
+            ModelView& view = result.views[i];
+            view.kind_ = static_cast<model_kind_t>(record.kind);
+            view.direction_ = static_cast<bound_dir_t>(record.direction);
+            view.record_ = &record;
+            view.cuts_ = reinterpret_cast<const precision_t*>(base + record.cuts_offset);
+            view.n_cuts_ = record.n_cuts;
+        }
+        return result;
+    }
+
+    const ModelView& ModelFile::at(size_t index) const
+    {
+        if (index >= views.size()) {
+            throw IndexError("Model index " + std::to_string(index) + " out of range for a file of "
+                + std::to_string(views.size()) + " models");
+        }
+        return views[index];
+    }
+
+    cutPoints_t ModelView::getCutPoints() const
+    {
+        return cutPoints_t(cuts_, cuts_ + n_cuts_);
+    }
+
+    MDLPConfig ModelView::mdlpConfig() const
+    {
+        if (kind_ != model_kind_t::MDLP) {
+            throw InvalidParameter(std::string("Model is a ") + kind_name(kind_) + ", not a CPPFImdlp");
+        }
+        const auto* record = static_cast<const ModelRecord*>(record_);
+        return MDLPConfig{}
+            .withMinLength(record->min_length)
+            .withMaxDepth(record->max_depth)
+            .withProposedCuts(record->proposed_cuts);
+    }
+
+    BinDiscConfig ModelView::binDiscConfig() const
+    {
+        if (kind_ == model_kind_t::MDLP) {
+            throw InvalidParameter("Model is a CPPFImdlp, not a BinDisc or PKIDisc");
+        }
+        const auto* record = static_cast<const ModelRecord*>(record_);
+        // A PKIDisc record keeps its compute strategy in the strategy field; its
+        // binning is always by quantile.
+        const auto strategy = kind_ == model_kind_t::PKI ? strategy_t::QUANTILE : static_cast<strategy_t>(record->strategy);
+        return BinDiscConfig{}.withNBins(record->n_bins).withStrategy(strategy);
+    }
+
+    compute_strategy_t ModelView::computeStrategy() const
+    {
+        if (kind_ != model_kind_t::PKI) {
+            throw InvalidParameter(std::string("Model is a ") + kind_name(kind_) + ", not a PKIDisc");
+        }
+        return static_cast<compute_strategy_t>(static_cast<const ModelRecord*>(record_)->strategy);
+    }
+
+    void ModelView::transform(const samples_t& data, labels_t& out) const
+    {
+        Discretizer::transform(cuts_, n_cuts_, direction_, data, out);
+    }
+
+    labels_t ModelView::transform(const samples_t& data) const
+    {
+        labels_t out;
+        transform(data, out);
+        return out;
+    }
+}
@@ -0,0 +1,178 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_SERIALIZATION_H
+#define MDLP_SERIALIZATION_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "typesFImdlp.h"
+#include "Discretizer.h"
+#include "DiscretizerConfig.h"
+#include "MappedFile.h"
+
+namespace mdlp {
+
+    /** @brief Which discretizer a stored model came from */
+    enum class model_kind_t : uint32_t {
+        MDLP = 1,  ///< CPPFImdlp
+        BIN = 2,   ///< BinDisc
+        PKI = 3    ///< PKIDisc
+    };
+
+    /**
+     * @brief Version of the on-disk model format written by save_models()
+     *
+     * Bumped on any layout change. open() rejects versions it does not know
+     * rather than guessing at them.
+     */
+    inline constexpr uint32_t MODEL_FORMAT_VERSION = 1;
+
+    /**
+     * @brief Write fitted discretizers to one binary file
+     * @param path Destination; replaced if it exists
+     * @param models Fitted CPPFImdlp, BinDisc or PKIDisc instances, in the order
+     *        ModelFile will index them
+     * @throws NotFittedError if a model has not been fitted
+     * @throws InvalidParameter if a model is of any other type
+     * @throws IOError if the file cannot be written
+     *
+     * The file is written by replace_file(), beside path and renamed over it,
+     * so a process that has the old file mapped keeps reading the old bytes
+     * instead of a half-written mix — which is what lets a scoring service swap models under load.
+     *
+     * ## Layout
+     *
+     * All integers and floats are in host byte order; a tag in the header makes a
+     * file from a machine of the other endianness fail open() cleanly.
+     *
+     * | Section | Size |
+     * |---|---|
+     * | header: magic, version, endian tag, model count, file size | 32 bytes |
+     * | one record per model: kind, direction, config, cut offset and count | 48 bytes each |
+     * | cut points of every model, back to back | 4 bytes per cut point |
+     */
+    void save_models(const std::string& path, const std::vector<const Discretizer*>& models);
+
+    /**
+     * @brief One model inside a ModelFile, read in place
+     *
+     * A view: the cut points are read from the mapping, never copied, so it is
+     * only valid while the ModelFile that produced it is alive.
+     */
+    class ModelView {
+    public:
+        /** @brief An empty view, holding no cut points; transform() throws NotFittedError */
+        ModelView() = default;
+
+        inline model_kind_t kind() const { return kind_; };
+        inline bound_dir_t getBoundDirection() const { return direction_; };
+
+        /** @brief Number of stored cut points, the first and last included */
+        inline size_t size() const { return n_cuts_; };
+        /** @brief The stored cut points, in the mapped file */
+        inline const precision_t* cuts() const { return cuts_; };
+
+        /**
+         * @brief Copy of the cut points, as the fitted model's getCutPoints() gave
+         */
+        cutPoints_t getCutPoints() const;
+
+        /**
+         * @brief Parameters of a stored CPPFImdlp
+         * @throws InvalidParameter if this model is not a CPPFImdlp
+         */
+        MDLPConfig mdlpConfig() const;
+
+        /**
+         * @brief Parameters of a stored BinDisc or PKIDisc
+         * @throws InvalidParameter if this model is a CPPFImdlp
+         *
+         * For a PKIDisc the bin count is the one its fit selected.
+         */
+        BinDiscConfig binDiscConfig() const;
+
+        /**
+         * @brief How a stored PKIDisc derived its bin count
+         * @throws InvalidParameter if this model is not a PKIDisc
+         */
+        compute_strategy_t computeStrategy() const;
+
+        /**
+         * @brief Discretize with the stored cut points
+         * @param data Input samples
+         * @param out Destination; cleared and resized to match data
+         *
+         * Same labels the saved model's transform() gives, from the same code.
+         */
+        void transform(const samples_t& data, labels_t& out) const;
+
+        /** @brief Discretize with the stored cut points, returning the labels */
+        labels_t transform(const samples_t& data) const;
+
+    private:
+        friend class ModelFile;
+        model_kind_t kind_ = model_kind_t::MDLP;
+        bound_dir_t direction_ = bound_dir_t::RIGHT;
+        const void* record_ = nullptr;
+        const precision_t* cuts_ = nullptr;
+        size_t n_cuts_ = 0;
+    };
+
+    /**
+     * @brief A model file written by save_models(), mapped into memory
+     *
+     * Opening maps the file and checks its structure — header, every record, and
+     * that every cut array lies inside the file — in one pass over the records.
+     * The cut points themselves are neither parsed nor copied: transform() reads
+     * them straight from the mapping, so opening is a few milliseconds even for a
+     * bundle of 100 000 features, and the pages are shared between processes that
+     * map the same file.
+     *
+     * @code
+     * save_models("models.bin", { &feature0, &feature1 });
+     * // ...in the scoring service:
+     * auto models = ModelFile::open("models.bin");
+     * auto labels = models[1].transform(column1);
+     * @endcode
+     *
+     * @note Structure is validated, cut values are not: a file edited by hand to
+     *       hold unsorted cut points opens, and then bins the way the edited
+     *       values say. Treat model files like code, not like input.
+     */
+    class ModelFile {
+    public:
+        /**
+         * @brief Map and validate a model file
+         * @throws IOError if the file cannot be opened or mapped
+         * @throws ValidationError if it is not a model file, is truncated, was
+         *         written with another format version or on a machine of the
+         *         other endianness, or holds an out-of-range record
+         */
+        static ModelFile open(const std::string& path);
+
+        /** @brief Number of models in the file */
+        inline size_t size() const { return views.size(); };
+
+        /**
+         * @brief The model at index, unchecked
+         */
+        inline const ModelView& operator[](size_t index) const { return views[index]; };
+
+        /**
+         * @brief The model at index
+         * @throws IndexError if index is out of range
+         */
+        const ModelView& at(size_t index) const;
+
+    private:
+        ModelFile() = default;
+        MappedFile file;
+        std::vector<ModelView> views;
+    };
+}
+#endif
@@ -0,0 +1,321 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#include "Trace.h"
+#include "Exceptions.h"
+
+namespace mdlp::trace {
+    namespace {
+        struct Event {
+            const char* name;
+            int64_t start;
+            int64_t stop;
+            int64_t begin;
+            int64_t end;
+        };
+
+        // A chunk is never moved or freed while its writer may still touch it,
+        // so a reader can walk one the writer is still filling.
+        constexpr size_t chunk_events = 1024;
+        struct Chunk {
+            Event events[chunk_events];
+            Chunk* next = nullptr;
+        };
+
+        /*
+         * Chunks no buffer holds, kept for the next one that fills up: clear()
+         * returns the chunks it no longer needs here, so a program that traces
+         * and clears in a loop stops allocating after the first round. Writers
+         * take the mutex once per chunk, not per event.
+         */
+        struct Spares {
+            std::mutex mutex;
+            std::vector<Chunk*> chunks;
+            size_t allocated = 0;              // every chunk ever made, spare or not
+
+            ~Spares()
+            {
+                for (Chunk* chunk : chunks) {
+                    delete chunk;
+                }
+            }
+
+            Chunk* take()
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (chunks.empty()) {
+                    ++allocated;
+                    return new Chunk;
+                }
+                Chunk* chunk = chunks.back();
+                chunks.pop_back();
+                chunk->next = nullptr;
+                return chunk;
+            }
+
+            // Takes back [first, stop) of a list.
+            void give(Chunk* first, const Chunk* stop)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                while (first != stop) {
+                    Chunk* next = first->next;
+                    chunks.push_back(first);
+                    first = next;
+                }
+            }
+        };
+
+        /*
+         * One thread's events. Only that thread writes, so appending takes no
+         * lock and no read-modify-write: the event, and the chunk it may have
+         * had to add, are published by the release store of recorded, and a
+         * reader that acquires recorded sees everything before it.
+         */
+        struct Buffer {
+            Buffer(int id, Spares& spares) : id(id), spares(spares), first(spares.take()), tail(first) {}
+            ~Buffer()
+            {
+                while (first != nullptr) {
+                    Chunk* next = first->next;
+                    delete first;
+                    first = next;
+                }
+            }
+            Buffer(const Buffer&) = delete;
+            Buffer& operator=(const Buffer&) = delete;
+
+            void append(const Event& event)
+            {
+                const size_t n = recorded.load(std::memory_order_relaxed);
+                if (n > 0 && n % chunk_events == 0) {
+                    tail->next = spares.take();
+                    tail = tail->next;
+                }
+                tail->events[n % chunk_events] = event;
+                recorded.store(n + 1, std::memory_order_release);
+            }
+
+            // Calls f on events [dropped, recorded) as they stood when called.
+            template <typename F>
+            void for_each(F&& f) const
+            {
+                const size_t n = recorded.load(std::memory_order_acquire);
+                const Chunk* chunk = first;
+                size_t base = first_index;  // index of chunk's first event
+                for (size_t i = dropped; i < n; ++i) {
+                    while (i >= base + chunk_events) {
+                        chunk = chunk->next;
+                        base += chunk_events;
+                    }
+                    f(chunk->events[i - base]);
+                }
+            }
+
+            // Forgets the events published so far and returns to the spares
+            // every chunk before the one holding the last of them. The writer
+            // only touches that chunk or the one it is adding after it.
+            void drop()
+            {
+                const size_t n = recorded.load(std::memory_order_acquire);
+                dropped = n;
+                if (n == 0) {
+                    return;
+                }
+                const size_t keep = (n - 1) / chunk_events * chunk_events;
+                Chunk* stop = first;
+                for (size_t base = first_index; base < keep; base += chunk_events) {
+                    stop = stop->next;
+                }
+                spares.give(first, stop);
+                first = stop;
+                first_index = keep;
+            }
+
+            const int id;                      // the tid of its events
+            Spares& spares;
+            Chunk* first;                      // oldest chunk kept; under the registry mutex
+            Chunk* tail;                       // writer only
+            std::atomic<size_t> recorded{ 0 }; // events published
+            size_t first_index = 0;            // index of first's first event; under the registry mutex
+            size_t dropped = 0;                // of those, the ones clear() forgot; under the registry mutex
+            bool retired = false;              // its thread has exited; under the registry mutex
+        };
+
+        /*
+         * Every buffer whose events are still wanted. Buffers are owned here and
+         * not by their threads, so the events of a ThreadPool worker are still
+         * there to write after the pool joined it; clear() then frees those of
+         * threads that have exited. The mutex is taken once per thread, when it
+         * first records and when it exits, and by the readers.
+         */
+        struct Registry {
+            Spares spares;                     // declared first: buffers go first
+            std::mutex mutex;
+            std::vector<std::unique_ptr<Buffer>> buffers;
+            int next_id = 1;
+
+            ~Registry()
+            {
+                // The last chance to see the events: the function-local static
+                // is destroyed at exit, after main returned.
+                if (const char* path = std::getenv("MDLP_TRACE_FILE"); path != nullptr && *path != '\0') {
+                    std::ofstream out(path, std::ios::trunc);
+                    write(out);
+                }
+            }
+
+            Buffer* add()
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                buffers.push_back(std::make_unique<Buffer>(next_id++, spares));
+                return buffers.back().get();
+            }
+
+            void retire(Buffer* buffer)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                buffer->retired = true;
+            }
+
+            void write(std::ostream& os);
+        };
+
+        Registry& registry()
+        {
+            static Registry instance;
+            return instance;
+        }
+
+        // The calling thread's buffer, retired when the thread exits.
+        struct Owner {
+            Buffer* buffer = nullptr;
+            ~Owner()
+            {
+                if (buffer != nullptr) {
+                    registry().retire(buffer);
+                }
+            }
+        };
+        thread_local Owner mine;
+
+        // Chrome wants microseconds; three decimals keep the nanoseconds
+        // without going through a locale-dependent floating-point format.
+        void micros(std::ostream& os, int64_t ns)
+        {
+            const char digits[] = { char('0' + ns / 100 % 10), char('0' + ns / 10 % 10), char('0' + ns % 10), '\0' };
+            os << ns / 1000 << '.' << digits;
+        }
+
+        void Registry::write(std::ostream& os)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            // Timestamps start at the earliest event, which keeps them short.
+            int64_t origin = std::numeric_limits<int64_t>::max();
+            for (const auto& buffer : buffers) {
+                buffer->for_each([&](const Event& e) { origin = std::min(origin, e.start); });
+            }
+            os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+            os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"fimdlp\"}}";
+            for (const auto& buffer : buffers) {
+                os << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+                    << ",\"args\":{\"name\":\"thread " << buffer->id << "\"}}";
+                buffer->for_each([&](const Event& e) {
+                    os << ",\n{\"name\":\"" << e.name << "\",\"cat\":\"mdlp\",\"ph\":\"X\",\"ts\":";
+                    micros(os, e.start - origin);
+                    os << ",\"dur\":";
+                    micros(os, e.stop - e.start);
+                    os << ",\"pid\":1,\"tid\":" << buffer->id;
+                    if (e.begin >= 0) {
+                        os << ",\"args\":{\"begin\":" << e.begin << ",\"end\":" << e.end << '}';
+                    }
+                    os << '}';
+                    });
+            }
+            os << "\n]}\n";
+        }
+    }
+
+    namespace detail {
+        int64_t now()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        void record(const char* name, int64_t start, int64_t stop, int64_t begin, int64_t end)
+        {
+            if (mine.buffer == nullptr) {
+                mine.buffer = registry().add();
+            }
+            mine.buffer->append({ name, start, stop, begin, end });
+        }
+    }
+
+    void write_chrome_trace(std::ostream& os)
+    {
+        registry().write(os);
+    }
+
+    void write_chrome_trace(const std::string& path)
+    {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) {
+            throw IOError("Cannot write " + path);
+        }
+        write_chrome_trace(out);
+        out.flush();
+        if (!out) {
+            throw IOError("Cannot write " + path); // LCOV_EXCL_LINE
+        }
+    }
+
+    size_t event_count()
+    {
+        auto& all = registry();
+        std::lock_guard<std::mutex> lock(all.mutex);
+        size_t count = 0;
+        for (const auto& buffer : all.buffers) {
+            count += buffer->recorded.load(std::memory_order_acquire) - buffer->dropped;
+        }
+        return count;
+    }
+
+    void clear()
+    {
+        auto& all = registry();
+        std::lock_guard<std::mutex> lock(all.mutex);
+        for (const auto& buffer : all.buffers) {
+            buffer->drop();
+        }
+        // An exited thread writes no more; its last chunk goes back too.
+        auto& buffers = all.buffers;
+        for (auto& buffer : buffers) {
+            if (buffer->retired) {
+                all.spares.give(buffer->first, nullptr);
+                buffer->first = nullptr;
+                buffer.reset();
+            }
+        }
+        buffers.erase(std::remove(buffers.begin(), buffers.end(), nullptr), buffers.end());
+    }
+
+    size_t chunk_count()
+    {
+        auto& spares = registry().spares;
+        std::lock_guard<std::mutex> lock(spares.mutex);
+        return spares.allocated;
+    }
+}
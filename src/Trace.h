@@ -0,0 +1,109 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_TRACE_H
+#define MDLP_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+/**
+ * @file Trace.h
+ * @brief Scoped trace zones, written out as a Chrome trace_event file
+ *
+ * Built with -DENABLE_TRACING=ON, which defines MDLP_TRACE for the library and
+ * its consumers, every MDLP_TRACE_SCOPE records one complete event when its
+ * scope ends. write_chrome_trace() writes them in the JSON that
+ * chrome://tracing and https://ui.perfetto.dev load, and a program whose
+ * environment sets MDLP_TRACE_FILE writes that file when it exits.
+ *
+ * Without MDLP_TRACE, the default, the macros expand to nothing and the
+ * functions below are inline and empty: no clock is read and no symbol of
+ * Trace.cpp is referenced from the hot paths.
+ */
+
+#ifdef MDLP_TRACE
+#define MDLP_TRACE_JOIN_(a, b) a##b
+#define MDLP_TRACE_JOIN(a, b) MDLP_TRACE_JOIN_(a, b)
+/** @brief Trace the rest of the enclosing scope; name must be a string literal */
+#define MDLP_TRACE_SCOPE(name) \
+    ::mdlp::trace::Zone MDLP_TRACE_JOIN(mdlp_trace_zone_, __LINE__)(name)
+/** @brief Same, recording the [begin, end) interval the scope works on */
+#define MDLP_TRACE_SCOPE_RANGE(name, begin, end) \
+    ::mdlp::trace::Zone MDLP_TRACE_JOIN(mdlp_trace_zone_, __LINE__)(name, begin, end)
+#else
+#define MDLP_TRACE_SCOPE(name) ((void)0)
+#define MDLP_TRACE_SCOPE_RANGE(name, begin, end) ((void)0)
+#endif
+
+namespace mdlp::trace {
+#ifdef MDLP_TRACE
+    constexpr bool enabled = true;
+
+    namespace detail {
+        /** @brief Steady-clock nanoseconds */
+        int64_t now();
+        /** @brief Append an event to the calling thread's buffer */
+        void record(const char* name, int64_t start, int64_t stop, int64_t begin, int64_t end);
+    }
+
+    /**
+     * @brief One event, from construction to destruction
+     *
+     * The name is kept as a pointer, so it must outlive the trace; the macros
+     * only pass literals. begin and end stay -1 when there is no range.
+     */
+    class Zone {
+    public:
+        explicit Zone(const char* name, int64_t begin = -1, int64_t end = -1)
+            : name(name), begin(begin), end(end), start(detail::now())
+        {
+        }
+        ~Zone() { detail::record(name, start, detail::now(), begin, end); }
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char* name;
+        int64_t begin;
+        int64_t end;
+        int64_t start;
+    };
+
+    /**
+     * @brief Write every event recorded since the last clear() as Chrome JSON
+     *
+     * Safe while other threads keep tracing: events finished after the walk
+     * over their buffer began may be left out, never half written.
+     */
+    void write_chrome_trace(std::ostream& os);
+    /** @throws IOError if the file cannot be written */
+    void write_chrome_trace(const std::string& path);
+    /** @brief Events recorded since the last clear(), on every thread */
+    size_t event_count();
+    /**
+     * @brief Forget the events recorded so far
+     *
+     * Their memory is kept for the events to come, and that of threads which
+     * have exited is released to it, so tracing and clearing in a loop does
+     * not grow the process.
+     */
+    void clear();
+    /** @brief Chunks of 1024 events allocated so far, in use or kept for reuse */
+    size_t chunk_count();
+#else
+    constexpr bool enabled = false;
+
+    inline void write_chrome_trace(std::ostream&) {}
+    inline void write_chrome_trace(const std::string&) {}
+    inline size_t event_count() { return 0; }
+    inline void clear() {}
+    inline size_t chunk_count() { return 0; }
+#endif
+}
+#endif
@@ -0,0 +1,238 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "TransformKernel.h"
+
+// The AVX2 kernel is compiled for that target function by function, so the
+// library itself still builds for, and runs on, any x86-64; the choice is made
+// at run time.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define MDLP_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace mdlp {
+    namespace detail {
+
+        namespace {
+            static_assert(sizeof(label_t) == sizeof(int32_t), "the AVX2 kernel stores labels as 32-bit lanes");
+
+            // Tree indexes are 32-bit lanes in the AVX2 kernel. Beyond this many
+            // cuts the reference search is used; no fitted model gets near it.
+            constexpr size_t MAX_TREE_CUTS = size_t{ 1 } << 30;
+
+            template <bool Right>
+            void descend(const precision_t* tree, int depth, const precision_t* data, size_t n, label_t* out)
+            {
+                const size_t leaves = size_t{ 1 } << depth;
+                for (size_t i = 0; i < n; ++i) {
+                    const precision_t x = data[i];
+                    size_t k = 1;
+                    for (int level = 0; level < depth; ++level) {
+                        k = 2 * k + (Right ? tree[k] <= x : tree[k] < x);
+                    }
+                    out[i] = static_cast<label_t>(k - leaves);
+                }
+            }
+
+#ifdef MDLP_X86_KERNELS
+            // Predicate is _CMP_LE_OQ for RIGHT and _CMP_LT_OQ for LEFT: the
+            // comparison of node against sample that sends the search right.
+            template <int Predicate>
+            __attribute__((target("avx2")))
+            void descend_avx2(const precision_t* tree, int depth, const precision_t* data, size_t n, label_t* out)
+            {
+                const __m256i leaves = _mm256_set1_epi32(1 << depth);
+                size_t i = 0;
+                for (; i + 16 <= n; i += 16) {
+                    const __m256 x0 = _mm256_loadu_ps(data + i);
+                    const __m256 x1 = _mm256_loadu_ps(data + i + 8);
+                    __m256i k0 = _mm256_set1_epi32(1);
+                    __m256i k1 = k0;
+                    for (int level = 0; level < depth; ++level) {
+                        const __m256 node0 = _mm256_i32gather_ps(tree, k0, sizeof(precision_t));
+                        const __m256 node1 = _mm256_i32gather_ps(tree, k1, sizeof(precision_t));
+                        // A true lane is all ones, -1: subtracting it adds the step right.
+                        const __m256i right0 = _mm256_castps_si256(_mm256_cmp_ps(node0, x0, Predicate));
+                        const __m256i right1 = _mm256_castps_si256(_mm256_cmp_ps(node1, x1, Predicate));
+                        k0 = _mm256_sub_epi32(_mm256_add_epi32(k0, k0), right0);
+                        k1 = _mm256_sub_epi32(_mm256_add_epi32(k1, k1), right1);
+                    }
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_sub_epi32(k0, leaves));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 8), _mm256_sub_epi32(k1, leaves));
+                }
+                descend<Predicate == _CMP_LE_OQ>(tree, depth, data + i, n - i, out + i);
+            }
+#endif
+        }
+
+        EytzingerCuts::EytzingerCuts(const precision_t* inner, size_t n_inner)
+        {
+            while ((size_t{ 1 } << depth_) - 1 < n_inner) {
+                ++depth_;
+            }
+            const size_t nodes = (size_t{ 1 } << depth_) - 1;
+            tree_.assign(nodes + 1, std::numeric_limits<precision_t>::infinity());
+            // Node k on level l is the in-order element at this position of the
+            // complete tree; past n_inner it is padding and keeps its +inf, which
+            // no finite sample reaches or passes.
+            for (int level = 0; level < depth_; ++level) {
+                const size_t first = size_t{ 1 } << level;
+                for (size_t k = first; k < 2 * first; ++k) {
+                    const size_t position = ((2 * (k - first) + 1) << (depth_ - 1 - level)) - 1;
+                    if (position < n_inner) {
+                        tree_[k] = inner[position];
+                    }
+                }
+            }
+        }
+
+        void bin_samples(const precision_t* inner, size_t n_inner, bound_dir_t direction,
+            const precision_t* data, size_t n, label_t* out)
+        {
+            if (n < n_inner || n_inner >= MAX_TREE_CUTS) {
+                bin_reference(inner, n_inner, direction, data, n, out);
+                return;
+            }
+            const EytzingerCuts cuts(inner, n_inner);
+            if (avx2_available()) {
+                bin_eytzinger_avx2(cuts, direction, data, n, out);
+            } else {
+                bin_eytzinger(cuts, direction, data, n, out); // LCOV_EXCL_LINE
+            }
+        }
+
+        UniformCuts::UniformCuts(const precision_t* inner, size_t n_inner, precision_t origin, precision_t width) :
+            origin_{ origin }, inverse_width_{ 1 / width }
+        {
+            upper_.reserve(n_inner + 1);
+            upper_.insert(upper_.end(), inner, inner + n_inner);
+            upper_.push_back(std::numeric_limits<precision_t>::infinity());
+            const precision_t* last = inner + n_inner;
+            for (size_t j = 0; j < n_inner && exact_; ++j) {
+                for (const precision_t x : { inner[j], std::nextafter(inner[j], -std::numeric_limits<precision_t>::infinity()) }) {
+                    const auto label = static_cast<size_t>(std::upper_bound(inner, last, x) - inner);
+                    const size_t g = guess(x);
+                    exact_ = exact_ && g <= label && label - g <= 1;
+                }
+            }
+        }
+
+        void bin_samples_uniform(const precision_t* inner, size_t n_inner, precision_t origin, precision_t width,
+            const precision_t* data, size_t n, label_t* out)
+        {
+            if (n < n_inner || !std::isfinite(1 / width) || n_inner >= MAX_TREE_CUTS) {
+                bin_samples(inner, n_inner, bound_dir_t::RIGHT, data, n, out);
+                return;
+            }
+            const UniformCuts cuts(inner, n_inner, origin, width);
+            if (!cuts.exact()) {
+                bin_samples(inner, n_inner, bound_dir_t::RIGHT, data, n, out);
+            } else if (avx2_available()) {
+                bin_uniform_avx2(cuts, data, n, out);
+            } else {
+                bin_uniform(cuts, data, n, out); // LCOV_EXCL_LINE
+            }
+        }
+
+        void bin_uniform(const UniformCuts& cuts, const precision_t* data, size_t n, label_t* out)
+        {
+            const precision_t* upper = cuts.upper();
+            for (size_t i = 0; i < n; ++i) {
+                const size_t g = cuts.guess(data[i]);
+                out[i] = static_cast<label_t>(g + (upper[g] <= data[i]));
+            }
+        }
+
+        void bin_reference(const precision_t* inner, size_t n_inner, bound_dir_t direction,
+            const precision_t* data, size_t n, label_t* out)
+        {
+            const precision_t* first = inner;
+            const precision_t* last = inner + n_inner;
+            auto bound = direction == bound_dir_t::LEFT ? std::lower_bound<const precision_t*, precision_t> : std::upper_bound<const precision_t*, precision_t>;
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = static_cast<label_t>(bound(first, last, data[i]) - first);
+            }
+        }
+
+        void bin_eytzinger(const EytzingerCuts& cuts, bound_dir_t direction,
+            const precision_t* data, size_t n, label_t* out)
+        {
+            if (direction == bound_dir_t::RIGHT) {
+                descend<true>(cuts.tree(), cuts.depth(), data, n, out);
+            } else {
+                descend<false>(cuts.tree(), cuts.depth(), data, n, out);
+            }
+        }
+
+#ifdef MDLP_X86_KERNELS
+        void bin_eytzinger_avx2(const EytzingerCuts& cuts, bound_dir_t direction,
+            const precision_t* data, size_t n, label_t* out)
+        {
+            if (direction == bound_dir_t::RIGHT) {
+                descend_avx2<_CMP_LE_OQ>(cuts.tree(), cuts.depth(), data, n, out);
+            } else {
+                descend_avx2<_CMP_LT_OQ>(cuts.tree(), cuts.depth(), data, n, out);
+            }
+        }
+
+        // The same operations as UniformCuts::guess(), in the same order, so
+        // the bound exact() proved holds here too.
+        __attribute__((target("avx2")))
+        void bin_uniform_avx2(const UniformCuts& cuts, const precision_t* data, size_t n, label_t* out)
+        {
+            const precision_t* upper = cuts.upper();
+            const __m256 origin = _mm256_set1_ps(cuts.origin());
+            const __m256 inverse_width = _mm256_set1_ps(cuts.inverseWidth());
+            const __m256 half = _mm256_set1_ps(0.5f);
+            const __m256 top = _mm256_set1_ps(static_cast<precision_t>(cuts.size()));
+            const __m256 zero = _mm256_setzero_ps();
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                const __m256 x0 = _mm256_loadu_ps(data + i);
+                const __m256 x1 = _mm256_loadu_ps(data + i + 8);
+                const __m256 q0 = _mm256_sub_ps(_mm256_mul_ps(_mm256_sub_ps(x0, origin), inverse_width), half);
+                const __m256 q1 = _mm256_sub_ps(_mm256_mul_ps(_mm256_sub_ps(x1, origin), inverse_width), half);
+                const __m256i g0 = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(q0, zero), top));
+                const __m256i g1 = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(q1, zero), top));
+                // A true lane is all ones, -1: subtracting it adds the step up.
+                const __m256i up0 = _mm256_castps_si256(_mm256_cmp_ps(_mm256_i32gather_ps(upper, g0, sizeof(precision_t)), x0, _CMP_LE_OQ));
+                const __m256i up1 = _mm256_castps_si256(_mm256_cmp_ps(_mm256_i32gather_ps(upper, g1, sizeof(precision_t)), x1, _CMP_LE_OQ));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_sub_epi32(g0, up0));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 8), _mm256_sub_epi32(g1, up1));
+            }
+            bin_uniform(cuts, data + i, n - i, out + i);
+        }
+
+        bool avx2_available()
+        {
+            static const bool supported = __builtin_cpu_supports("avx2");
+            return supported;
+        }
+#else
+        // LCOV_EXCL_START
+        void bin_eytzinger_avx2(const EytzingerCuts& cuts, bound_dir_t direction,
+            const precision_t* data, size_t n, label_t* out)
+        {
+            bin_eytzinger(cuts, direction, data, n, out);
+        }
+
+        void bin_uniform_avx2(const UniformCuts& cuts, const precision_t* data, size_t n, label_t* out)
+        {
+            bin_uniform(cuts, data, n, out);
+        }
+
+        bool avx2_available()
+        {
+            return false;
+        }
+        // LCOV_EXCL_STOP
+#endif
+    }
+}
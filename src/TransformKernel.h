@@ -0,0 +1,163 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_TRANSFORMKERNEL_H
+#define MDLP_TRANSFORMKERNEL_H
+
+#include <cstddef>
+#include <vector>
+#include "typesFImdlp.h"
+
+namespace mdlp {
+    namespace detail {
+        /**
+         * @brief Cut points laid out as an implicit search tree (Eytzinger order)
+         *
+         * The sorted cuts are padded with +inf to a complete tree of 2^depth - 1
+         * nodes and stored breadth first, root at index 1, the children of node
+         * k at 2k and 2k+1. A search then walks exactly depth levels with no
+         * data-dependent branch — the comparison result is added to the index —
+         * and the first levels, the ones every search visits, share a few cache
+         * lines instead of being spread across the array.
+         *
+         * Building is O(n_inner), so it is cheap enough to do once per transform
+         * call rather than keep in sync with the fitted cut points.
+         */
+        class EytzingerCuts {
+        public:
+            /**
+             * @param inner Sorted cut points, without the first and last that a
+             *        fitted model's getCutPoints() carries
+             * @param n_inner Number of inner cut points; may be zero
+             */
+            EytzingerCuts(const precision_t* inner, size_t n_inner);
+
+            /** @brief Levels of the tree; every search takes this many steps */
+            inline int depth() const { return depth_; };
+            /** @brief The nodes; index 0 is unused */
+            inline const precision_t* tree() const { return tree_.data(); };
+
+        private:
+            int depth_ = 0;
+            std::vector<precision_t> tree_;
+        };
+
+        /**
+         * @brief Equally spaced cut points, for binning by arithmetic
+         *
+         * A sample's bin is guessed as floor((x - origin) / width - 1/2), which
+         * is never above the bin the search gives and, on a sound grid, at most
+         * one below it: a single comparison against the cut above the guess then
+         * settles it. The cuts were computed in float and are not exactly on the
+         * grid, so "sound" is checked rather than assumed. Both the guess and the
+         * true bin are monotone, and the true bin is constant between cuts, so
+         * their difference is extreme at the cuts; evaluating the guess at every
+         * cut and at the float just below it proves the bound for every finite
+         * sample. exact() reports the result.
+         */
+        class UniformCuts {
+        public:
+            /**
+             * @param inner The inner cut points, as for EytzingerCuts
+             * @param n_inner Number of inner cut points
+             * @param origin Lowest edge of the grid: the first of a fitted model's
+             *        cut points, which transform() ignores
+             * @param width Distance between consecutive cut points; 1 / width must
+             *        be finite
+             */
+            UniformCuts(const precision_t* inner, size_t n_inner, precision_t origin, precision_t width);
+
+            inline size_t size() const { return upper_.size() - 1; };
+            inline precision_t origin() const { return origin_; };
+            inline precision_t inverseWidth() const { return inverse_width_; };
+            /** @brief The inner cuts and +inf: upper()[g] is the cut above bin g */
+            inline const precision_t* upper() const { return upper_.data(); };
+            /** @brief Whether one step from the guess gives the search's label everywhere */
+            inline bool exact() const { return exact_; };
+
+            /** @brief The guess for x: the search's label, or one less */
+            inline size_t guess(precision_t x) const
+            {
+                const precision_t q = (x - origin_) * inverse_width_ - 0.5f;
+                const auto top = static_cast<precision_t>(size());
+                // Clamp before converting, so a sample far off the grid cannot
+                // overflow the integer.
+                return static_cast<size_t>(q > 0 ? (q < top ? q : top) : 0);
+            }
+
+        private:
+            precision_t origin_;
+            precision_t inverse_width_;
+            std::vector<precision_t> upper_;
+            bool exact_ = true;
+        };
+
+        /**
+         * @brief Bin data[0..n) against inner[0..n_inner) into out[0..n)
+         *
+         * out[i] is the number of inner cuts below data[i] — counting a cut equal
+         * to data[i] for RIGHT and not for LEFT — exactly what the upper_bound
+         * and lower_bound searches of bin_reference() give. Picks the fastest
+         * kernel the machine has. Samples must be finite; the caller checks.
+         */
+        void bin_samples(const precision_t* inner, size_t n_inner, bound_dir_t direction,
+            const precision_t* data, size_t n, label_t* out);
+
+        /**
+         * @brief The binary-search kernel every other one must agree with
+         *
+         * Also the one used when there are fewer samples than cuts, where
+         * building the tree would cost more than it saves.
+         */
+        void bin_reference(const precision_t* inner, size_t n_inner, bound_dir_t direction,
+            const precision_t* data, size_t n, label_t* out);
+
+        /** @brief Branchless descent of the tree, one sample at a time */
+        void bin_eytzinger(const EytzingerCuts& cuts, bound_dir_t direction,
+            const precision_t* data, size_t n, label_t* out);
+
+        /**
+         * @brief Branchless descent of the tree, sixteen samples at a time
+         *
+         * Two independent vectors of eight lanes per iteration, each level one
+         * gather and one compare, so the gathers of one vector overlap the
+         * latency of the other's.
+         *
+         * @pre avx2_available(); on other machines this is bin_eytzinger().
+         */
+        void bin_eytzinger_avx2(const EytzingerCuts& cuts, bound_dir_t direction,
+            const precision_t* data, size_t n, label_t* out);
+
+        /**
+         * @brief bin_samples() for RIGHT-bounded, equally spaced cuts
+         *
+         * Bins by arithmetic with UniformCuts: one multiply, one comparison and
+         * one load per sample, whatever the number of cuts. Falls back to
+         * bin_samples() when the grid is not exact(), when 1 / width is not
+         * finite, or when there are fewer samples than cuts; the labels are
+         * those of bin_reference() either way.
+         */
+        void bin_samples_uniform(const precision_t* inner, size_t n_inner, precision_t origin, precision_t width,
+            const precision_t* data, size_t n, label_t* out);
+
+        /**
+         * @brief The arithmetic kernel, one sample at a time
+         * @pre cuts.exact()
+         */
+        void bin_uniform(const UniformCuts& cuts, const precision_t* data, size_t n, label_t* out);
+
+        /**
+         * @brief The arithmetic kernel, sixteen samples at a time
+         * @pre cuts.exact() and avx2_available(); on other machines this is
+         *      bin_uniform().
+         */
+        void bin_uniform_avx2(const UniformCuts& cuts, const precision_t* data, size_t n, label_t* out);
+
+        /** @brief Whether the running CPU can execute the AVX2 kernels */
+        bool avx2_available();
+    }
+}
+#endif
@@ -27,9 +27,16 @@ namespace mdlp {
     using cacheEnt_t = std::map<std::pair<size_t, size_t>, precision_t>;
     using cacheIg_t = std::map<std::tuple<size_t, size_t, size_t>, precision_t>;
 
-    // Strategy enums live here rather than beside the classes that use them, so
-    // Config.h can name them without including those classes and creating a
-    // cycle. Including BinDisc.h or PKIDisc.h still brings them in, as before.
+    // Enums live here rather than beside the classes that use them, so Config.h
+    // and the transform kernel can name them without including those classes
+    // and creating a cycle. Including BinDisc.h or PKIDisc.h still brings them
+    // in, as before.
+
+    /** @brief Which bin a value equal to a cut point goes to */
+    enum class bound_dir_t {
+        LEFT,  ///< The lower bin
+        RIGHT  ///< The upper bin
+    };
 
     /** @brief How BinDisc places its bin edges */
     enum class strategy_t {
@@ -37,6 +44,17 @@ namespace mdlp {
         QUANTILE  ///< Equal frequency
     };
 
+    /**
+     * @brief What one pass over a column of finite samples learns about it
+     * @see Discretizer::summarize()
+     */
+    struct ColumnSummary {
+        size_t count = 0;
+        precision_t min = 0;
+        precision_t max = 0;
+        bool sorted = true;  ///< Non-decreasing, so a sort has nothing to do
+    };
+
     /** @brief How PKIDisc derives its bin count from the sample count */
     enum class compute_strategy_t {
         LOG,  ///< log(n)
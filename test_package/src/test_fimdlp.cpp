@@ -10,7 +10,8 @@
 // package — which is exactly what was broken before 3.0.0: libtorch was declared
 // PRIVATE while <torch/torch.h> sits in a public header, so the installed headers
 // could not be compiled by anyone. This file must therefore use the real public
-// API, headers included the way a consumer includes them.
+// API, headers included the way a consumer includes them. It links only
+// fimdlp_core, so it also proves those headers compile without libtorch.
 
 #include <cstdlib>
 #include <iostream>
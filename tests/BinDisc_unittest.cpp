@@ -4,9 +4,12 @@
 // SPDX - License - Identifier: MIT
 // ****************************************************************
 
+#include <algorithm>
 #include <fstream>
 #include <string>
 #include <iostream>
+#include <numeric>
+#include <random>
 #include "gtest/gtest.h"
 #include <ArffFiles/ArffFiles.hpp>
 #include "BinDisc.h"
@@ -498,6 +501,63 @@ namespace mdlp {
         EXPECT_EQ(by_copy.transform(probe), by_move.transform(probe));
     }
 
+    // Sorted input skips the sort, in both overloads, and leaves a caller's
+    // lvalue untouched either way.
+    TEST(BinDiscMove, SortedQuantileInputMatchesUnsorted)
+    {
+        const samples_t unsorted = { 5.0f, 1.0f, 9.0f, 3.0f, 7.0f, 2.0f, 8.0f, 4.0f, 6.0f, 0.0f, 4.0f };
+        samples_t sorted = unsorted;
+        std::sort(sorted.begin(), sorted.end());
+        const samples_t sorted_before = sorted;
+
+        BinDisc from_unsorted(4, strategy_t::QUANTILE);
+        samples_t X = unsorted;
+        from_unsorted.fit(X);
+        EXPECT_EQ(unsorted, X);
+        BinDisc from_sorted(4, strategy_t::QUANTILE);
+        from_sorted.fit(sorted);
+        EXPECT_EQ(sorted_before, sorted);
+        EXPECT_EQ(from_unsorted.getCutPoints(), from_sorted.getCutPoints());
+        BinDisc from_moved(4, strategy_t::QUANTILE);
+        from_moved.fit(samples_t(sorted_before));
+        EXPECT_EQ(from_unsorted.getCutPoints(), from_moved.getCutPoints());
+    }
+
+    // Unsorted input selects the order statistics instead of sorting; the cut
+    // points must be those of the sorted input, ties and all, at any bin count.
+    TEST(BinDiscMove, SelectedQuantilesMatchTheSortedOnes)
+    {
+        std::mt19937 rng(17);
+        std::uniform_int_distribution<int> coarse(0, 500);
+        std::normal_distribution<precision_t> normal(0.0f, 1.0f);
+        for (size_t n : { size_t{ 40 }, size_t{ 1000 }, size_t{ 100000 } }) {
+            samples_t with_ties(n), continuous(n);
+            for (size_t i = 0; i < n; ++i) {
+                with_ties[i] = static_cast<precision_t>(coarse(rng)) / 4.0f;
+                continuous[i] = normal(rng);
+            }
+            for (const auto& unsorted : { with_ties, continuous }) {
+                samples_t sorted = unsorted;
+                std::sort(sorted.begin(), sorted.end());
+                for (int n_bins : { 3, 10, 100, static_cast<int>(std::sqrt(n)), static_cast<int>(n / 2) }) {
+                    if (static_cast<size_t>(n_bins) > n) {
+                        continue;
+                    }
+                    BinDisc reference(n_bins, strategy_t::QUANTILE);
+                    reference.fit(sorted);
+                    BinDisc copied(n_bins, strategy_t::QUANTILE);
+                    samples_t X = unsorted;
+                    copied.fit(X);
+                    EXPECT_EQ(unsorted, X);
+                    EXPECT_EQ(reference.getCutPoints(), copied.getCutPoints()) << n << " samples, " << n_bins << " bins";
+                    BinDisc moved(n_bins, strategy_t::QUANTILE);
+                    moved.fit(samples_t(unsorted));
+                    EXPECT_EQ(reference.getCutPoints(), moved.getCutPoints()) << n << " samples, " << n_bins << " bins";
+                }
+            }
+        }
+    }
+
     TEST(BinDiscMove, UniformMoveMatchesCopy)
     {
         const samples_t X_source = { 5.0f, 1.0f, 9.0f, 3.0f, 7.0f, 2.0f, 8.0f, 4.0f, 6.0f, 0.0f };
@@ -552,3 +612,166 @@ namespace mdlp {
         SUCCEED();
     }
 }
+
+namespace mdlp {
+    // A stream that fits in the sketch gives exactly the cut points of fit().
+    TEST(BinDiscStream, ShortStreamsMatchFit)
+    {
+        samples_t X(250);
+        for (size_t i = 0; i < X.size(); ++i) {
+            X[i] = static_cast<precision_t>((i * 101) % 97) / 4.0f;
+        }
+        BinDisc whole(7, strategy_t::QUANTILE);
+        whole.fit(X);
+        BinDisc streamed(7, strategy_t::QUANTILE);
+        for (size_t begin = 0; begin < X.size(); begin += 60) {
+            streamed.partial_fit(samples_t(X.begin() + begin, X.begin() + std::min(X.size(), begin + 60)));
+        }
+        EXPECT_TRUE(streamed.getCutPoints().empty());
+        EXPECT_EQ(X.size(), streamed.streamed());
+        streamed.finalize();
+        EXPECT_EQ(whole.getCutPoints(), streamed.getCutPoints());
+        EXPECT_EQ(whole.transform(X), streamed.transform(X));
+
+        BinDisc constant(3, strategy_t::QUANTILE);
+        constant.partial_fit(samples_t(5, 2.5f));
+        constant.finalize();
+        EXPECT_EQ(cutPoints_t({ 2.5f, 2.5f }), constant.getCutPoints());
+    }
+
+    // Long streams, split across workers and merged: every cut point's rank is
+    // within sketch_error of the exact one, in memory independent of the length.
+    TEST(BinDiscStream, LongStreamsStayWithinTheErrorBound)
+    {
+        const size_t n = 1000000;
+        samples_t X(n);
+        std::iota(X.begin(), X.end(), 0.0f);
+        std::mt19937 rng(7);
+        std::shuffle(X.begin(), X.end(), rng);
+        const auto config = BinDiscConfig{}.withNBins(20).withStrategy(strategy_t::QUANTILE).withSketchError(0.005);
+        std::vector<BinDisc> workers(4, BinDisc(config));
+        for (size_t begin = 0; begin < n; begin += 10000) {
+            workers[(begin / 10000) % workers.size()].partial_fit(samples_t(X.begin() + begin, X.begin() + begin + 10000));
+        }
+        for (size_t w = 1; w < workers.size(); ++w) {
+            workers[0].merge(workers[w]);
+        }
+        workers[0].finalize();
+        BinDisc exact(config);
+        exact.fit(X);
+        const auto streamed = workers[0].getCutPoints();
+        const auto expected = exact.getCutPoints();
+        ASSERT_EQ(expected.size(), streamed.size());
+        EXPECT_EQ(expected.front(), streamed.front());
+        EXPECT_EQ(expected.back(), streamed.back());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            // Samples are their ranks, so a value's distance is its rank error.
+            EXPECT_LE(std::fabs(expected[i] - streamed[i]), 0.005 * n) << "cut " << i;
+        }
+    }
+
+    TEST(BinDiscStream, ValidatesTheStream)
+    {
+        BinDisc uniform(4, strategy_t::UNIFORM);
+        BinDisc disc(4, strategy_t::QUANTILE);
+        EXPECT_THROW_WITH_MESSAGE(disc.finalize(), ValidationError, "Nothing to finalize: no samples were streamed");
+        disc.partial_fit(samples_t{ 1.0f, 2.0f, 3.0f });
+        EXPECT_THROW_WITH_MESSAGE(disc.finalize(), ValidationError, "Input data size (3) must be at least n_bins (4)");
+        EXPECT_THROW_WITH_MESSAGE(disc.partial_fit(samples_t({ 1.0f, std::nanf("") })), ValidationError,
+            "Sample at index 1 is not a finite number: nan");
+        EXPECT_EQ(3u, disc.streamed());
+        EXPECT_THROW_WITH_MESSAGE(disc.merge(uniform), InvalidParameter, "Cannot merge BinDisc models of different strategies");
+        EXPECT_THROW_WITH_MESSAGE(disc.merge(BinDisc(5, strategy_t::QUANTILE)), InvalidParameter,
+            "Cannot merge a BinDisc of 5 bins into one of 4");
+        EXPECT_THROW_WITH_MESSAGE(disc.merge(BinDisc(BinDiscConfig{}.withNBins(4).withStrategy(strategy_t::QUANTILE).withSketchError(0.1))),
+            InvalidParameter, "Cannot merge sketches of different accuracy: epsilon 0.01 and 0.1");
+
+        // fit() starts over, dropping what was streamed.
+        samples_t X = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+        disc.fit(X);
+        EXPECT_EQ(0u, disc.streamed());
+    }
+
+    // The running extremes are exact, so a streamed UNIFORM fit is fit()'s,
+    // whatever the chunking and however the workers are merged.
+    TEST(BinDiscStream, UniformStreamsMatchFit)
+    {
+        std::mt19937 rng(11);
+        std::normal_distribution<precision_t> normal(3.0f, 2.0f);
+        samples_t X(300000);
+        for (auto& value : X) {
+            value = normal(rng);
+        }
+        BinDisc whole(8, strategy_t::UNIFORM);
+        whole.fit(X);
+        std::vector<BinDisc> workers(3, BinDisc(8, strategy_t::UNIFORM));
+        for (size_t begin = 0, chunk = 0; begin < X.size(); begin += 7001, ++chunk) {
+            workers[chunk % workers.size()].partial_fit(samples_t(X.begin() + begin, X.begin() + std::min(X.size(), begin + 7001)));
+        }
+        workers[2].partial_fit(samples_t());
+        workers[1].merge(workers[2]);
+        workers[0].merge(workers[1]);
+        EXPECT_EQ(X.size(), workers[0].streamed());
+        workers[0].finalize();
+        EXPECT_EQ(whole.getCutPoints(), workers[0].getCutPoints());
+        EXPECT_EQ(whole.transform(X), workers[0].transform(X));
+
+        BinDisc empty(8, strategy_t::UNIFORM);
+        empty.merge(BinDisc(8, strategy_t::UNIFORM));
+        empty.merge(workers[1]);
+        empty.finalize();
+        BinDisc part(8, strategy_t::UNIFORM);
+        part.merge(workers[1]);
+        part.finalize();
+        EXPECT_EQ(part.getCutPoints(), empty.getCutPoints());
+
+        BinDisc constant(3, strategy_t::UNIFORM);
+        constant.partial_fit(samples_t(4, -1.0f));
+        constant.finalize();
+        BinDisc constant_fit(3, strategy_t::UNIFORM);
+        samples_t same(4, -1.0f);
+        constant_fit.fit(same);
+        EXPECT_EQ(constant_fit.getCutPoints(), constant.getCutPoints());
+    }
+
+    TEST(BinDiscStats, QuantileFitsCountTheirCopyAndSelection)
+    {
+        samples_t X(10000);
+        for (size_t i = 0; i < X.size(); ++i) {
+            X[i] = static_cast<precision_t>((i * 7919) % X.size());
+        }
+        BinDisc disc(4, strategy_t::QUANTILE);
+        disc.collectFitStats(true);
+        disc.fit(X);
+        const auto stats = disc.getFitStats();
+        EXPECT_GE(stats.peak_scratch_bytes, X.size() * sizeof(precision_t));
+        EXPECT_GT(stats.total_ns, 0u);
+        EXPECT_LE(stats.validate_ns + stats.sort_ns + stats.search_ns, stats.total_ns);
+        // Nothing of MDLP's search applies.
+        EXPECT_EQ(0u, stats.candidate_calls);
+        EXPECT_EQ(0u, stats.cache_misses);
+        EXPECT_EQ(0, stats.max_depth);
+
+        // Adopted, the input is reordered where it lies.
+        disc.fit(samples_t(X));
+        EXPECT_LT(disc.getFitStats().peak_scratch_bytes, X.size() * sizeof(precision_t));
+        EXPECT_GT(disc.getFitStats().peak_scratch_bytes, 0u);
+
+        disc.collectFitStats(false);
+        disc.fit(X);
+        EXPECT_EQ(0u, disc.getFitStats().total_ns);
+        EXPECT_EQ(0u, disc.getFitStats().peak_scratch_bytes);
+    }
+
+    TEST(BinDiscStats, UniformFitsNeedNoScratch)
+    {
+        samples_t X = { 1.0f, 3.0f, 2.0f, 5.0f, 4.0f };
+        BinDisc disc(3, strategy_t::UNIFORM);
+        disc.collectFitStats(true);
+        EXPECT_TRUE(disc.collectsFitStats());
+        disc.fit(std::move(X));
+        EXPECT_EQ(0u, disc.getFitStats().peak_scratch_bytes);
+        EXPECT_GT(disc.getFitStats().total_ns, 0u);
+        EXPECT_EQ(0u, disc.getFitStats().sort_ns);
+    }
+}
@@ -0,0 +1,242 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <ArffFiles/ArffFiles.hpp>
+#include "gtest/gtest.h"
+#include "ColumnDiscretizer.h"
+#include "BinDisc.h"
+#include "CPPFImdlp.h"
+
+#define EXPECT_THROW_WITH_MESSAGE(stmt, etype, whatstring) EXPECT_THROW( \
+try { \
+stmt; \
+} catch (const etype& ex) { \
+EXPECT_EQ(whatstring, std::string(ex.what())); \
+throw; \
+} \
+, etype)
+
+namespace mdlp {
+    namespace {
+        std::string data_path()
+        {
+            std::ifstream file("tests/datasets/iris.arff");
+            return file.is_open() ? "tests/datasets/" : "datasets/";
+        }
+
+        // Iris as a row-major [150, 4] tensor, the layout a dataset is built in.
+        struct Iris {
+            std::vector<samples_t> columns;
+            labels_t labels;
+            torch::Tensor X;
+            torch::Tensor y;
+            Iris()
+            {
+                ArffFiles::ArffFiles file;
+                file.load(data_path() + "iris.arff", true);
+                columns = file.getX();
+                labels = file.getY();
+                std::vector<torch::Tensor> features;
+                for (const auto& column : columns) {
+                    features.push_back(torch::tensor(column, torch::kFloat32));
+                }
+                X = torch::stack(features, 1);
+                y = torch::tensor(labels, torch::kInt32);
+            }
+        };
+
+        ColumnDiscretizer::factory_t mdlp_factory()
+        {
+            return [] { return std::make_unique<CPPFImdlp>(); };
+        }
+
+        // Runs the tasks in reverse, so a column-order assumption would show.
+        class ReverseExecutor : public Executor {
+        public:
+            size_t concurrency() const override { return 1; }
+            void run(size_t n_tasks, const std::function<void(size_t)>& task) override
+            {
+                for (size_t i = n_tasks; i-- > 0;) {
+                    task(i);
+                }
+            }
+        };
+    }
+
+    TEST(ColumnDiscretizer, FitsEachColumnLikeItsOwnModel)
+    {
+        Iris iris;
+        ColumnDiscretizer disc(mdlp_factory());
+        auto labels = disc.fit_transform_t(iris.X, iris.y, 2);
+        ASSERT_EQ(iris.columns.size(), disc.size());
+        ASSERT_EQ(torch_label_t, labels.scalar_type());
+        ASSERT_EQ(150, labels.size(0));
+        ASSERT_EQ(4, labels.size(1));
+        for (size_t j = 0; j < iris.columns.size(); ++j) {
+            CPPFImdlp alone;
+            alone.fit(iris.columns[j], iris.labels);
+            EXPECT_EQ(alone.getCutPoints(), disc.model(j).getCutPoints()) << "column " << j;
+            auto expected = alone.transform(iris.columns[j]);
+            for (size_t i = 0; i < expected.size(); ++i) {
+                ASSERT_EQ(expected[i], labels[i][j].item<int>()) << "row " << i << " column " << j;
+            }
+        }
+    }
+
+    // A column-major dataset, wide types, and any thread count give the same labels.
+    TEST(ColumnDiscretizer, LayoutTypesAndThreadsDoNotChangeTheLabels)
+    {
+        Iris iris;
+        ColumnDiscretizer disc(mdlp_factory());
+        disc.fit_t(iris.X, iris.y, 1);
+        auto expected = disc.transform_t(iris.X, 1);
+
+        auto column_major = iris.X.t().contiguous().t();
+        ASSERT_FALSE(column_major.is_contiguous());
+        ColumnDiscretizer wide(mdlp_factory());
+        ThreadPool pool(4);
+        wide.fit_t(column_major.to(torch::kFloat64), iris.y.to(torch::kInt64), pool);
+        EXPECT_TRUE(torch::equal(expected, wide.transform_t(column_major, pool)));
+        EXPECT_TRUE(torch::equal(expected, wide.transform_t(iris.X.to(torch::kFloat64), 3)));
+        ReverseExecutor reverse;
+        EXPECT_TRUE(torch::equal(expected, wide.transform_t(iris.X, reverse)));
+    }
+
+    // Many tiles of rows, a column count that leaves tiles mid-line, and a bad
+    // value in several tiles and columns: every executor agrees with the
+    // serial result, and the error is the one a column-by-column pass meets.
+    TEST(ColumnDiscretizer, RowTilesMatchTheSerialTransform)
+    {
+        const int64_t n = 20000;
+        const int64_t f = 7;
+        auto X = torch::zeros({ n, f }, torch::kFloat32);
+        auto* data = X.data_ptr<float>();
+        labels_t labels(n);
+        for (int64_t i = 0; i < n; ++i) {
+            labels[i] = static_cast<label_t>(i % 3);
+            for (int64_t j = 0; j < f; ++j) {
+                data[i * f + j] = static_cast<float>((i * (j + 3) * 7919) % 1009) + static_cast<float>(labels[i] * j);
+            }
+        }
+        auto y = torch::tensor(labels, torch::kInt32);
+        ColumnDiscretizer disc([] { return std::make_unique<BinDisc>(5, strategy_t::QUANTILE); });
+        disc.fit_t(X, y, 1);
+        auto expected = disc.transform_t(X, 1);
+        const auto* got = expected.data_ptr<label_t>();
+        for (int64_t j = 0; j < f; ++j) {
+            samples_t column(n);
+            for (int64_t i = 0; i < n; ++i) {
+                column[i] = data[i * f + j];
+            }
+            labels_t alone;
+            disc.model(j).transform(column, alone);
+            for (int64_t i = 0; i < n; ++i) {
+                ASSERT_EQ(alone[i], got[i * f + j]) << "row " << i << " column " << j;
+            }
+        }
+        ThreadPool pool(4);
+        ReverseExecutor reverse;
+        EXPECT_TRUE(torch::equal(expected, disc.transform_t(X, pool)));
+        EXPECT_TRUE(torch::equal(expected, disc.transform_t(X, 3)));
+        EXPECT_TRUE(torch::equal(expected, disc.transform_t(X, reverse)));
+        EXPECT_TRUE(torch::equal(expected, disc.transform_t(X.t().contiguous().t(), pool)));
+
+        auto bad = X.clone();
+        bad[19000][2] = std::numeric_limits<double>::quiet_NaN();
+        bad[15000][4] = std::numeric_limits<double>::infinity();
+        bad[12000][4] = std::numeric_limits<double>::infinity();
+        bad[17][5] = std::numeric_limits<double>::infinity();
+        const std::string message = "Column 2: Sample at index 19000 is not a finite number: nan";
+        EXPECT_THROW_WITH_MESSAGE(disc.transform_t(bad, pool), ValidationError, message);
+        EXPECT_THROW_WITH_MESSAGE(disc.transform_t(bad, reverse), ValidationError, message);
+        bad[19000][2] = 1.0;
+        EXPECT_THROW_WITH_MESSAGE(disc.transform_t(bad, pool), ValidationError,
+            "Column 4: Sample at index 12000 is not a finite number: inf");
+    }
+
+    TEST(ColumnDiscretizer, UnsupervisedModelsIgnoreTheLabels)
+    {
+        Iris iris;
+        ColumnDiscretizer disc([] { return std::make_unique<BinDisc>(4, strategy_t::QUANTILE); });
+        auto labels = disc.fit_transform_t(iris.X, torch::zeros({ 150 }, torch::kInt32));
+        BinDisc alone(4, strategy_t::QUANTILE);
+        alone.fit(iris.columns[0]);
+        EXPECT_EQ(alone.getCutPoints(), disc.model(0).getCutPoints());
+        EXPECT_TRUE(torch::equal(transform_t(alone, torch::tensor(iris.columns[0], torch::kFloat32)), labels.select(1, 0).contiguous()));
+    }
+
+    TEST(ColumnDiscretizer, ValidatesItsInput)
+    {
+        EXPECT_THROW_WITH_MESSAGE(ColumnDiscretizer(nullptr), InvalidParameter, "ColumnDiscretizer needs a factory");
+        ColumnDiscretizer disc(mdlp_factory());
+        auto X = torch::tensor({ {1.0f, 2.0f}, {3.0f, 4.0f}, {5.0f, 6.0f} }, torch::kFloat32);
+        auto y = torch::tensor({ 0, 1, 1 }, torch::kInt32);
+        EXPECT_THROW_WITH_MESSAGE(disc.transform_t(X), NotFittedError, "ColumnDiscretizer not fitted yet");
+        EXPECT_THROW_WITH_MESSAGE(disc.model(0), IndexError, "Column 0 out of range for 0 fitted columns");
+        EXPECT_THROW_WITH_MESSAGE(disc.fit_t(torch::tensor({ 1.0f, 2.0f }, torch::kFloat32), y), ValidationError,
+            "Only 2D tensors supported");
+        EXPECT_THROW_WITH_MESSAGE(disc.fit_t(X.to(torch::kInt32), y), ValidationError,
+            "X tensor must be Float32 or Float64 type");
+        EXPECT_THROW_WITH_MESSAGE(disc.fit_t(torch::empty({ 0, 2 }, torch::kFloat32), y), ValidationError,
+            "Tensors cannot be empty");
+        EXPECT_THROW_WITH_MESSAGE(disc.fit_t(X, y.to(torch::kFloat32)), ValidationError,
+            "y tensor must be Int32 or Int64 type");
+        EXPECT_THROW_WITH_MESSAGE(disc.fit_t(X, torch::tensor({ 0, 1 }, torch::kInt32)), ValidationError,
+            "y must have one label per row of X: got 2 labels for 3 rows");
+        ColumnDiscretizer broken([] { return std::unique_ptr<Discretizer>(); });
+        EXPECT_THROW_WITH_MESSAGE(broken.fit_t(X, y), InvalidParameter,
+            "ColumnDiscretizer factory returned no discretizer");
+
+        disc.fit_t(X, y);
+        EXPECT_EQ(2u, disc.size());
+        EXPECT_THROW_WITH_MESSAGE(disc.transform_t(torch::zeros({ 3, 3 }, torch::kFloat32)), ValidationError,
+            "X has 3 columns but the discretizer was fitted on 2");
+    }
+
+    // Whichever column runs first, the error names the lowest bad one, and a
+    // failed fit leaves the previous models in place.
+    TEST(ColumnDiscretizer, ReportsTheFirstBadColumn)
+    {
+        auto X = torch::zeros({ 4, 3 }, torch::kFloat32);
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                X[i][j] = static_cast<double>(i + j);
+            }
+        }
+        auto y = torch::tensor({ 0, 0, 1, 1 }, torch::kInt32);
+        ColumnDiscretizer disc(mdlp_factory());
+        disc.fit_t(X, y);
+        const auto cuts = disc.model(1).getCutPoints();
+
+        auto bad = X.clone();
+        bad[3][2] = std::numeric_limits<double>::infinity();
+        bad[2][1] = std::numeric_limits<double>::quiet_NaN();
+        ReverseExecutor reverse;
+        EXPECT_THROW_WITH_MESSAGE(disc.transform_t(bad, reverse), ValidationError,
+            "Column 1: Sample at index 2 is not a finite number: nan");
+        EXPECT_THROW_WITH_MESSAGE(disc.fit_t(bad, y, reverse), ValidationError,
+            "Column 1: Sample at index 2 is not a finite number: nan");
+        EXPECT_EQ(cuts, disc.model(1).getCutPoints());
+    }
+
+    // Errors other than ValidationError pass through unchanged.
+    TEST(ColumnDiscretizer, OtherModelErrorsPassThrough)
+    {
+        class Failing : public Discretizer {
+        public:
+            using Discretizer::fit;
+            void fit(samples_t&, labels_t&) override { throw std::runtime_error("fit failed"); }
+        };
+        ColumnDiscretizer disc([] { return std::make_unique<Failing>(); });
+        auto X = torch::zeros({ 2, 2 }, torch::kFloat32);
+        EXPECT_THROW_WITH_MESSAGE(disc.fit_t(X, torch::zeros({ 2 }, torch::kInt32)), std::runtime_error, "fit failed");
+        EXPECT_EQ(0u, disc.size());
+    }
+}
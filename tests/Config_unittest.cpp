@@ -78,6 +78,8 @@ namespace mdlp {
         EXPECT_THROW(MDLPConfig{}.withMaxDepth(0).validate(), InvalidParameter);
         EXPECT_THROW(MDLPConfig{}.withProposedCuts(-1.0f).validate(), InvalidParameter);
         EXPECT_THROW(BinDiscConfig{}.withNBins(2).validate(), InvalidParameter);
+        EXPECT_THROW(BinDiscConfig{}.withSketchError(0).validate(), InvalidParameter);
+        EXPECT_THROW(BinDiscConfig{}.withSketchError(0.6).validate(), InvalidParameter);
         EXPECT_NO_THROW(MDLPConfig{}.validate());
         EXPECT_NO_THROW(BinDiscConfig{}.validate());
     }
@@ -110,6 +112,9 @@ namespace mdlp {
         EXPECT_THROW(CPPFImdlp(MDLPConfig{}.withMinLength(2)), InvalidParameter);
         EXPECT_THROW(CPPFImdlp(MDLPConfig{}.withMaxDepth(0)), InvalidParameter);
         EXPECT_THROW(BinDisc(BinDiscConfig{}.withNBins(1)), InvalidParameter);
+        try { BinDisc(BinDiscConfig{}.withSketchError(-1)); FAIL(); }
+        catch (const InvalidParameter& e) { EXPECT_STREQ("sketch_error must be in (0, 0.5], got -1", e.what()); }
+        EXPECT_EQ(0.05, BinDisc(BinDiscConfig{}.withSketchError(0.05)).getConfig().sketch_error);
     }
 
     // ---- a config builds the same discretizer as the positional form ------- //
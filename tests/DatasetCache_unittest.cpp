@@ -0,0 +1,328 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+// The binary dataset cache, and fitting from the sort orders it stores.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "DatasetCache.h"
+#include "CPPFImdlp.h"
+#include "Exceptions.h"
+
+namespace mdlp {
+
+    namespace {
+        std::string data_path()
+        {
+            std::ifstream probe("datasets/iris.arff");
+            return probe.is_open() ? "datasets/" : "tests/datasets/";
+        }
+
+        std::string temp_path(const std::string& name)
+        {
+            return testing::TempDir() + "mdlp_cache_" + name;
+        }
+
+        std::vector<char> read_bytes(const std::string& path)
+        {
+            std::ifstream in(path, std::ios::binary);
+            return { std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+        }
+
+        void write_bytes(const std::string& path, const std::vector<char>& bytes)
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        }
+
+        template <typename T>
+        void poke(std::vector<char>& bytes, size_t offset, T value)
+        {
+            std::memcpy(bytes.data() + offset, &value, sizeof(value));
+        }
+
+        // Staging files replace_file() left beside path.
+        size_t leftovers(const std::string& path)
+        {
+            const std::filesystem::path target(path);
+            const auto prefix = target.filename().string() + ".tmp.";
+            size_t found = 0;
+            for (const auto& entry : std::filesystem::directory_iterator(target.parent_path())) {
+                found += entry.path().filename().string().rfind(prefix, 0) == 0 ? 1 : 0;
+            }
+            return found;
+        }
+
+        // Offsets into the format documented in DatasetCache.h.
+        constexpr size_t HEADER = 72;
+        constexpr size_t VERSION = 8;
+        constexpr size_t N_FEATURES = 24;
+        constexpr size_t LABELS_OFFSET = 56;
+
+        Dataset small()
+        {
+            Dataset dataset;
+            dataset.attributes = { { "a", "REAL" }, { "b", "{x,y}" } };
+            dataset.X = { { 3.5f, 1.0f, 3.5f, -2.0f, 1.0f }, { 1, 0, 1, 1, 0 } };
+            dataset.y = { 1, 0, 0, 1, 0 };
+            dataset.class_name = "class";
+            dataset.class_type = "{no,yes}";
+            dataset.class_values = { "no", "yes" };
+            return dataset;
+        }
+
+        void expect_same(const Dataset& expected, const Dataset& actual)
+        {
+            EXPECT_EQ(expected.attributes, actual.attributes);
+            EXPECT_EQ(expected.class_name, actual.class_name);
+            EXPECT_EQ(expected.class_type, actual.class_type);
+            EXPECT_EQ(expected.class_values, actual.class_values);
+            EXPECT_EQ(expected.y, actual.y);
+            ASSERT_EQ(expected.X.size(), actual.X.size());
+            for (size_t j = 0; j < expected.X.size(); ++j) {
+                ASSERT_EQ(expected.X[j].size(), actual.X[j].size());
+                EXPECT_EQ(0, std::memcmp(expected.X[j].data(), actual.X[j].data(), expected.X[j].size() * sizeof(precision_t)))
+                    << "feature " << j;
+            }
+        }
+    }
+
+    TEST(DatasetCache, BundledDatasetsRoundTrip)
+    {
+        const auto path = temp_path("round_trip.fimdlp");
+        ThreadPool pool(3);
+        for (const std::string name : { "glass", "iris", "kdd_JapaneseVowels", "liver-disorders" }) {
+            SCOPED_TRACE(name);
+            const auto dataset = load_arff(data_path() + name + ".arff", name != "kdd_JapaneseVowels");
+            save_dataset(path, dataset, true, pool);
+            const auto cached = DatasetFile::open(path);
+            EXPECT_EQ(dataset.size(), cached.size());
+            EXPECT_EQ(dataset.X.size(), cached.features());
+            EXPECT_TRUE(cached.hasOrder());
+            expect_same(dataset, cached.toDataset());
+            for (size_t j = 0; j < cached.features(); ++j) {
+                const auto& column = dataset.X[j];
+                EXPECT_EQ(*std::min_element(column.begin(), column.end()), cached.min(j));
+                EXPECT_EQ(*std::max_element(column.begin(), column.end()), cached.max(j));
+                EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(cached.column(j)) % 64);
+                EXPECT_EQ(CPPFImdlp::sortOrder(column, dataset.y), cached.getOrder(j));
+            }
+        }
+        std::remove(path.c_str());
+    }
+
+    // The point of storing the orders: the same cut points, without the sort.
+    TEST(DatasetCache, FitWithStoredOrderMatchesFit)
+    {
+        const auto path = temp_path("fit.fimdlp");
+        save_dataset(path, load_arff(data_path() + "mfeat-factors.arff"));
+        const auto cached = DatasetFile::open(path);
+        auto y = cached.getLabels();
+        for (size_t j = 0; j < cached.features(); j += 7) {
+            auto X = cached.getColumn(j);
+            CPPFImdlp sorted;
+            sorted.fit(X, y);
+            CPPFImdlp stored;
+            cached.fit(stored, j);
+            EXPECT_EQ(sorted.getCutPoints(), stored.getCutPoints()) << "feature " << j;
+            EXPECT_EQ(sorted.get_depth(), stored.get_depth()) << "feature " << j;
+            CPPFImdlp widened;
+            widened.fit(X, y, cached.getOrder(j));
+            EXPECT_EQ(sorted.getCutPoints(), widened.getCutPoints()) << "feature " << j;
+        }
+        std::remove(path.c_str());
+    }
+
+    TEST(DatasetCache, FitRejectsAnOrderThatIsNotTheSortOrder)
+    {
+        const auto dataset = small();
+        auto X = dataset.X[0];
+        auto y = dataset.y;
+        const auto order = CPPFImdlp::sortOrder(X, y);
+        // Ties on the value are broken by label, then by index.
+        EXPECT_EQ((indices_t{ 3, 1, 4, 2, 0 }), order);
+        CPPFImdlp disc;
+        EXPECT_THROW(disc.fit(X, y, indices_t{ 3, 1, 4, 2 }), ValidationError);
+        EXPECT_THROW(disc.fit(X, y, indices_t{ 3, 1, 4, 2, 5 }), ValidationError);
+        EXPECT_THROW(disc.fit(X, y, indices_t{ 3, 1, 4, 0, 2 }), ValidationError);
+        EXPECT_THROW(disc.fit(X, y, indices_t{ 3, 4, 1, 2, 0 }), ValidationError);
+        EXPECT_THROW(disc.fit(X, y, indices_t{ 3, 1, 1, 2, 0 }), ValidationError);
+        EXPECT_THROW(CPPFImdlp::sortOrder(X, labels_t{ 1, 0 }), ValidationError);
+        disc.fit(X, y, order);
+        CPPFImdlp plain;
+        plain.fit(X, y);
+        EXPECT_EQ(plain.getCutPoints(), disc.getCutPoints());
+
+        // The 32-bit form also checks the range stored with the order.
+        const std::vector<uint32_t> narrow(order.begin(), order.end());
+        CPPFImdlp stored;
+        stored.fit(X, y, narrow.data(), narrow.size(), -2.0f, 3.5f);
+        EXPECT_EQ(plain.getCutPoints(), stored.getCutPoints());
+        EXPECT_THROW(stored.fit(X, y, narrow.data(), narrow.size(), -2.0f, 4.0f), ValidationError);
+        EXPECT_THROW(stored.fit(X, y, narrow.data(), narrow.size() - 1, -2.0f, 3.5f), ValidationError);
+
+        // Non-finite values are named as a plain fit names them.
+        auto nan = X;
+        nan[1] = std::numeric_limits<precision_t>::quiet_NaN();
+        auto inf = X;
+        inf[0] = std::numeric_limits<precision_t>::infinity();
+        for (const auto& bad : { nan, inf }) {
+            std::string expected;
+            try {
+                plain.fit(samples_t(bad), labels_t(y));
+            }
+            catch (const ValidationError& e) {
+                expected = e.what();
+            }
+            ASSERT_FALSE(expected.empty());
+            try {
+                disc.fit(bad, y, order);
+                ADD_FAILURE() << "no exception";
+            }
+            catch (const ValidationError& e) {
+                EXPECT_EQ(expected, e.what());
+            }
+        }
+    }
+
+    TEST(DatasetCache, WithoutOrders)
+    {
+        const auto path = temp_path("no_order.fimdlp");
+        const auto dataset = small();
+        save_dataset(path, dataset, false);
+        const auto cached = DatasetFile::open(path);
+        EXPECT_FALSE(cached.hasOrder());
+        EXPECT_EQ(nullptr, cached.order(0));
+        EXPECT_THROW(cached.getOrder(0), InvalidParameter);
+        CPPFImdlp disc;
+        EXPECT_THROW(cached.fit(disc, 0), InvalidParameter);
+        expect_same(dataset, cached.toDataset());
+        EXPECT_EQ(-2.0f, cached.min(0));
+        EXPECT_EQ(3.5f, cached.max(0));
+        EXPECT_EQ(1, cached.labels()[0]);
+        EXPECT_THROW(cached.column(2), IndexError);
+        EXPECT_THROW(cached.order(2), IndexError);
+        EXPECT_THROW(cached.min(2), IndexError);
+        EXPECT_THROW(cached.getColumn(2), IndexError);
+        // Smaller than the same data with its orders.
+        const auto without = read_bytes(path).size();
+        save_dataset(path, dataset, true, size_t{ 1 });
+        EXPECT_LT(without, read_bytes(path).size());
+        std::remove(path.c_str());
+    }
+
+    TEST(DatasetCache, EmptyDatasetRoundTrips)
+    {
+        const auto path = temp_path("empty.fimdlp");
+        Dataset dataset;
+        dataset.class_name = "c";
+        save_dataset(path, dataset);
+        const auto cached = DatasetFile::open(path);
+        EXPECT_EQ(0u, cached.size());
+        EXPECT_EQ(0u, cached.features());
+        expect_same(dataset, cached.toDataset());
+        std::remove(path.c_str());
+    }
+
+    TEST(DatasetCache, SaveRejectsWhatItCannotStore)
+    {
+        const auto path = temp_path("rejected.fimdlp");
+        auto ragged = small();
+        ragged.X[1].pop_back();
+        EXPECT_THROW(save_dataset(path, ragged), ValidationError);
+        auto unnamed = small();
+        unnamed.attributes.pop_back();
+        EXPECT_THROW(save_dataset(path, unnamed), ValidationError);
+        auto infinite = small();
+        infinite.X[1][2] = std::numeric_limits<precision_t>::infinity();
+        EXPECT_THROW(save_dataset(path, infinite, false), ValidationError);
+        // Nothing was written, not even a staging file.
+        EXPECT_FALSE(std::ifstream(path).is_open());
+        EXPECT_EQ(0u, leftovers(path));
+        EXPECT_THROW(save_dataset(testing::TempDir() + "no/such/dir/x.fimdlp", small()), IOError);
+        EXPECT_THROW(DatasetFile::open(path), IOError);
+    }
+
+    // Saves to one path at once each stage under a name of their own, and a
+    // file that happens to be called <path>.tmp is not theirs to overwrite.
+    TEST(DatasetCache, SavesStageUnderANameOfTheirOwn)
+    {
+        const auto path = temp_path("staging.fimdlp");
+        write_bytes(path + ".tmp", { 'm', 'i', 'n', 'e' });
+        const auto dataset = small();
+        std::vector<std::thread> writers;
+        for (int t = 0; t < 4; ++t) {
+            writers.emplace_back([&path, &dataset] {
+                for (int i = 0; i < 25; ++i) {
+                    save_dataset(path, dataset, true, size_t{ 1 });
+                }
+                });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        expect_same(dataset, DatasetFile::open(path).toDataset());
+        EXPECT_EQ((std::vector<char>{ 'm', 'i', 'n', 'e' }), read_bytes(path + ".tmp"));
+        EXPECT_EQ(0u, leftovers(path));
+
+        // A writer that throws leaves the old file and no staging file behind.
+        const auto before = read_bytes(path);
+        EXPECT_THROW(replace_file(path, [](std::ostream& out) {
+            out << "partial";
+            throw std::runtime_error("writer failed");
+            }), std::runtime_error);
+        EXPECT_EQ(before, read_bytes(path));
+        EXPECT_EQ(0u, leftovers(path));
+        std::remove(path.c_str());
+        std::remove((path + ".tmp").c_str());
+    }
+
+    TEST(DatasetCache, OpenRejectsMalformedFiles)
+    {
+        const auto path = temp_path("good.fimdlp");
+        const auto bad = temp_path("bad.fimdlp");
+        save_dataset(path, small());
+        const auto good = read_bytes(path);
+        const auto rejects = [&bad](const std::vector<char>& bytes) {
+            write_bytes(bad, bytes);
+            EXPECT_THROW(DatasetFile::open(bad), ValidationError);
+            };
+        rejects(std::vector<char>(good.begin(), good.begin() + 40));
+        rejects(std::vector<char>(good.begin(), good.end() - 4));
+        auto copy = good;
+        copy[0] = 'X';
+        rejects(copy);
+        copy = good;
+        poke<uint32_t>(copy, VERSION, DATASET_FORMAT_VERSION + 1);
+        rejects(copy);
+        copy = good;
+        poke<uint32_t>(copy, VERSION + 4, 0x04030201u);
+        rejects(copy);
+        copy = good;
+        poke<uint64_t>(copy, N_FEATURES, uint64_t{ 1 } << 60);
+        rejects(copy);
+        copy = good;
+        poke<uint64_t>(copy, LABELS_OFFSET, good.size());
+        rejects(copy);
+        copy = good;
+        poke<uint64_t>(copy, HEADER, 3);
+        rejects(copy);
+        std::remove(path.c_str());
+        std::remove(bad.c_str());
+    }
+}
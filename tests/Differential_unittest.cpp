@@ -0,0 +1,299 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "BinDisc.h"
+#include "CPPFImdlp.h"
+#include "Executor.h"
+#include "PackedLabels.h"
+#include "ReferenceMDLP.h"
+#include "TransformKernel.h"
+#include "Workload.h"
+
+// The library against tests/ReferenceMDLP.cpp on generated inputs. Cut points
+// are compared as bytes, not as floats: an optimization that changes a cut in
+// its last bit, or turns 0 into -0, fails here. Every configuration comes from
+// a fixed seed and is named in the failure message, so a failure reproduces
+// with --gtest_filter alone.
+namespace mdlp {
+    namespace {
+        struct Config {
+            size_t n;
+            int k;
+            double duplicates;  // share of samples repeating an earlier value
+            size_t min_length;
+            int max_depth;
+            float proposed_cuts;
+            int order;          // 0 as drawn, 1 sorted by X only, 2 sorted by X then y
+            bool sparse_labels; // classes 0, 2, 4 ... leaving empty ones between
+            unsigned seed;
+
+            std::string describe() const
+            {
+                std::ostringstream os;
+                os << "n=" << n << " k=" << k << " duplicates=" << duplicates << " min_length=" << min_length
+                    << " max_depth=" << max_depth << " proposed_cuts=" << proposed_cuts << " order=" << order
+                    << " sparse=" << sparse_labels << " seed=" << seed;
+                return os.str();
+            }
+        };
+
+        // Only the engine's raw output is used: it is specified to the bit,
+        // the standard distributions are not.
+        template <typename T>
+        const T& pick(std::mt19937& rng, const std::vector<T>& from)
+        {
+            return from[rng() % from.size()];
+        }
+
+        // Drawn once from a fixed seed: 240 configurations over the values the
+        // optimized paths branch on.
+        std::vector<Config> configurations()
+        {
+            const std::vector<size_t> sizes = { 3, 5, 10, 50, 137, 500, 1000, 2000, 4000 };
+            const std::vector<double> duplicates = { 0.0, 0.1, 0.3, 0.5, 0.7, 0.9, 0.99 };
+            const std::vector<size_t> min_lengths = { 3, 3, 5, 20 };
+            const std::vector<int> max_depths = { 1, 2, 4, std::numeric_limits<int>::max(), std::numeric_limits<int>::max() };
+            const std::vector<float> proposed = { 0.0f, 0.0f, 0.01f, 0.05f, 0.5f, 1.0f, 2.0f, 3.0f, 7.0f };
+            std::mt19937 rng(20260419u);
+            std::vector<Config> configs;
+            for (unsigned i = 0; i < 240; ++i) {
+                Config c;
+                c.n = pick(rng, sizes);
+                c.k = 2 + static_cast<int>(rng() % 5);
+                c.duplicates = pick(rng, duplicates);
+                c.min_length = pick(rng, min_lengths);
+                c.max_depth = pick(rng, max_depths);
+                c.proposed_cuts = std::min(pick(rng, proposed), static_cast<float>(c.n));
+                c.order = static_cast<int>(rng() % 3);
+                c.sparse_labels = rng() % 5 == 0;
+                c.seed = 1000u + i;
+                configs.push_back(c);
+            }
+            return configs;
+        }
+
+        struct Data {
+            samples_t X;
+            labels_t y;
+        };
+
+        // Values are drawn from a pool of distinct ones, so the duplicate share
+        // is what the configuration asks. Classes follow the value's rank in the
+        // pool with one label in four replaced at random, so that there are
+        // cuts to find and noise for the criterion to reject.
+        Data generate(const Config& c)
+        {
+            std::mt19937 rng(c.seed);
+            const size_t distinct = std::max<size_t>(1, static_cast<size_t>(static_cast<double>(c.n) * (1.0 - c.duplicates)));
+            std::vector<precision_t> pool(distinct);
+            for (auto& value : pool) {
+                value = static_cast<precision_t>(static_cast<int>(rng() % 2000001) - 1000000) / 1000.0f;
+            }
+            std::sort(pool.begin(), pool.end());
+            Data d;
+            for (size_t i = 0; i < c.n; ++i) {
+                const size_t rank = rng() % distinct;
+                label_t label = static_cast<label_t>(rank * static_cast<size_t>(c.k) / distinct);
+                if (rng() % 4 == 0) {
+                    label = static_cast<label_t>(rng() % static_cast<unsigned>(c.k));
+                }
+                d.X.push_back(pool[rank]);
+                d.y.push_back(c.sparse_labels ? 2 * label : label);
+            }
+            if (c.order > 0) {
+                std::vector<size_t> order(c.n);
+                std::iota(order.begin(), order.end(), 0);
+                std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+                    return c.order == 2 && d.X[a] == d.X[b] ? d.y[a] < d.y[b] : d.X[a] < d.X[b];
+                    });
+                Data sorted;
+                for (const auto i : order) {
+                    sorted.X.push_back(d.X[i]);
+                    sorted.y.push_back(d.y[i]);
+                }
+                d = sorted;
+            }
+            return d;
+        }
+
+        std::vector<uint32_t> bits(const cutPoints_t& cuts)
+        {
+            std::vector<uint32_t> out(cuts.size());
+            std::memcpy(out.data(), cuts.data(), cuts.size() * sizeof(precision_t));
+            return out;
+        }
+
+        // Every sample, every cut and a value either side of each: the
+        // boundaries are where a transform kernel goes wrong.
+        samples_t probes(const samples_t& X, const cutPoints_t& cuts)
+        {
+            samples_t probe = X;
+            for (const auto cut : cuts) {
+                probe.push_back(cut);
+                probe.push_back(std::nextafter(cut, -std::numeric_limits<precision_t>::infinity()));
+                probe.push_back(std::nextafter(cut, std::numeric_limits<precision_t>::infinity()));
+            }
+            return probe;
+        }
+    }
+
+    class Differential : public ::testing::TestWithParam<Config> {
+    };
+
+    TEST_P(Differential, FitMatchesTheReferenceByteForByte)
+    {
+        const auto& c = GetParam();
+        SCOPED_TRACE(c.describe());
+        auto data = generate(c);
+        const auto expected = reference::fit(data.X, data.y, c.min_length, c.max_depth, c.proposed_cuts);
+
+        CPPFImdlp disc(c.min_length, c.max_depth, c.proposed_cuts);
+        disc.collectFitStats(true);
+        disc.fit(data.X, data.y);
+        EXPECT_EQ(bits(expected.cuts), bits(disc.getCutPoints()));
+        EXPECT_EQ(expected.depth, disc.getFitStats().max_depth);
+
+        // The move overload hands the buffers over instead of copying them.
+        CPPFImdlp moved(c.min_length, c.max_depth, c.proposed_cuts);
+        auto X = data.X;
+        auto y = data.y;
+        moved.fit(std::move(X), std::move(y));
+        EXPECT_EQ(bits(expected.cuts), bits(moved.getCutPoints()));
+
+        // A given order skips the sort and, with the stored range, the
+        // summary; the cuts must not notice.
+        const auto order = CPPFImdlp::sortOrder(data.X, data.y);
+        CPPFImdlp ordered(c.min_length, c.max_depth, c.proposed_cuts);
+        ordered.fit(data.X, data.y, order);
+        EXPECT_EQ(bits(expected.cuts), bits(ordered.getCutPoints()));
+        const std::vector<uint32_t> narrow(order.begin(), order.end());
+        const auto range = std::minmax_element(data.X.begin(), data.X.end());
+        CPPFImdlp stored(c.min_length, c.max_depth, c.proposed_cuts);
+        stored.fit(data.X, data.y, narrow.data(), narrow.size(), *range.first, *range.second);
+        EXPECT_EQ(bits(expected.cuts), bits(stored.getCutPoints()));
+
+        const auto probe = probes(data.X, expected.cuts);
+        EXPECT_EQ(reference::transform(expected.cuts, probe), disc.transform(probe));
+    }
+
+    // The arithmetic kernel of the UNIFORM strategy against the binary search,
+    // on the probes above and either side of each cut of its own grid.
+    TEST_P(Differential, UniformKernelMatchesTheReference)
+    {
+        const auto& c = GetParam();
+        SCOPED_TRACE(c.describe());
+        const auto data = generate(c);
+        const auto expected = reference::fit(data.X, data.y, c.min_length, c.max_depth, c.proposed_cuts);
+        const int n_bins = static_cast<int>(std::min<size_t>(c.n, 3 + c.seed % 30));
+        BinDisc uniform(n_bins, strategy_t::UNIFORM);
+        uniform.fit(samples_t(data.X));
+        const auto grid = uniform.getCutPoints();
+        const auto probe = probes(probes(data.X, expected.cuts), grid);
+        labels_t search(probe.size());
+        detail::bin_reference(grid.data() + 1, grid.size() - 2, bound_dir_t::RIGHT, probe.data(), probe.size(), search.data());
+        EXPECT_EQ(search, uniform.transform(probe));
+
+        // bin_samples_uniform() falls back to the search without a word, so
+        // the kernels are also called directly.
+        const auto range = std::minmax_element(data.X.begin(), data.X.end());
+        if (*range.first == *range.second) {
+            return;
+        }
+        const detail::UniformCuts arithmetic(grid.data() + 1, grid.size() - 2, *range.first,
+            (*range.second - *range.first) / static_cast<precision_t>(n_bins));
+        ASSERT_TRUE(arithmetic.exact());
+        labels_t scalar(probe.size());
+        detail::bin_uniform(arithmetic, probe.data(), probe.size(), scalar.data());
+        EXPECT_EQ(search, scalar);
+        if (detail::avx2_available()) {
+            labels_t wide(probe.size());
+            detail::bin_uniform_avx2(arithmetic, probe.data(), probe.size(), wide.data());
+            EXPECT_EQ(search, wide);
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Generated, Differential, ::testing::ValuesIn(configurations()),
+        [](const ::testing::TestParamInfo<Config>& info) { return "config" + std::to_string(info.index); });
+
+    // The shapes the benchmarks sweep: many classes, imbalance, heavy tails,
+    // integer values, two modes, labels that barely follow the values.
+    TEST(DifferentialWorkloads, EveryShapeMatchesTheReference)
+    {
+        using bench::Distribution;
+        const auto base = bench::WorkloadSpec{}.withN(3000).withSeed(20260419u);
+        const std::vector<bench::WorkloadSpec> specs = {
+            base,
+            bench::WorkloadSpec(base).withClasses(2),
+            bench::WorkloadSpec(base).withClasses(32),
+            bench::WorkloadSpec(base).withClasses(8).withImbalance(50),
+            bench::WorkloadSpec(base).withDuplicates(0.95),
+            bench::WorkloadSpec(base).withDistribution(Distribution::uniform),
+            bench::WorkloadSpec(base).withDistribution(Distribution::heavy_tailed),
+            bench::WorkloadSpec(base).withDistribution(Distribution::integer).withClasses(6),
+            bench::WorkloadSpec(base).withDistribution(Distribution::bimodal).withClasses(5),
+            bench::WorkloadSpec(base).withCorrelation(0.3),
+        };
+        for (const auto& spec : specs) {
+            SCOPED_TRACE(bench::describe(spec));
+            auto data = bench::generate(spec);
+            const auto expected = reference::fit(data.X, data.y, 3, std::numeric_limits<int>::max(), 0);
+            CPPFImdlp disc;
+            disc.collectFitStats(true);
+            disc.fit(data.X, data.y);
+            EXPECT_EQ(bits(expected.cuts), bits(disc.getCutPoints()));
+            EXPECT_EQ(expected.depth, disc.getFitStats().max_depth);
+            const auto probe = probes(data.X, expected.cuts);
+            EXPECT_EQ(reference::transform(expected.cuts, probe), disc.transform(probe));
+        }
+    }
+
+    // The transform paths that only engage on large inputs, on models fitted
+    // above: three chunks of the parallel transform, and the narrow and packed
+    // labels.
+    TEST(DifferentialTransform, EveryPathMatchesTheReference)
+    {
+        const auto configs = configurations();
+        ThreadPool pool(3);
+        for (size_t i = 0; i < configs.size(); i += 20) {
+            const auto& c = configs[i];
+            SCOPED_TRACE(c.describe());
+            auto data = generate(c);
+            CPPFImdlp disc(c.min_length, c.max_depth, c.proposed_cuts);
+            disc.fit(data.X, data.y);
+            const auto cuts = disc.getCutPoints();
+            auto probe = probes(data.X, cuts);
+            while (probe.size() < 3 * 65536) {
+                probe.insert(probe.end(), probe.begin(), probe.begin() + static_cast<long>(std::min(probe.size(), 3 * 65536 - probe.size())));
+            }
+            const auto expected = reference::transform(cuts, probe);
+
+            labels_t parallel;
+            disc.transform(probe, parallel, pool);
+            EXPECT_EQ(expected, parallel);
+
+            if (disc.getBins() <= 256) {
+                std::vector<uint8_t> narrow;
+                disc.transform(probe, narrow);
+                EXPECT_TRUE(std::equal(expected.begin(), expected.end(), narrow.begin(), narrow.end()));
+            }
+
+            PackedLabels packed;
+            disc.transform(probe, packed);
+            EXPECT_EQ(expected, packed.unpack());
+        }
+    }
+}
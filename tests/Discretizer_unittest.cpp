@@ -4,14 +4,18 @@
 // SPDX - License - Identifier: MIT
 // ****************************************************************
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
 #include <string>
 #include <iostream>
 #include <ArffFiles/ArffFiles.hpp>
 #include "gtest/gtest.h"
 #include "Discretizer.h"
+#include "DiscretizerTorch.h"
 #include "BinDisc.h"
 #include "CPPFImdlp.h"
+#include "PackedLabels.h"
 
 #define EXPECT_THROW_WITH_MESSAGE(stmt, etype, whatstring) EXPECT_THROW( \
 try { \
@@ -78,8 +82,8 @@ namespace mdlp {
         auto y = file.getY();
         auto X_torch = torch::tensor(X[0], torch::kFloat32);
         auto yt = torch::tensor(y, torch::kInt32);
-        disc->fit_t(X_torch, yt);
-        torch::Tensor Xt = disc->transform_t(X_torch);
+        fit_t(*disc, X_torch, yt);
+        torch::Tensor Xt = transform_t(*disc, X_torch);
         delete disc;
         EXPECT_EQ(iris_quantile.size(), Xt.size(0));
         for (int i = 0; i < iris_quantile.size(); ++i) {
@@ -95,7 +99,7 @@ namespace mdlp {
         auto y = file.getY();
         auto X_torch = torch::tensor(X[0], torch::kFloat32);
         auto yt = torch::tensor(y, torch::kInt32);
-        torch::Tensor Xt = disc->fit_transform_t(X_torch, yt);
+        torch::Tensor Xt = fit_transform_t(*disc, X_torch, yt);
         delete disc;
         EXPECT_EQ(iris_quantile.size(), Xt.size(0));
         for (int i = 0; i < iris_quantile.size(); ++i) {
@@ -305,26 +309,26 @@ namespace mdlp {
 
         // Test non-1D tensors
         auto X_2d = torch::tensor({ {1.0f, 2.0f}, {3.0f, 4.0f} }, torch::kFloat32);
-        EXPECT_THROW_WITH_MESSAGE(disc->fit_t(X_2d, y), std::invalid_argument, "Only 1D tensors supported");
+        EXPECT_THROW_WITH_MESSAGE(fit_t(*disc, X_2d, y), std::invalid_argument, "Only 1D tensors supported");
 
         auto y_2d = torch::tensor({ {1, 2}, {3, 4} }, torch::kInt32);
-        EXPECT_THROW_WITH_MESSAGE(disc->fit_t(X, y_2d), std::invalid_argument, "Only 1D tensors supported");
+        EXPECT_THROW_WITH_MESSAGE(fit_t(*disc, X, y_2d), std::invalid_argument, "Only 1D tensors supported");
 
         // Test wrong tensor types
         auto X_int = torch::tensor({ 1, 2, 3 }, torch::kInt32);
-        EXPECT_THROW_WITH_MESSAGE(disc->fit_t(X_int, y), std::invalid_argument, "X tensor must be Float32 type");
+        EXPECT_THROW_WITH_MESSAGE(fit_t(*disc, X_int, y), std::invalid_argument, "X tensor must be Float32 or Float64 type");
 
         auto y_float = torch::tensor({ 1.0f, 2.0f, 3.0f }, torch::kFloat32);
-        EXPECT_THROW_WITH_MESSAGE(disc->fit_t(X, y_float), std::invalid_argument, "y tensor must be Int32 type");
+        EXPECT_THROW_WITH_MESSAGE(fit_t(*disc, X, y_float), std::invalid_argument, "y tensor must be Int32 or Int64 type");
 
         // Test mismatched sizes
         auto y_short = torch::tensor({ 1, 2 }, torch::kInt32);
-        EXPECT_THROW_WITH_MESSAGE(disc->fit_t(X, y_short), std::invalid_argument, "X and y tensors must have same number of elements");
+        EXPECT_THROW_WITH_MESSAGE(fit_t(*disc, X, y_short), std::invalid_argument, "X and y tensors must have same number of elements");
 
         // Test empty tensors
         auto X_empty = torch::tensor({}, torch::kFloat32);
         auto y_empty = torch::tensor({}, torch::kInt32);
-        EXPECT_THROW_WITH_MESSAGE(disc->fit_t(X_empty, y_empty), std::invalid_argument, "Tensors cannot be empty");
+        EXPECT_THROW_WITH_MESSAGE(fit_t(*disc, X_empty, y_empty), std::invalid_argument, "Tensors cannot be empty");
 
         delete disc;
     }
@@ -336,19 +340,19 @@ namespace mdlp {
         // First fit with valid data
         auto X_fit = torch::tensor({ 1.0f, 2.0f, 3.0f, 4.0f }, torch::kFloat32);
         auto y_fit = torch::tensor({ 1, 2, 3, 4 }, torch::kInt32);
-        disc->fit_t(X_fit, y_fit);
+        fit_t(*disc, X_fit, y_fit);
 
         // Test non-1D tensor
         auto X_2d = torch::tensor({ {1.0f, 2.0f}, {3.0f, 4.0f} }, torch::kFloat32);
-        EXPECT_THROW_WITH_MESSAGE(disc->transform_t(X_2d), std::invalid_argument, "Only 1D tensors supported");
+        EXPECT_THROW_WITH_MESSAGE(transform_t(*disc, X_2d), std::invalid_argument, "Only 1D tensors supported");
 
         // Test wrong tensor type
         auto X_int = torch::tensor({ 1, 2, 3 }, torch::kInt32);
-        EXPECT_THROW_WITH_MESSAGE(disc->transform_t(X_int), std::invalid_argument, "X tensor must be Float32 type");
+        EXPECT_THROW_WITH_MESSAGE(transform_t(*disc, X_int), std::invalid_argument, "X tensor must be Float32 or Float64 type");
 
         // Test empty tensor
         auto X_empty = torch::tensor({}, torch::kFloat32);
-        EXPECT_THROW_WITH_MESSAGE(disc->transform_t(X_empty), std::invalid_argument, "Tensor cannot be empty");
+        EXPECT_THROW_WITH_MESSAGE(transform_t(*disc, X_empty), std::invalid_argument, "Tensor cannot be empty");
 
         delete disc;
     }
@@ -362,26 +366,26 @@ namespace mdlp {
 
         // Test non-1D tensors
         auto X_2d = torch::tensor({ {1.0f, 2.0f}, {3.0f, 4.0f} }, torch::kFloat32);
-        EXPECT_THROW_WITH_MESSAGE(disc->fit_transform_t(X_2d, y), std::invalid_argument, "Only 1D tensors supported");
+        EXPECT_THROW_WITH_MESSAGE(fit_transform_t(*disc, X_2d, y), std::invalid_argument, "Only 1D tensors supported");
 
         auto y_2d = torch::tensor({ {1, 2}, {3, 4} }, torch::kInt32);
-        EXPECT_THROW_WITH_MESSAGE(disc->fit_transform_t(X, y_2d), std::invalid_argument, "Only 1D tensors supported");
+        EXPECT_THROW_WITH_MESSAGE(fit_transform_t(*disc, X, y_2d), std::invalid_argument, "Only 1D tensors supported");
 
         // Test wrong tensor types
         auto X_int = torch::tensor({ 1, 2, 3 }, torch::kInt32);
-        EXPECT_THROW_WITH_MESSAGE(disc->fit_transform_t(X_int, y), std::invalid_argument, "X tensor must be Float32 type");
+        EXPECT_THROW_WITH_MESSAGE(fit_transform_t(*disc, X_int, y), std::invalid_argument, "X tensor must be Float32 or Float64 type");
 
         auto y_float = torch::tensor({ 1.0f, 2.0f, 3.0f }, torch::kFloat32);
-        EXPECT_THROW_WITH_MESSAGE(disc->fit_transform_t(X, y_float), std::invalid_argument, "y tensor must be Int32 type");
+        EXPECT_THROW_WITH_MESSAGE(fit_transform_t(*disc, X, y_float), std::invalid_argument, "y tensor must be Int32 or Int64 type");
 
         // Test mismatched sizes
         auto y_short = torch::tensor({ 1, 2 }, torch::kInt32);
-        EXPECT_THROW_WITH_MESSAGE(disc->fit_transform_t(X, y_short), std::invalid_argument, "X and y tensors must have same number of elements");
+        EXPECT_THROW_WITH_MESSAGE(fit_transform_t(*disc, X, y_short), std::invalid_argument, "X and y tensors must have same number of elements");
 
         // Test empty tensors
         auto X_empty = torch::tensor({}, torch::kFloat32);
         auto y_empty = torch::tensor({}, torch::kInt32);
-        EXPECT_THROW_WITH_MESSAGE(disc->fit_transform_t(X_empty, y_empty), std::invalid_argument, "Tensors cannot be empty");
+        EXPECT_THROW_WITH_MESSAGE(fit_transform_t(*disc, X_empty, y_empty), std::invalid_argument, "Tensors cannot be empty");
 
         delete disc;
     }
@@ -452,7 +456,7 @@ namespace mdlp {
         auto y = torch::zeros({ 10 }, torch::kInt32);
 
         BinDisc disc(3, strategy_t::UNIFORM);
-        disc.fit_t(col0, y);
+        fit_t(disc, col0, y);
         auto cuts = disc.getCutPoints();
 
         // Must be derived from the logical values 0..9, never from the raw
@@ -462,9 +466,9 @@ namespace mdlp {
         EXPECT_NEAR(cuts.back(), 9.0f, margin);
 
         // transform_t must handle the same non-contiguous view.
-        auto transformed = disc.transform_t(col0);
+        auto transformed = transform_t(disc, col0);
         ASSERT_EQ(transformed.numel(), 10);
-        auto contiguous_result = disc.transform_t(col0.contiguous());
+        auto contiguous_result = transform_t(disc, col0.contiguous());
         EXPECT_TRUE(torch::equal(transformed, contiguous_result));
     }
 
@@ -570,9 +574,292 @@ namespace mdlp {
         auto y = torch::tensor({ 0, 0, 0, 1, 1, 1 }, torch::kInt32);
 
         BinDisc disc(3, strategy_t::UNIFORM);
-        auto from_view = disc.fit_transform_t(col0, y);
-        auto from_contiguous = disc.fit_transform_t(col0.contiguous(), y);
+        auto from_view = fit_transform_t(disc, col0, y);
+        auto from_contiguous = fit_transform_t(disc, col0.contiguous(), y);
 
         EXPECT_TRUE(torch::equal(from_view, from_contiguous));
     }
+
+    // Float64 and Int64 are read as they are; the caller no longer converts.
+    TEST(Discretizer, WideTensorsGiveTheNarrowResults)
+    {
+        auto X = torch::tensor(samples_t({ 4.3f, 5.1f, 4.9f, 6.2f, 5.8f, 7.1f, 4.4f, 6.0f, 6.9f, 5.0f }), torch::kFloat32);
+        auto y = torch::tensor(labels_t({ 0, 1, 0, 2, 1, 2, 0, 1, 2, 0 }), torch::kInt32);
+        CPPFImdlp narrow;
+        auto expected = fit_transform_t(narrow, X, y);
+        CPPFImdlp wide;
+        auto labels = fit_transform_t(wide, X.to(torch::kFloat64), y.to(torch::kInt64));
+        EXPECT_EQ(torch_label_t, labels.scalar_type());
+        EXPECT_TRUE(torch::equal(expected, labels));
+        EXPECT_EQ(narrow.getCutPoints(), wide.getCutPoints());
+        EXPECT_TRUE(torch::equal(expected, transform_t(wide, X.to(torch::kFloat64))));
+    }
+
+    TEST(Discretizer, StridedFloat64TensorIsReadInPlace)
+    {
+        auto base = torch::empty({ 10, 2 }, torch::kFloat64);
+        for (int i = 0; i < 10; ++i) {
+            base[i][0] = static_cast<double>(i);
+            base[i][1] = static_cast<double>(100 + i);
+        }
+        auto col0 = base.select(1, 0);
+        ASSERT_FALSE(col0.is_contiguous());
+        BinDisc disc(3, strategy_t::UNIFORM);
+        fit_t(disc, col0, torch::zeros({ 10 }, torch::kInt64));
+        EXPECT_NEAR(disc.getCutPoints().back(), 9.0f, margin);
+        EXPECT_TRUE(torch::equal(transform_t(disc, col0.contiguous()), transform_t(disc, col0)));
+    }
+
+    TEST(Discretizer, Int64LabelMustFitInLabelType)
+    {
+        auto X = torch::tensor({ 1.0f, 2.0f, 3.0f }, torch::kFloat32);
+        auto y = torch::zeros({ 3 }, torch::kInt64);
+        y[1] = 4294967296.0;
+        CPPFImdlp disc;
+        EXPECT_THROW_WITH_MESSAGE(fit_t(disc, X, y), ValidationError,
+            "Label at index 1 does not fit in 32 bits: 4294967296");
+        y[1] = -4294967296.0;
+        EXPECT_THROW_WITH_MESSAGE(fit_t(disc, X, y), ValidationError,
+            "Label at index 1 does not fit in 32 bits: -4294967296");
+    }
+
+    // The chunked path names the offender by its index in the whole tensor,
+    // and a double beyond the range of float is no more finite than inf.
+    TEST(Discretizer, TensorTransformReportsTheFirstNonFiniteSample)
+    {
+        BinDisc disc(4, strategy_t::UNIFORM);
+        fit_t(disc, torch::tensor({ 1.0f, 2.0f, 3.0f, 4.0f }, torch::kFloat32),
+            torch::tensor({ 0, 0, 1, 1 }, torch::kInt32));
+        auto X = torch::zeros({ 3 * 65536 }, torch::kFloat64);
+        X[140000] = 1e300;
+        EXPECT_THROW_WITH_MESSAGE(transform_t(disc, X), ValidationError,
+            "Sample at index 140000 is not a finite number: inf");
+        auto X_float = X.to(torch::kFloat32);
+        EXPECT_THROW_WITH_MESSAGE(transform_t(disc, X_float), ValidationError,
+            "Sample at index 140000 is not a finite number: inf");
+        // Unfitted, the sample is still reported before the missing fit.
+        BinDisc unfitted(4);
+        EXPECT_THROW_WITH_MESSAGE(transform_t(unfitted, X), ValidationError,
+            "Sample at index 140000 is not a finite number: inf");
+        EXPECT_THROW_WITH_MESSAGE(transform_t(unfitted, torch::zeros({ 3 }, torch::kFloat64)), NotFittedError,
+            "Discretizer not fitted yet or no valid cut points found");
+    }
+
+    // ---- parallel transform ---------------------------------------------- //
+
+    namespace {
+        // Several chunks and a partial last one.
+        samples_t parallel_input()
+        {
+            samples_t X(3 * 65536 + 1234);
+            for (size_t i = 0; i < X.size(); ++i) {
+                X[i] = static_cast<precision_t>((i * 7919) % 10007) / 100.0f;
+            }
+            return X;
+        }
+
+        // Runs the tasks in reverse, so a chunk-order assumption would show.
+        class ReverseExecutor : public Executor {
+        public:
+            size_t concurrency() const override { return 1; }
+            void run(size_t n_tasks, const std::function<void(size_t)>& task) override
+            {
+                calls += n_tasks;
+                for (size_t i = n_tasks; i-- > 0;) {
+                    task(i);
+                }
+            }
+            size_t calls = 0;
+        };
+    }
+
+    TEST(Discretizer, ParallelTransformMatchesSerial)
+    {
+        auto X = parallel_input();
+        labels_t y(X.size(), 0);
+        for (size_t i = 0; i < X.size(); ++i) {
+            y[i] = X[i] < 30.0f ? 0 : (X[i] < 70.0f ? 1 : 2);
+        }
+        BinDisc uniform(7, strategy_t::UNIFORM);
+        BinDisc quantile(7, strategy_t::QUANTILE);
+        CPPFImdlp mdlp;
+        uniform.fit(X, y);
+        quantile.fit(X, y);
+        mdlp.fit(X, y);
+        ThreadPool pool(4);
+        for (const Discretizer* disc : { static_cast<const Discretizer*>(&uniform), static_cast<const Discretizer*>(&quantile), static_cast<const Discretizer*>(&mdlp) }) {
+            labels_t serial;
+            disc->transform(X, serial);
+            for (const size_t threads : { 0, 1, 2, 3 }) {
+                labels_t parallel = { 42 };
+                disc->transform(X, parallel, threads);
+                EXPECT_EQ(serial, parallel) << threads << " threads";
+            }
+            labels_t pooled;
+            disc->transform(X, pooled, pool);
+            EXPECT_EQ(serial, pooled);
+            ReverseExecutor reverse;
+            labels_t reversed;
+            disc->transform(X, reversed, reverse);
+            EXPECT_EQ(serial, reversed);
+            EXPECT_EQ(4u, reverse.calls);
+        }
+    }
+
+    TEST(Discretizer, ParallelTransformSmallInputStaysSerial)
+    {
+        samples_t X = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+        BinDisc disc(3);
+        disc.fit(X);
+        labels_t serial;
+        labels_t parallel;
+        disc.transform(X, serial);
+        disc.transform(X, parallel, 8);
+        EXPECT_EQ(serial, parallel);
+    }
+
+    // The first offender is reported, as serially, even when it lies in a chunk
+    // that finishes after one holding a later offender.
+    TEST(Discretizer, ParallelTransformReportsTheFirstNonFiniteSample)
+    {
+        auto X = parallel_input();
+        BinDisc disc(5);
+        disc.fit(X);
+        X[150000] = std::numeric_limits<precision_t>::infinity();
+        X[70000] = std::numeric_limits<precision_t>::quiet_NaN();
+        // Chunks before the offender bin first; out must still be left as the
+        // serial overload leaves it.
+        const labels_t before = { 7, 8, 9 };
+        labels_t out = before;
+        ReverseExecutor reverse;
+        EXPECT_THROW_WITH_MESSAGE(disc.transform(X, out, reverse), ValidationError,
+            "Sample at index 70000 is not a finite number: nan");
+        EXPECT_EQ(before, out);
+        EXPECT_THROW_WITH_MESSAGE(disc.transform(X, out, 4), ValidationError,
+            "Sample at index 70000 is not a finite number: nan");
+        EXPECT_EQ(before, out);
+        EXPECT_THROW(disc.transform(X, out), ValidationError);
+        EXPECT_EQ(before, out);
+    }
+
+    TEST(Discretizer, ParallelTransformValidatesLikeSerial)
+    {
+        ThreadPool pool(2);
+        labels_t out;
+        BinDisc unfitted(3);
+        samples_t empty;
+        samples_t X = { 1.0f, 2.0f };
+        samples_t bad = { 1.0f, std::numeric_limits<precision_t>::quiet_NaN() };
+        EXPECT_THROW_WITH_MESSAGE(unfitted.transform(empty, out, pool), ValidationError, "Data for transformation cannot be empty");
+        EXPECT_THROW_WITH_MESSAGE(unfitted.transform(bad, out, pool), ValidationError, "Sample at index 1 is not a finite number: nan");
+        EXPECT_THROW_WITH_MESSAGE(unfitted.transform(X, out, pool), NotFittedError, "Discretizer not fitted yet or no valid cut points found");
+    }
+
+    // ---- narrow and packed labels ----------------------------------------- //
+
+    TEST(Discretizer, NarrowAndPackedLabelsMatchTheWideOnes)
+    {
+        auto X = parallel_input();
+        for (int n_bins : { 3, 10, 200 }) {
+            BinDisc disc(n_bins, strategy_t::QUANTILE);
+            disc.fit(X);
+            EXPECT_EQ(static_cast<size_t>(n_bins), disc.getBins());
+            labels_t wide;
+            disc.transform(X, wide);
+            std::vector<uint8_t> narrow;
+            disc.transform(X, narrow);
+            EXPECT_TRUE(std::equal(wide.begin(), wide.end(), narrow.begin(), narrow.end())) << n_bins << " bins";
+            std::vector<uint16_t> half;
+            disc.transform(X, half);
+            EXPECT_TRUE(std::equal(wide.begin(), wide.end(), half.begin(), half.end())) << n_bins << " bins";
+            PackedLabels packed;
+            disc.transform(X, packed);
+            EXPECT_EQ(disc.getBins(), packed.n_bins());
+            EXPECT_EQ(PackedLabels::bits_for(disc.getBins()), packed.bits());
+            EXPECT_EQ(wide, packed.unpack()) << n_bins << " bins";
+        }
+    }
+
+    TEST(Discretizer, NarrowLabelsMustHoldEveryBin)
+    {
+        auto X = parallel_input();
+        BinDisc disc(300, strategy_t::UNIFORM);
+        disc.fit(X);
+        std::vector<uint8_t> narrow;
+        EXPECT_THROW_WITH_MESSAGE(disc.transform(X, narrow), InvalidParameter,
+            "Model has 300 bins; uint8_t labels hold at most 256");
+        std::vector<uint16_t> half;
+        disc.transform(X, half);
+        EXPECT_EQ(299, *std::max_element(half.begin(), half.end()));
+        BinDisc fine(70000, strategy_t::UNIFORM);
+        fine.fit(X);
+        EXPECT_THROW_WITH_MESSAGE(fine.transform(X, half), InvalidParameter,
+            "Model has 70000 bins; uint16_t labels hold at most 65536");
+    }
+
+    TEST(Discretizer, NarrowAndPackedTransformsValidateLikeTheWideOne)
+    {
+        BinDisc unfitted(3);
+        EXPECT_EQ(0u, unfitted.getBins());
+        samples_t X = { 1.0f, 2.0f };
+        samples_t empty;
+        std::vector<uint8_t> narrow;
+        PackedLabels packed;
+        EXPECT_THROW_WITH_MESSAGE(unfitted.transform(X, narrow), NotFittedError,
+            "Discretizer not fitted yet or no valid cut points found");
+        EXPECT_THROW_WITH_MESSAGE(unfitted.transform(X, packed), NotFittedError,
+            "Discretizer not fitted yet or no valid cut points found");
+        EXPECT_THROW_WITH_MESSAGE(unfitted.transform(empty, packed), ValidationError,
+            "Data for transformation cannot be empty");
+    }
+
+    // ---- one-pass summary ------------------------------------------------- //
+
+    class SummaryProbe : public MinimalDiscretizer {
+    public:
+        using Discretizer::summarize;
+    };
+
+    // Every length around the lane count, with the one out-of-order pair and
+    // the extremes at every position, against the obvious two-pass answer.
+    TEST(Discretizer, SummaryMatchesTheSeparatePasses)
+    {
+        EXPECT_EQ(0u, SummaryProbe::summarize({}).count);
+        EXPECT_TRUE(SummaryProbe::summarize({}).sorted);
+        for (size_t n = 1; n <= 40; ++n) {
+            samples_t X(n);
+            for (size_t i = 0; i < n; ++i) {
+                X[i] = static_cast<precision_t>(i) * 0.5f - 3.0f;
+            }
+            auto summary = SummaryProbe::summarize(X);
+            EXPECT_EQ(n, summary.count);
+            EXPECT_EQ(X.front(), summary.min);
+            EXPECT_EQ(X.back(), summary.max);
+            EXPECT_TRUE(summary.sorted) << n;
+            for (size_t i = 1; i < n; ++i) {
+                samples_t Y = X;
+                std::swap(Y[i - 1], Y[i]);
+                Y[i] = -100.0f;
+                Y[i - 1] = 100.0f;
+                summary = SummaryProbe::summarize(Y);
+                auto [lo, hi] = std::minmax_element(Y.begin(), Y.end());
+                EXPECT_EQ(*lo, summary.min) << n << " " << i;
+                EXPECT_EQ(*hi, summary.max) << n << " " << i;
+                EXPECT_FALSE(summary.sorted) << n << " " << i;
+            }
+        }
+    }
+
+    TEST(Discretizer, SummaryRejectsNonFiniteSamples)
+    {
+        samples_t X(37, 1.0f);
+        X[36] = -std::numeric_limits<precision_t>::infinity();
+        EXPECT_THROW_WITH_MESSAGE(SummaryProbe::summarize(X), ValidationError,
+            "Sample at index 36 is not a finite number: -inf");
+        X[0] = std::numeric_limits<precision_t>::quiet_NaN();
+        EXPECT_THROW_WITH_MESSAGE(SummaryProbe::summarize(X), ValidationError,
+            "Sample at index 0 is not a finite number: nan");
+        EXPECT_THROW_WITH_MESSAGE(SummaryProbe::summarize({ std::numeric_limits<precision_t>::infinity() }), ValidationError,
+            "Sample at index 0 is not a finite number: inf");
+    }
 }
@@ -29,6 +29,7 @@ namespace mdlp {
         EXPECT_THROW(throw NotFittedError("x"), std::runtime_error);
         EXPECT_THROW(throw IndexError("x"), std::out_of_range);
         EXPECT_THROW(throw UnderflowError("x"), std::underflow_error);
+        EXPECT_THROW(throw IOError("x"), std::runtime_error);
     }
 
     TEST(Exceptions, AreCaughtByStdException)
@@ -47,6 +48,7 @@ namespace mdlp {
         EXPECT_THROW(throw NotFittedError("x"), DiscretizerError);
         EXPECT_THROW(throw IndexError("x"), DiscretizerError);
         EXPECT_THROW(throw UnderflowError("x"), DiscretizerError);
+        EXPECT_THROW(throw IOError("x"), DiscretizerError);
     }
 
     // A tag-typed handler cannot call what(), because the tag deliberately does
@@ -63,7 +65,7 @@ namespace mdlp {
     }
 
     // Every type, not just a sample: message() is a separate override on each,
-    // so covering three of five would leave two silently unverified.
+    // so covering a sample would leave the rest silently unverified.
     TEST(Exceptions, MessageAndWhatAgreeForEveryType)
     {
         const InvalidParameter a("text a");
@@ -71,16 +73,18 @@ namespace mdlp {
         const NotFittedError c("text c");
         const IndexError d("text d");
         const UnderflowError e("text e");
+        const IOError f("text f");
         EXPECT_STREQ(a.what(), a.message());
         EXPECT_STREQ(b.what(), b.message());
         EXPECT_STREQ(c.what(), c.message());
         EXPECT_STREQ(d.what(), d.message());
         EXPECT_STREQ(e.what(), e.message());
+        EXPECT_STREQ(f.what(), f.message());
 
         // ...and each is reachable through the tag.
-        const DiscretizerError* tags[] = { &a, &b, &c, &d, &e };
-        const char* expected[] = { "text a", "text b", "text c", "text d", "text e" };
-        for (size_t i = 0; i < 5; ++i) {
+        const DiscretizerError* tags[] = { &a, &b, &c, &d, &e, &f };
+        const char* expected[] = { "text a", "text b", "text c", "text d", "text e", "text f" };
+        for (size_t i = 0; i < 6; ++i) {
             EXPECT_STREQ(expected[i], tags[i]->message());
         }
     }
@@ -0,0 +1,99 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "Executor.h"
+
+namespace mdlp {
+
+    TEST(ThreadPool, RunsEveryTaskExactlyOnce)
+    {
+        ThreadPool pool(4);
+        EXPECT_EQ(4u, pool.concurrency());
+        std::vector<std::atomic<int>> calls(1000);
+        pool.run(calls.size(), [&](size_t i) { calls[i].fetch_add(1); });
+        for (size_t i = 0; i < calls.size(); ++i) {
+            EXPECT_EQ(1, calls[i].load()) << "task " << i;
+        }
+    }
+
+    TEST(ThreadPool, IsReusableAcrossRuns)
+    {
+        ThreadPool pool(3);
+        std::atomic<size_t> total{ 0 };
+        for (size_t round = 1; round <= 50; ++round) {
+            pool.run(round, [&](size_t i) { total.fetch_add(i + 1); });
+        }
+        // Sum over rounds r of 1 + 2 + ... + r.
+        size_t expected = 0;
+        for (size_t round = 1; round <= 50; ++round) {
+            expected += round * (round + 1) / 2;
+        }
+        EXPECT_EQ(expected, total.load());
+    }
+
+    TEST(ThreadPool, ZeroTasksReturnsAtOnce)
+    {
+        ThreadPool pool(2);
+        bool called = false;
+        pool.run(0, [&](size_t) { called = true; });
+        EXPECT_FALSE(called);
+    }
+
+    TEST(ThreadPool, DefaultsToTheHardware)
+    {
+        const size_t hardware = std::max<size_t>(1, std::thread::hardware_concurrency());
+        EXPECT_EQ(hardware, ThreadPool().concurrency());
+        EXPECT_EQ(1u, ThreadPool(1).concurrency());
+    }
+
+    TEST(ThreadPool, SingleThreadRunsOnTheCaller)
+    {
+        ThreadPool pool(1);
+        const auto caller = std::this_thread::get_id();
+        pool.run(10, [&](size_t) { EXPECT_EQ(caller, std::this_thread::get_id()); });
+    }
+
+    TEST(ThreadPool, RethrowsATaskException)
+    {
+        ThreadPool pool(4);
+        std::atomic<int> calls{ 0 };
+        EXPECT_THROW(pool.run(100, [&](size_t i) {
+            calls.fetch_add(1);
+            if (i == 7) {
+                throw std::runtime_error("task 7 failed");
+            }
+            }), std::runtime_error);
+        EXPECT_LE(calls.load(), 100);
+        // The failure does not poison the pool.
+        std::atomic<int> after{ 0 };
+        pool.run(10, [&](size_t) { after.fetch_add(1); });
+        EXPECT_EQ(10, after.load());
+    }
+
+    // An application-supplied executor, as the interface is meant to be used.
+    TEST(Executor, CanBeImplementedByTheCaller)
+    {
+        class Inline : public Executor {
+        public:
+            size_t concurrency() const override { return 1; }
+            void run(size_t n_tasks, const std::function<void(size_t)>& task) override
+            {
+                for (size_t i = n_tasks; i-- > 0;) {
+                    task(i);
+                }
+            }
+        };
+        Inline executor;
+        std::vector<size_t> order;
+        executor.run(3, [&](size_t i) { order.push_back(i); });
+        EXPECT_EQ(std::vector<size_t>({ 2, 1, 0 }), order);
+    }
+}
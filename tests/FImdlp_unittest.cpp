@@ -85,6 +85,13 @@ namespace mdlp {
             return true;
         }
 
+        void file_fit(CPPFImdlp& test, const std::string& filename, size_t feature) const
+        {
+            ArffFiles::ArffFiles file;
+            file.load(data_path + filename + ".arff", true);
+            test.fit(file.getX()[feature], file.getY());
+        }
+
         void test_dataset(CPPFImdlp& test, const std::string& filename, std::vector<cutPoints_t>& expected,
             std::vector<int>& depths) const
         {
@@ -169,6 +176,36 @@ namespace mdlp {
         indices = { 1, 2, 0 };
     }
 
+    // Sorted input takes the sortTies() path; it must order ties by label
+    // exactly as sortIndices() does.
+    TEST_F(TestFImdlp, SortTiesMatchesSortIndices)
+    {
+        X = { 1.0f, 1.0f, 1.0f, 2.0f, 3.0f, 3.0f, 4.0f, 4.0f, 4.0f, 4.0f };
+        y = { 2, 0, 1, 1, 1, 0, 0, 2, 0, 1 };
+        EXPECT_EQ(sortIndices(X, y), sortTies(X, y));
+        X = { 0.5f };
+        y = { 3 };
+        EXPECT_EQ(sortIndices(X, y), sortTies(X, y));
+        // Iris sorted gives the cut points of iris as it comes.
+        ArffFiles::ArffFiles file;
+        file.load(data_path + "iris.arff", true);
+        for (const auto& feature : file.getX()) {
+            samples_t X_sorted = feature;
+            labels_t y_sorted = file.getY();
+            auto order = sortIndices(X_sorted, y_sorted);
+            for (size_t i = 0; i < order.size(); ++i) {
+                X_sorted[i] = feature[order[i]];
+                y_sorted[i] = file.getY()[order[i]];
+            }
+            CPPFImdlp from_sorted;
+            from_sorted.fit(X_sorted, y_sorted);
+            CPPFImdlp as_is;
+            samples_t X_as_is = feature;
+            as_is.fit(X_as_is, file.getY());
+            EXPECT_EQ(as_is.getCutPoints(), from_sorted.getCutPoints());
+        }
+    }
+
     TEST_F(TestFImdlp, SortIndicesOutOfBounds)
     {
         // Test for out of bounds exception in sortIndices
@@ -549,6 +586,87 @@ namespace mdlp {
         EXPECT_EQ(reference.getCutPoints(), concrete.getCutPoints());
     }
 
+    TEST_F(TestFImdlp, FitStatsAreOffByDefault)
+    {
+        EXPECT_FALSE(collectsFitStats());
+        const auto& stats = getFitStats();
+        EXPECT_EQ(0u, stats.total_ns);
+        EXPECT_EQ(0u, stats.candidate_calls);
+        EXPECT_EQ(0u, stats.cache_misses);
+        EXPECT_EQ(0u, stats.peak_scratch_bytes);
+    }
+
+    TEST_F(TestFImdlp, FitStatsDescribeTheSearch)
+    {
+        ArffFiles::ArffFiles file;
+        file.load(data_path + "iris.arff", true);
+        auto& X_ = file.getX()[1];
+        auto& y_ = file.getY();
+        const size_t n = X_.size();
+        CPPFImdlp disc;
+        disc.collectFitStats(true);
+        disc.fit(X_, y_);
+        const auto stats = disc.getFitStats();
+        const auto cuts = disc.getCutPoints().size() - 2;
+        EXPECT_EQ(cuts, stats.cuts_accepted);
+        EXPECT_GT(stats.cuts_rejected, 0u);
+        EXPECT_EQ(0u, stats.cuts_pruned);
+        EXPECT_EQ(disc.get_depth(), stats.max_depth);
+        // Each accepted cut splits its interval in two, and every interval
+        // long enough is searched.
+        EXPECT_LE(stats.cuts_accepted + stats.cuts_rejected, stats.candidate_calls);
+        EXPECT_GE(stats.elements_scanned, n);
+        EXPECT_GT(stats.cache_misses, 0u);
+        EXPECT_GT(stats.cache_hits, 0u);
+        // The copies of X and y, the order and Metrics' two copies.
+        EXPECT_GE(stats.peak_scratch_bytes, n * (2 * sizeof(precision_t) + 2 * sizeof(size_t) + sizeof(label_t)));
+        EXPECT_GT(stats.total_ns, 0u);
+        EXPECT_LE(stats.validate_ns + stats.sort_ns + stats.search_ns + stats.prune_ns, stats.total_ns);
+
+        // Another fit starts from zero and, on the same data, counts the same.
+        disc.fit(X_, y_);
+        EXPECT_EQ(stats.candidate_calls, disc.getFitStats().candidate_calls);
+        EXPECT_EQ(stats.elements_scanned, disc.getFitStats().elements_scanned);
+        EXPECT_EQ(stats.cache_hits, disc.getFitStats().cache_hits);
+        EXPECT_EQ(stats.peak_scratch_bytes, disc.getFitStats().peak_scratch_bytes);
+
+        // An adopted buffer is not scratch.
+        samples_t X_moved = X_;
+        labels_t y_moved = y_;
+        disc.fit(std::move(X_moved), std::move(y_moved));
+        EXPECT_EQ(stats.peak_scratch_bytes - n * (sizeof(precision_t) + sizeof(label_t)),
+            disc.getFitStats().peak_scratch_bytes);
+
+        disc.collectFitStats(false);
+        disc.fit(X_, y_);
+        EXPECT_EQ(0u, disc.getFitStats().candidate_calls);
+        EXPECT_EQ(0u, disc.getFitStats().total_ns);
+    }
+
+    TEST_F(TestFImdlp, FitStatsCountPrunedCutsAndDuplicateSteps)
+    {
+        // The class boundary falls inside a run of equal values, which
+        // valueCutPoint() walks to the edge of the run.
+        samples_t X_(100, 1.0f);
+        labels_t y_(100, 0);
+        std::fill(X_.begin() + 50, X_.end(), 2.0f);
+        std::fill(y_.begin() + 45, y_.end(), 1);
+        CPPFImdlp disc;
+        disc.collectFitStats(true);
+        disc.fit(X_, y_);
+        EXPECT_EQ(cutPoints_t({ 1.0f, 1.5f, 2.0f }), disc.getCutPoints());
+        EXPECT_EQ(1u, disc.getFitStats().cuts_accepted);
+        EXPECT_GT(disc.getFitStats().duplicate_steps, 0u);
+
+        CPPFImdlp pruned(3, std::numeric_limits<int>::max(), 2);
+        pruned.collectFitStats(true);
+        file_fit(pruned, "iris", 1);
+        const auto& stats = pruned.getFitStats();
+        EXPECT_EQ(2u, pruned.getCutPoints().size() - 2);
+        EXPECT_EQ(stats.cuts_accepted - 2, stats.cuts_pruned);
+        EXPECT_GT(stats.cuts_pruned, 0u);
+    }
+
     // CPPFImdlp holds a Metrics by value. While Metrics contained a std::mutex it
     // was neither copyable nor movable, which silently deleted CPPFImdlp's copy
     // and move constructors too. Moving is a prerequisite for the move-semantics
@@ -0,0 +1,246 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+// The mapped loader against ArffFiles, which it replaces in the sample and the
+// real-data tests: same attributes, same labels, the same bits in every value.
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include <ArffFiles/ArffFiles.hpp>
+#include "gtest/gtest.h"
+#include "Loader.h"
+#include "Exceptions.h"
+
+namespace mdlp {
+
+    namespace {
+        std::string data_path()
+        {
+            std::ifstream probe("datasets/iris.arff");
+            return probe.is_open() ? "datasets/" : "tests/datasets/";
+        }
+
+        std::string temp_path(const std::string& name)
+        {
+            return testing::TempDir() + "mdlp_loader_" + name;
+        }
+
+        void write_text(const std::string& path, const std::string& text)
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out << text;
+        }
+
+        std::string message_of(const std::function<void()>& call)
+        {
+            try {
+                call();
+            }
+            catch (const ValidationError& e) {
+                return e.what();
+            }
+            return "";
+        }
+
+        void expect_same(const Dataset& expected, const Dataset& actual)
+        {
+            EXPECT_EQ(expected.attributes, actual.attributes);
+            EXPECT_EQ(expected.class_name, actual.class_name);
+            EXPECT_EQ(expected.class_type, actual.class_type);
+            EXPECT_EQ(expected.class_values, actual.class_values);
+            EXPECT_EQ(expected.y, actual.y);
+            ASSERT_EQ(expected.X.size(), actual.X.size());
+            for (size_t j = 0; j < expected.X.size(); ++j) {
+                ASSERT_EQ(expected.X[j].size(), actual.X[j].size());
+                EXPECT_EQ(0, std::memcmp(expected.X[j].data(), actual.X[j].data(), expected.X[j].size() * sizeof(precision_t)))
+                    << "feature " << j;
+            }
+        }
+
+        float through_stod(const std::string& text)
+        {
+            return static_cast<float>(std::stod(text));
+        }
+
+        bool same_bits(float a, float b)
+        {
+            return std::memcmp(&a, &b, sizeof(float)) == 0;
+        }
+    }
+
+    TEST(Loader, EveryDatasetMatchesArffFiles)
+    {
+        const std::vector<std::pair<std::string, bool>> files = {
+            { "diabetes", true }, { "glass", true }, { "heart-statlog", true }, { "iris", true },
+            { "kdd_JapaneseVowels", false }, { "letter", true }, { "liver-disorders", true },
+            { "mfeat-factors", true }, { "test", true }
+        };
+        ThreadPool pool(4);
+        for (const auto& [name, class_last] : files) {
+            SCOPED_TRACE(name);
+            const auto path = data_path() + name + ".arff";
+            ArffFiles::ArffFiles arff;
+            arff.load(path, class_last);
+            const auto loaded = load_arff(path, class_last, size_t{ 1 });
+            EXPECT_EQ(arff.getAttributes(), loaded.attributes);
+            EXPECT_EQ(arff.getClassName(), loaded.class_name);
+            EXPECT_EQ(arff.getClassType(), loaded.class_type);
+            EXPECT_EQ(arff.getY(), loaded.y);
+            EXPECT_EQ(arff.getSize(), loaded.size());
+            const auto& X = arff.getX();
+            ASSERT_EQ(X.size(), loaded.X.size());
+            for (size_t j = 0; j < X.size(); ++j) {
+                ASSERT_EQ(X[j].size(), loaded.X[j].size());
+                EXPECT_EQ(0, std::memcmp(X[j].data(), loaded.X[j].data(), X[j].size() * sizeof(precision_t)))
+                    << "feature " << j;
+            }
+            // Split into chunks, the result must not change.
+            expect_same(loaded, load_arff(path, class_last, pool));
+        }
+    }
+
+    TEST(Loader, DeclaredClassValues)
+    {
+        const auto glass = load_arff(data_path() + "glass.arff");
+        EXPECT_EQ((std::vector<std::string>{ "build wind float", "build wind non-float", "vehic wind float",
+            "vehic wind non-float", "containers", "tableware", "headlamps" }), glass.class_values);
+        EXPECT_EQ(214u, glass.size());
+    }
+
+    TEST(Loader, ParseFloatMatchesStod)
+    {
+        const std::vector<std::string> cases = {
+            "0", "-0", "+0", "0.0", "-0.0", "1", "-1", "+1", "1.", ".5", "-.5", "00000000000012.5",
+            "3.14159265358979323846", "0.1", "0.2", "0.3", "1e10", "1E-10", "1e+22", "1e23", "1e-22", "1e-23",
+            "123456789", "1234567890123456789", "12345678901234567890", "9007199254740993", "9007199254740992",
+            "0.000000000000000000000000000000000000000000001", "3.4028235e38", "3.4028236e38", "1.17549435e-38",
+            "2.5e-40", "1.5e300", "0.12345678", "12345678.12345678", "-98765.4321e-3", "inf", "-inf", "nan",
+            "0x1p3", "7.0e0", "1.000000059604644775390625", "1.00000005960464477539062499", "0.000001"
+        };
+        for (const auto& text : cases) {
+            precision_t value = -1;
+            ASSERT_TRUE(parse_float(text.data(), text.data() + text.size(), value)) << text;
+            const float expected = through_stod(text);
+            EXPECT_TRUE(same_bits(expected, value) || (std::isnan(expected) && std::isnan(value)))
+                << text << ": " << expected << " != " << value;
+        }
+        std::mt19937_64 rng(42u);
+        std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+        std::uniform_int_distribution<int> exponent(-40, 38);
+        char buffer[64];
+        for (int i = 0; i < 200000; ++i) {
+            const double x = mantissa(rng) * std::pow(10.0, exponent(rng));
+            const char* format = i % 3 == 0 ? "%.17g" : i % 3 == 1 ? "%.9g" : "%.6f";
+            const int length = std::snprintf(buffer, sizeof(buffer), format, x);
+            precision_t value;
+            ASSERT_TRUE(parse_float(buffer, buffer + length, value)) << buffer;
+            ASSERT_TRUE(same_bits(through_stod(buffer), value)) << buffer;
+        }
+    }
+
+    TEST(Loader, ParseFloatRejectsWhatIsNotANumber)
+    {
+        for (const std::string text : { "", "-", "+", ".", "e5", "1e", "1e+", "1.2.3", "12a", "1 2", "?", "--1", "1,5" }) {
+            precision_t value = 7;
+            EXPECT_FALSE(parse_float(text.data(), text.data() + text.size(), value)) << "'" << text << "'";
+            EXPECT_EQ(7, value) << "'" << text << "'";
+        }
+    }
+
+    TEST(Loader, Csv)
+    {
+        const auto path = temp_path("named.csv");
+        write_text(path, "a,b,label\n1.5,2,'no'\n\n-3,4e1,yes\r\n 5 , 6 ,\"no\"\n");
+        const auto named = load_csv(path);
+        EXPECT_EQ((std::vector<std::pair<std::string, std::string>>{ { "a", "numeric" }, { "b", "numeric" } }), named.attributes);
+        EXPECT_EQ("label", named.class_name);
+        EXPECT_EQ("{no,yes}", named.class_type);
+        EXPECT_EQ((std::vector<std::string>{ "no", "yes" }), named.class_values);
+        EXPECT_EQ((labels_t{ 0, 1, 0 }), named.y);
+        EXPECT_EQ((samples_t{ 1.5f, -3.0f, 5.0f }), named.X[0]);
+        EXPECT_EQ((samples_t{ 2.0f, 40.0f, 6.0f }), named.X[1]);
+        // Integer classes are the labels, whatever order they come in.
+        write_text(path, "7;0.5;1\n2;0.25;2\n7;1;3\n");
+        const auto numbered = load_csv(path, CsvOptions{}.withDelimiter(';').withHeader(false).withClassLast(false));
+        EXPECT_EQ((std::vector<std::pair<std::string, std::string>>{ { "x0", "numeric" }, { "x1", "numeric" } }), numbered.attributes);
+        EXPECT_EQ("class", numbered.class_name);
+        EXPECT_EQ("integer", numbered.class_type);
+        EXPECT_TRUE(numbered.class_values.empty());
+        EXPECT_EQ((labels_t{ 7, 2, 7 }), numbered.y);
+        EXPECT_EQ((samples_t{ 1.0f, 2.0f, 3.0f }), numbered.X[1]);
+        std::remove(path.c_str());
+    }
+
+    // Far more rows than one chunk holds, and class names whose first
+    // appearances fall in different chunks: the numbering must be the file's
+    // order however the rows were split.
+    TEST(Loader, ChunksAgreeWithOneThread)
+    {
+        const auto path = temp_path("large.csv");
+        std::mt19937 rng(7u);
+        std::uniform_real_distribution<float> value(-1000.0f, 1000.0f);
+        std::string text = "f0,f1,f2,class\n";
+        char buffer[128];
+        for (int i = 0; i < 60000; ++i) {
+            const int label = i < 50000 ? i % 3 : 3 + i % 5;
+            std::snprintf(buffer, sizeof(buffer), "%.7g,%.9g,%d,c%d\n", value(rng), value(rng), i, label);
+            text += buffer;
+            if (i % 997 == 0) {
+                text += "\n";
+            }
+        }
+        write_text(path, text);
+        const auto serial = load_csv(path, CsvOptions{}, size_t{ 1 });
+        ASSERT_EQ(60000u, serial.size());
+        EXPECT_EQ((std::vector<std::string>{ "c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7" }), serial.class_values);
+        EXPECT_EQ(59999.0f, serial.X[2].back());
+        for (const size_t threads : { 2, 3, 8 }) {
+            ThreadPool pool(threads);
+            expect_same(serial, load_csv(path, CsvOptions{}, pool));
+        }
+        std::remove(path.c_str());
+    }
+
+    TEST(Loader, ErrorsNameTheLine)
+    {
+        const auto path = temp_path("bad.arff");
+        const auto arff = [&path](const std::string& text) {
+            write_text(path, text);
+            return message_of([&path]() { load_arff(path); });
+            };
+        const std::string header = "@relation r\n@attribute x real\n@attribute c {a,b}\n@data\n";
+        EXPECT_EQ(path + ":6: missing value in x, which is not supported", arff(header + "1,a\n?,b\n"));
+        EXPECT_EQ(path + ":5: 'z' is not a declared value of c", arff(header + "1,z\n"));
+        EXPECT_EQ(path + ":7: 'one' in x is not a number", arff(header + "1,a\n%\none,a\n"));
+        EXPECT_EQ(path + ":5: expected 2 values, found 1", arff(header + "1\n"));
+        EXPECT_EQ(path + ":5: expected 2 values, found more", arff(header + "1,a,2\n"));
+        EXPECT_EQ(path + ":5: sparse rows are not supported", arff(header + "{0 1, 1 a}\n"));
+        EXPECT_EQ(path + ":5: unterminated quote", arff(header + "1,'a\n"));
+        EXPECT_EQ(path + ":2: attribute 's' of type 'string' is not supported", arff("@relation r\n@attribute s string\n@data\n"));
+        EXPECT_EQ(path + ":2: expected @attribute or @data, found 'x'", arff("@relation r\nx\n"));
+        EXPECT_EQ(path + ": no @data section", arff("@relation r\n@attribute x real\n"));
+        EXPECT_EQ(path + ":5: class value 'b' is neither declared nor an integer",
+            arff("@relation r\n@attribute x real\n@attribute c integer\n@data\n1,b\n"));
+        // Many chunks fail; the error is the one nearest the top.
+        std::string rows;
+        for (int i = 0; i < 50000; ++i) {
+            rows += i % 20000 == 19999 ? "?,a\n" : "1.25,b\n";
+        }
+        write_text(path, header + rows);
+        ThreadPool pool(4);
+        EXPECT_EQ(path + ":20004: missing value in x, which is not supported",
+            message_of([&path, &pool]() { load_arff(path, true, pool); }));
+        std::remove(path.c_str());
+        EXPECT_THROW(load_arff(path), IOError);
+        EXPECT_THROW(load_csv(path), IOError);
+    }
+}
@@ -156,6 +156,21 @@ namespace mdlp {
         EXPECT_NEAR(0.0f, entropy(0, 10), precision);
     }
 
+    TEST_F(TestMetrics, CountsCacheHitsAndMissesWhenAsked)
+    {
+        entropy(0, 10);
+        FitStats stats;
+        setStats(&stats);
+        entropy(0, 10);             // cached before counting began
+        informationGain(0, 5, 10);  // a miss, and two entropies of which one is cached
+        informationGain(0, 5, 10);
+        entropy(3, 4);              // too short to look up
+        setStats(nullptr);
+        entropy(5, 10);
+        EXPECT_EQ(3u, stats.cache_hits);
+        EXPECT_EQ(3u, stats.cache_misses);
+    }
+
     // Metrics used to hold a std::mutex, which made it neither copyable nor
     // movable and, by extension, made CPPFImdlp non-movable too.
     TEST(Metrics, IsCopyableAndMovable)
@@ -143,3 +143,28 @@ TEST(PKIDisc, fit_move_log_strategy_matches_fit_copy)
 
     EXPECT_EQ(by_copy.getCutPoints(), by_move.getCutPoints());
 }
+
+// Streamed, PKIDisc picks its bin count from the stream's length.
+TEST(PKIDisc, streamed_fit_picks_bins_from_the_stream)
+{
+    mdlp::samples_t X(200);
+    for (size_t i = 0; i < X.size(); ++i) {
+        X[i] = static_cast<mdlp::precision_t>((i * 37) % 200);
+    }
+    mdlp::labels_t y(X.size(), 0);
+    mdlp::PKIDisc whole;
+    whole.fit(X, y);
+
+    mdlp::PKIDisc first, second;
+    first.partial_fit(mdlp::samples_t(X.begin(), X.begin() + 120));
+    second.partial_fit(mdlp::samples_t(X.begin() + 120, X.end()));
+    first.merge(second);
+    first.finalize();
+    EXPECT_EQ(14, first.getConfig().n_bins);  // sqrt(200)
+    EXPECT_EQ(whole.getCutPoints(), first.getCutPoints());
+
+    mdlp::PKIDisc log_strategy(mdlp::compute_strategy_t::LOG, 0.05);
+    EXPECT_EQ(0.05, log_strategy.getConfig().sketch_error);
+    EXPECT_THROW(first.merge(log_strategy), mdlp::InvalidParameter);
+    EXPECT_THROW(log_strategy.finalize(), mdlp::ValidationError);
+}
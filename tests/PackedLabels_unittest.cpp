@@ -0,0 +1,133 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "PackedLabels.h"
+#include "Exceptions.h"
+
+#define EXPECT_THROW_WITH_MESSAGE(stmt, etype, whatstring) EXPECT_THROW( \
+try { \
+stmt; \
+} catch (const etype& ex) { \
+EXPECT_EQ(whatstring, std::string(ex.what())); \
+throw; \
+} \
+, etype)
+
+namespace mdlp {
+    namespace {
+        labels_t cycle(size_t n, size_t n_bins)
+        {
+            labels_t labels(n);
+            for (size_t i = 0; i < n; ++i) {
+                labels[i] = static_cast<label_t>((i * 7 + i / 3) % n_bins);
+            }
+            return labels;
+        }
+    }
+
+    TEST(PackedLabels, BitsFollowTheBinCount)
+    {
+        EXPECT_EQ(1u, PackedLabels::bits_for(1));
+        EXPECT_EQ(1u, PackedLabels::bits_for(2));
+        EXPECT_EQ(2u, PackedLabels::bits_for(3));
+        EXPECT_EQ(2u, PackedLabels::bits_for(4));
+        EXPECT_EQ(3u, PackedLabels::bits_for(5));
+        EXPECT_EQ(4u, PackedLabels::bits_for(10));
+        EXPECT_EQ(8u, PackedLabels::bits_for(256));
+        EXPECT_EQ(9u, PackedLabels::bits_for(257));
+        EXPECT_EQ(31u, PackedLabels::bits_for(size_t{ 1 } << 31));
+        EXPECT_EQ(32u, PackedLabels::bits_for(size_t{ 1 } << 40));
+    }
+
+    // Every width, with sizes that end mid-word and on a word boundary.
+    TEST(PackedLabels, RoundTripsEveryWidth)
+    {
+        for (unsigned bits = 1; bits <= 32; ++bits) {
+            const size_t n_bins = size_t{ 1 } << bits;
+            const unsigned per_word = 64 / bits;
+            for (size_t n : { size_t{ 0 }, size_t{ 1 }, size_t{ per_word }, size_t{ 3 * per_word + 1 }, size_t{ 1000 } }) {
+                auto labels = cycle(n, std::min<size_t>(n_bins, 1u << 30));
+                if (n > 0) {
+                    labels.back() = static_cast<label_t>(std::min<size_t>(n_bins - 1, 0x7fffffff));
+                }
+                PackedLabels packed(labels, n_bins);
+                ASSERT_EQ(bits, packed.bits());
+                ASSERT_EQ(per_word, packed.per_word());
+                ASSERT_EQ(n, packed.size());
+                EXPECT_EQ(n == 0, packed.empty());
+                EXPECT_EQ((n + per_word - 1) / per_word, packed.words().size());
+                EXPECT_EQ(packed.words().size() * 8, packed.bytes());
+                EXPECT_EQ(labels, packed.unpack()) << bits << " bits, " << n << " labels";
+                for (size_t i = 0; i < n; ++i) {
+                    ASSERT_EQ(labels[i], packed[i]) << bits << " bits, label " << i;
+                }
+            }
+        }
+    }
+
+    TEST(PackedLabels, ThreeBinsTakeTwoBitsEach)
+    {
+        auto labels = cycle(1000000, 3);
+        PackedLabels packed(labels, 3);
+        EXPECT_EQ(3u, packed.n_bins());
+        EXPECT_EQ(2u, packed.bits());
+        // 16x smaller than label_t.
+        EXPECT_EQ(labels.size() * sizeof(label_t) / 16, packed.bytes());
+    }
+
+    TEST(PackedLabels, UnpacksAnyRange)
+    {
+        auto labels = cycle(200, 5);
+        PackedLabels packed(labels, 5);
+        for (size_t begin : { 0, 1, 20, 21, 199, 200 }) {
+            for (size_t count : { 0, 1, 19, 42 }) {
+                if (begin + count > labels.size()) {
+                    continue;
+                }
+                labels_t out(count);
+                packed.unpack(begin, count, out.data());
+                EXPECT_EQ(labels_t(labels.begin() + begin, labels.begin() + begin + count), out)
+                    << "begin " << begin << " count " << count;
+            }
+        }
+        label_t out[2];
+        EXPECT_THROW_WITH_MESSAGE(packed.unpack(199, 2, out), IndexError,
+            "Range [199, 201) out of bounds for 200 packed labels");
+        EXPECT_THROW_WITH_MESSAGE(packed.unpack(201, 0, out), IndexError,
+            "Range [201, 201) out of bounds for 200 packed labels");
+    }
+
+    TEST(PackedLabels, IteratesInOrder)
+    {
+        auto labels = cycle(77, 6);
+        PackedLabels packed(labels, 6);
+        EXPECT_EQ(labels, labels_t(packed.begin(), packed.end()));
+        auto it = packed.begin();
+        EXPECT_EQ(labels[0], *it++);
+        EXPECT_EQ(labels[1], *it);
+        EXPECT_EQ(labels[2], *++it);
+        EXPECT_TRUE(PackedLabels().begin() == PackedLabels().end());
+    }
+
+    TEST(PackedLabels, AtChecksTheIndex)
+    {
+        PackedLabels packed(labels_t{ 2, 0, 1 }, 3);
+        EXPECT_EQ(1, packed.at(2));
+        EXPECT_THROW_WITH_MESSAGE(packed.at(3), IndexError, "Index 3 out of bounds for 3 packed labels");
+    }
+
+    TEST(PackedLabels, RejectsLabelsOutsideTheBins)
+    {
+        EXPECT_THROW_WITH_MESSAGE(PackedLabels(labels_t{ 0 }, 0), InvalidParameter, "n_bins must be at least 1, got 0");
+        EXPECT_THROW_WITH_MESSAGE(PackedLabels(labels_t({ 0, 3, 1 }), 3), ValidationError,
+            "Label at index 1 is outside [0, 3): 3");
+        EXPECT_THROW_WITH_MESSAGE(PackedLabels(labels_t({ 0, -1 }), 3), ValidationError,
+            "Label at index 1 is outside [0, 3): -1");
+    }
+}
@@ -0,0 +1,168 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include "gtest/gtest.h"
+#include "QuantileSketch.h"
+#include "Exceptions.h"
+
+#define EXPECT_THROW_WITH_MESSAGE(stmt, etype, whatstring) EXPECT_THROW( \
+try { \
+stmt; \
+} catch (const etype& ex) { \
+EXPECT_EQ(whatstring, std::string(ex.what())); \
+throw; \
+} \
+, etype)
+
+namespace mdlp {
+    namespace {
+        // 0, 1, ..., n - 1 shuffled: every sample is its own rank, so the
+        // rank error of an estimate is how far its value is from the rank asked.
+        samples_t shuffled_ranks(size_t n, unsigned seed)
+        {
+            samples_t data(n);
+            std::iota(data.begin(), data.end(), 0.0f);
+            std::mt19937 rng(seed);
+            std::shuffle(data.begin(), data.end(), rng);
+            return data;
+        }
+
+        double worst_rank_error(const QuantileSketch& sketch)
+        {
+            const auto view = sketch.sorted_view();
+            const auto n = static_cast<double>(sketch.count());
+            double worst = 0;
+            for (int i = 0; i <= 1000; ++i) {
+                const auto rank = static_cast<size_t>((n - 1) * i / 1000);
+                worst = std::max(worst, std::fabs(view.at(rank) - static_cast<double>(rank)) / n);
+            }
+            return worst;
+        }
+    }
+
+    TEST(QuantileSketch, ShortStreamsAreExact)
+    {
+        QuantileSketch sketch;
+        auto data = shuffled_ranks(sketch.k(), 1);
+        sketch.update(data);
+        EXPECT_EQ(data.size(), sketch.retained());
+        const auto view = sketch.sorted_view();
+        for (size_t rank = 0; rank < data.size(); ++rank) {
+            ASSERT_EQ(static_cast<precision_t>(rank), view.at(rank));
+        }
+        EXPECT_EQ(0.0f, view.quantile(0));
+        EXPECT_EQ(static_cast<precision_t>(data.size() / 2), view.quantile(0.5));
+        EXPECT_EQ(static_cast<precision_t>(data.size() - 1), view.quantile(1));
+    }
+
+    TEST(QuantileSketch, RankErrorStaysWithinEpsilon)
+    {
+        for (double epsilon : { 0.05, 0.01, 0.002 }) {
+            QuantileSketch sketch(epsilon);
+            auto data = shuffled_ranks(500000, 2);
+            for (size_t begin = 0; begin < data.size(); begin += 4096) {
+                sketch.update(data.data() + begin, std::min<size_t>(4096, data.size() - begin));
+            }
+            EXPECT_EQ(data.size(), sketch.count());
+            EXPECT_EQ(0.0f, sketch.min());
+            EXPECT_EQ(499999.0f, sketch.max());
+            EXPECT_LE(worst_rank_error(sketch), epsilon) << "epsilon " << epsilon;
+        }
+    }
+
+    TEST(QuantileSketch, MemoryDoesNotGrowWithTheStream)
+    {
+        QuantileSketch sketch;
+        std::mt19937 rng(3);
+        std::normal_distribution<precision_t> normal;
+        samples_t chunk(10000);
+        size_t most = 0;
+        for (int i = 0; i < 200; ++i) {
+            for (auto& value : chunk) {
+                value = normal(rng);
+            }
+            sketch.update(chunk);
+            most = std::max(most, sketch.retained());
+        }
+        EXPECT_EQ(2000000u, sketch.count());
+        // 3k for the levels' geometric capacities, two per level beyond that.
+        EXPECT_LE(most, 3 * sketch.k() + 2 * 32);
+    }
+
+    // Parts sketched apart and merged, in any grouping, are as accurate as one sketch.
+    TEST(QuantileSketch, MergedPartsKeepTheBound)
+    {
+        auto data = shuffled_ranks(400000, 4);
+        std::vector<QuantileSketch> parts(8);
+        for (size_t p = 0; p < parts.size(); ++p) {
+            parts[p].update(data.data() + p * 50000, 50000);
+        }
+        QuantileSketch left, right;
+        for (size_t p = 0; p < 4; ++p) {
+            left.merge(parts[p]);
+            right.merge(parts[7 - p]);
+        }
+        left.merge(right);
+        EXPECT_EQ(data.size(), left.count());
+        EXPECT_EQ(0.0f, left.min());
+        EXPECT_EQ(399999.0f, left.max());
+        EXPECT_LE(worst_rank_error(left), left.epsilon());
+        EXPECT_LE(left.retained(), 3 * left.k() + 2 * 32);
+
+        QuantileSketch twice = parts[0];
+        twice.merge(twice);
+        EXPECT_EQ(100000u, twice.count());
+        twice.merge(QuantileSketch());
+        EXPECT_EQ(100000u, twice.count());
+    }
+
+    TEST(QuantileSketch, SameUpdatesGiveTheSameSketch)
+    {
+        auto data = shuffled_ranks(100000, 5);
+        QuantileSketch a, b;
+        a.update(data);
+        b.update(data);
+        const auto va = a.sorted_view();
+        const auto vb = b.sorted_view();
+        for (int i = 0; i <= 100; ++i) {
+            ASSERT_EQ(va.quantile(i / 100.0), vb.quantile(i / 100.0));
+        }
+        a.clear();
+        EXPECT_TRUE(a.empty());
+        EXPECT_EQ(0u, a.retained());
+        EXPECT_EQ(0.01, a.epsilon());
+    }
+
+    TEST(QuantileSketch, ValidatesItsInput)
+    {
+        EXPECT_THROW_WITH_MESSAGE(QuantileSketch(0), InvalidParameter, "epsilon must be in (0, 0.5], got 0");
+        EXPECT_THROW_WITH_MESSAGE(QuantileSketch(0.75), InvalidParameter, "epsilon must be in (0, 0.5], got 0.75");
+        EXPECT_THROW(QuantileSketch(std::numeric_limits<double>::quiet_NaN()), InvalidParameter);
+
+        QuantileSketch sketch;
+        EXPECT_THROW_WITH_MESSAGE(sketch.sorted_view(), ValidationError, "Quantile sketch is empty");
+        sketch.update(samples_t{ 3.0f, 1.0f });
+        EXPECT_THROW_WITH_MESSAGE(sketch.update(samples_t({ 2.0f, -std::numeric_limits<precision_t>::infinity() })),
+            ValidationError, "Sample at index 1 is not a finite number: -inf");
+        EXPECT_EQ(2u, sketch.count());
+        EXPECT_EQ(1.0f, sketch.min());
+        sketch.update(nullptr, 0);
+        EXPECT_EQ(2u, sketch.count());
+
+        const auto view = sketch.sorted_view();
+        EXPECT_EQ(2u, view.count());
+        EXPECT_THROW_WITH_MESSAGE(view.at(2), IndexError, "Rank 2 out of bounds for 2 samples");
+        EXPECT_THROW_WITH_MESSAGE(view.quantile(1.5), InvalidParameter, "q must be in [0, 1], got 1.5");
+        EXPECT_THROW_WITH_MESSAGE(sketch.merge(QuantileSketch(0.02)), InvalidParameter,
+            "Cannot merge sketches of different accuracy: epsilon 0.01 and 0.02");
+    }
+}
@@ -26,9 +26,9 @@
 #include <set>
 #include <string>
 #include <vector>
-#include <ArffFiles/ArffFiles.hpp>
 #include "gtest/gtest.h"
 #include "CPPFImdlp.h"
+#include "Loader.h"
 
 namespace mdlp {
 
@@ -45,7 +45,7 @@ namespace mdlp {
 
     struct DatasetSpec {
         std::string file;
-        bool class_last;        // ArffFiles: false puts the class in the first attribute
+        bool class_last;        // false puts the class in the first attribute
         size_t samples;
         size_t features;
         int classes;
@@ -102,10 +102,9 @@ namespace mdlp {
 
     static void runDataset(const DatasetSpec& spec)
     {
-        ArffFiles::ArffFiles file;
-        file.load(real_data_path() + spec.file, spec.class_last);
-        std::vector<samples_t>& X = file.getX();
-        labels_t& y = file.getY();
+        auto dataset = load_arff(real_data_path() + spec.file, spec.class_last);
+        std::vector<samples_t>& X = dataset.X;
+        labels_t& y = dataset.y;
 
         ASSERT_EQ(spec.features, X.size()) << spec.file << ": unexpected feature count";
         ASSERT_EQ(spec.samples, y.size()) << spec.file << ": unexpected sample count";
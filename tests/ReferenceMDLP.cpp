@@ -0,0 +1,225 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+#include "ReferenceMDLP.h"
+
+namespace reference {
+    using mdlp::precision_t;
+
+    namespace {
+        constexpr size_t none = std::numeric_limits<size_t>::max();
+
+        class Search {
+        public:
+            Search(const mdlp::samples_t& X, const mdlp::labels_t& y, size_t min_length_, int max_depth_)
+                : min_length(min_length_), max_depth(max_depth_)
+            {
+                // Ascending X, ties by ascending y, equal pairs in input order.
+                std::vector<size_t> order(X.size());
+                std::iota(order.begin(), order.end(), 0);
+                std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+                    return X[a] == X[b] ? y[a] < y[b] : X[a] < X[b];
+                    });
+                for (const auto i : order) {
+                    xs.push_back(X[i]);
+                    ys.push_back(y[i]);
+                }
+                n_labels = static_cast<size_t>(*std::max_element(y.begin(), y.end())) + 1;
+                // prefix[i * n_labels + l]: samples of class l among the first i.
+                prefix.assign((xs.size() + 1) * n_labels, 0);
+                for (size_t i = 0; i < xs.size(); ++i) {
+                    std::copy_n(prefix.begin() + static_cast<long>(i * n_labels), n_labels,
+                        prefix.begin() + static_cast<long>((i + 1) * n_labels));
+                    ++prefix[(i + 1) * n_labels + static_cast<size_t>(ys[i])];
+                }
+            }
+
+            int count(size_t start, size_t end, size_t label) const
+            {
+                return prefix[end * n_labels + label] - prefix[start * n_labels + label];
+            }
+
+            precision_t entropy(size_t start, size_t end) const
+            {
+                if (end <= start || end - start < 2) {
+                    return 0;
+                }
+                const int n = static_cast<int>(end - start);
+                precision_t ventropy = 0;
+                for (size_t label = 0; label < n_labels; ++label) {
+                    const int c = count(start, end, label);
+                    if (c > 0) {
+                        const precision_t p = static_cast<precision_t>(c) / static_cast<precision_t>(n);
+                        ventropy -= p * std::log2(p);
+                    }
+                }
+                return ventropy;
+            }
+
+            int classes(size_t start, size_t end) const
+            {
+                int k = 0;
+                for (size_t label = 0; label < n_labels; ++label) {
+                    k += count(start, end, label) > 0 ? 1 : 0;
+                }
+                return k;
+            }
+
+            precision_t information_gain(size_t start, size_t cut, size_t end) const
+            {
+                return entropy(start, end) -
+                    (static_cast<precision_t>(cut - start) * entropy(start, cut) +
+                        static_cast<precision_t>(end - cut) * entropy(cut, end)) /
+                    static_cast<precision_t>(end - start);
+            }
+
+            size_t candidate(size_t start, size_t end) const
+            {
+                if (std::all_of(xs.begin() + static_cast<long>(start), xs.begin() + static_cast<long>(end),
+                    [&](precision_t x) { return x == xs[start]; })) {
+                    return none;
+                }
+                const size_t elements = end - start;
+                size_t best = none;
+                precision_t minEntropy = entropy(start, end);
+                for (size_t idx = start + 1; idx < end; ++idx) {
+                    if (ys[idx] == ys[idx - 1]) {
+                        continue;
+                    }
+                    const precision_t entropy_left = precision_t(idx - start) / static_cast<precision_t>(elements)
+                        * entropy(start, idx);
+                    const precision_t entropy_right = precision_t(end - idx) / static_cast<precision_t>(elements)
+                        * entropy(idx, end);
+                    if (entropy_left + entropy_right < minEntropy) {
+                        minEntropy = entropy_left + entropy_right;
+                        best = idx;
+                    }
+                }
+                return best;
+            }
+
+            bool accept(size_t start, size_t cut, size_t end) const
+            {
+                const auto N = precision_t(end - start);
+                const int k = classes(start, end);
+                const int k1 = classes(start, cut);
+                const int k2 = classes(cut, end);
+                const precision_t ent = entropy(start, end);
+                const precision_t ent1 = entropy(start, cut);
+                const precision_t ent2 = entropy(cut, end);
+                const precision_t ig = information_gain(start, cut, end);
+                const auto delta = static_cast<precision_t>(log2(pow(3, precision_t(k)) - 2) -
+                    (precision_t(k) * ent - precision_t(k1) * ent1 - precision_t(k2) * ent2));
+                const precision_t term = 1 / N * (log2(N - 1) + delta);
+                return ig > term;
+            }
+
+            // The cut moves past the run of values equal to the one at cut: back
+            // to the run's start, or past its end when the run reaches start.
+            std::pair<precision_t, size_t> place(size_t start, size_t cut, size_t end) const
+            {
+                size_t prev = cut - 1 >= start ? cut - 1 : cut;
+                size_t next = cut + 1 < end ? cut + 1 : cut;
+                while (prev > start && xs[cut] == xs[prev]) {
+                    --prev;
+                }
+                const bool back_wall = prev == start && xs[cut] == xs[prev];
+                while (next < end - 1 && xs[cut] == xs[next]) {
+                    ++next;
+                }
+                const precision_t previous = xs[prev];
+                cut = back_wall ? std::max(next, cut + 1) : prev + 1;
+                return { (xs[cut] + previous) / 2, cut };
+            }
+
+            void search(size_t start, size_t end, int depth_)
+            {
+                if (end < start || end - start < min_length || depth_ > max_depth) {
+                    return;
+                }
+                depth = std::max(depth, depth_);
+                size_t cut = candidate(start, end);
+                if (cut == none || !accept(start, cut, end)) {
+                    return;
+                }
+                const auto placed = place(start, cut, end);
+                cuts.push_back(placed.first);
+                search(start, placed.second, depth_ + 1);
+                search(placed.second, end, depth_ + 1);
+            }
+
+            // Drops the cut whose interval, from the previous cut, has the
+            // highest entropy; the first of equals.
+            void drop_one()
+            {
+                precision_t worst = 0;
+                size_t worst_idx = 0;
+                size_t begin = 0;
+                for (size_t c = 0; c < cuts.size(); ++c) {
+                    size_t end = begin;
+                    while (end < xs.size() && xs[end] < cuts[c]) {
+                        ++end;
+                    }
+                    const precision_t e = entropy(begin, end);
+                    if (e > worst) {
+                        worst = e;
+                        worst_idx = c;
+                    }
+                    begin = end;
+                }
+                cuts.erase(cuts.begin() + static_cast<long>(worst_idx));
+            }
+
+            mdlp::cutPoints_t cuts;
+            std::vector<precision_t> xs;
+            int depth = 0;
+
+        private:
+            std::vector<mdlp::label_t> ys;
+            std::vector<int> prefix;
+            size_t n_labels = 0;
+            size_t min_length;
+            int max_depth;
+        };
+    }
+
+    Fit fit(const mdlp::samples_t& X, const mdlp::labels_t& y, size_t min_length, int max_depth, float proposed_cuts)
+    {
+        size_t max_cuts = none;
+        if (proposed_cuts > 0) {
+            max_cuts = proposed_cuts < 1
+                ? static_cast<size_t>(round(static_cast<precision_t>(X.size()) * proposed_cuts))
+                : static_cast<size_t>(proposed_cuts);
+        }
+        Search s(X, y, min_length, max_depth);
+        s.search(0, X.size(), 1);
+        std::sort(s.cuts.begin(), s.cuts.end());
+        if (max_cuts > 0) {
+            while (s.cuts.size() > max_cuts) {
+                s.drop_one();
+            }
+        }
+        s.cuts.insert(s.cuts.begin(), s.xs.front());
+        s.cuts.push_back(s.xs.back());
+        return { s.cuts, s.depth };
+    }
+
+    mdlp::labels_t transform(const mdlp::cutPoints_t& cuts, const mdlp::samples_t& data)
+    {
+        mdlp::labels_t labels;
+        labels.reserve(data.size());
+        for (const precision_t x : data) {
+            labels.push_back(static_cast<mdlp::label_t>(
+                std::upper_bound(cuts.begin() + 1, cuts.end() - 1, x) - (cuts.begin() + 1)));
+        }
+        return labels;
+    }
+}
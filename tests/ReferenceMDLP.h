@@ -0,0 +1,40 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#ifndef MDLP_REFERENCE_MDLP_H
+#define MDLP_REFERENCE_MDLP_H
+
+#include <cstddef>
+#include "typesFImdlp.h"
+
+/**
+ * @brief A frozen, deliberately plain implementation of CPPFImdlp
+ *
+ * The yardstick of Differential_unittest. It is written once and not
+ * optimized again: every kernel the library gains — incremental counts, SIMD,
+ * a radix sort, parallel search — is checked against it, so it must stay the
+ * obvious algorithm. Interval entropies come from a prefix table of class
+ * counts rather than Metrics' cache, the order from one stable_sort, and
+ * there are no statistics, tracing or bounds-checked accessors.
+ *
+ * The floating-point expressions are the library's, operation for operation
+ * and in the same order, since the comparison is of bytes. It lives in its own
+ * translation unit with the library's includes so that an unqualified log2 or
+ * pow resolves to the same overload as in CPPFImdlp.cpp.
+ */
+namespace reference {
+    struct Fit {
+        mdlp::cutPoints_t cuts;  ///< As getCutPoints(): min and max of X around the cuts
+        int depth = 0;           ///< Deepest recursion reached, as FitStats::max_depth
+    };
+
+    /** @brief What CPPFImdlp(min_length, max_depth, proposed_cuts).fit(X, y) computes */
+    Fit fit(const mdlp::samples_t& X, const mdlp::labels_t& y, size_t min_length, int max_depth, float proposed_cuts);
+
+    /** @brief What transform() gives for cuts: an upper_bound over the inner ones */
+    mdlp::labels_t transform(const mdlp::cutPoints_t& cuts, const mdlp::samples_t& data);
+}
+#endif
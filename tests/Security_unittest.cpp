@@ -22,6 +22,7 @@
 #include "CPPFImdlp.h"
 #include "BinDisc.h"
 #include "PKIDisc.h"
+#include "DiscretizerTorch.h"
 
 namespace mdlp {
 
@@ -261,7 +262,7 @@ namespace mdlp {
         auto X = torch::tensor({ 1.0f, 2.0f, kNaN, 4.0f, 5.0f, 6.0f }, torch::kFloat32);
         auto y = torch::tensor({ 0, 0, 0, 1, 1, 1 }, torch::kInt32);
         BinDisc disc(3, strategy_t::UNIFORM);
-        EXPECT_THROW(disc.fit_t(X, y), ValidationError);
-        EXPECT_THROW(disc.fit_transform_t(X, y), ValidationError);
+        EXPECT_THROW(fit_t(disc, X, y), ValidationError);
+        EXPECT_THROW(fit_transform_t(disc, X, y), ValidationError);
     }
 }
@@ -0,0 +1,370 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+// Saving fitted models and serving transform() from the mapped file.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "Serialization.h"
+#include "CPPFImdlp.h"
+#include "BinDisc.h"
+#include "PKIDisc.h"
+
+#define EXPECT_THROW_WITH_MESSAGE(stmt, etype, whatstring) EXPECT_THROW( \
+try { \
+stmt; \
+} catch (const etype& ex) { \
+EXPECT_EQ(whatstring, std::string(ex.what())); \
+throw; \
+} \
+, etype)
+
+namespace mdlp {
+
+    namespace {
+        std::string temp_path(const std::string& name)
+        {
+            return testing::TempDir() + "mdlp_serialization_" + name;
+        }
+
+        std::vector<char> read_bytes(const std::string& path)
+        {
+            std::ifstream in(path, std::ios::binary);
+            return { std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+        }
+
+        void write_bytes(const std::string& path, const std::vector<char>& bytes)
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        }
+
+        template <typename T>
+        void poke(std::vector<char>& bytes, size_t offset, T value)
+        {
+            std::memcpy(bytes.data() + offset, &value, sizeof(value));
+        }
+
+        // Offsets into the format documented in Serialization.h.
+        constexpr size_t HEADER = 32;
+        constexpr size_t RECORD = 48;
+
+        struct Fixture {
+            samples_t X;
+            labels_t y;
+            Fixture()
+            {
+                for (int i = 0; i < 120; ++i) {
+                    const int label = i % 3;
+                    X.push_back(static_cast<precision_t>(label * 2) + static_cast<precision_t>((i * 37) % 11) / 7.0f);
+                    y.push_back(label);
+                }
+            }
+        };
+
+        class UnsupportedDiscretizer : public Discretizer {
+        public:
+            using Discretizer::fit;
+            void fit(samples_t& X_, labels_t&) override { cutPoints = { X_.front(), X_.back() }; }
+        };
+    }
+
+    TEST(Serialization, RoundTripPreservesEveryKind)
+    {
+        Fixture data;
+        CPPFImdlp mdlp(MDLPConfig{}.withMinLength(4).withMaxDepth(7).withProposedCuts(0.5f));
+        BinDisc uniform(5, strategy_t::UNIFORM);
+        BinDisc quantile(4, strategy_t::QUANTILE);
+        PKIDisc pki(compute_strategy_t::LOG);
+        mdlp.fit(data.X, data.y);
+        uniform.fit(data.X, data.y);
+        quantile.fit(data.X, data.y);
+        pki.fit(data.X, data.y);
+
+        const auto path = temp_path("round_trip.bin");
+        save_models(path, { &mdlp, &uniform, &quantile, &pki });
+        const auto models = ModelFile::open(path);
+
+        ASSERT_EQ(4u, models.size());
+        EXPECT_EQ(model_kind_t::MDLP, models[0].kind());
+        EXPECT_EQ(model_kind_t::BIN, models[1].kind());
+        EXPECT_EQ(model_kind_t::BIN, models[2].kind());
+        EXPECT_EQ(model_kind_t::PKI, models[3].kind());
+
+        const Discretizer* originals[] = { &mdlp, &uniform, &quantile, &pki };
+        for (size_t i = 0; i < models.size(); ++i) {
+            EXPECT_EQ(originals[i]->getCutPoints(), models[i].getCutPoints()) << "model " << i;
+            EXPECT_EQ(originals[i]->getCutPoints().size(), models[i].size());
+            EXPECT_EQ(originals[i]->getBoundDirection(), models[i].getBoundDirection());
+            labels_t expected;
+            originals[i]->transform(data.X, expected);
+            EXPECT_EQ(expected, models[i].transform(data.X)) << "model " << i;
+        }
+
+        const auto mdlp_config = models[0].mdlpConfig();
+        EXPECT_EQ(4u, mdlp_config.min_length);
+        EXPECT_EQ(7, mdlp_config.max_depth);
+        EXPECT_FLOAT_EQ(0.5f, mdlp_config.proposed_cuts);
+        EXPECT_EQ(5, models[1].binDiscConfig().n_bins);
+        EXPECT_EQ(strategy_t::UNIFORM, models[1].binDiscConfig().strategy);
+        EXPECT_EQ(strategy_t::QUANTILE, models[2].binDiscConfig().strategy);
+        EXPECT_EQ(pki.getConfig().n_bins, models[3].binDiscConfig().n_bins);
+        EXPECT_EQ(strategy_t::QUANTILE, models[3].binDiscConfig().strategy);
+        EXPECT_EQ(compute_strategy_t::LOG, models[3].computeStrategy());
+        std::remove(path.c_str());
+    }
+
+    TEST(Serialization, CutPointsAreServedFromTheMappingWithoutCopying)
+    {
+        Fixture data;
+        BinDisc disc(4, strategy_t::QUANTILE);
+        disc.fit(data.X, data.y);
+        const auto path = temp_path("in_place.bin");
+        save_models(path, { &disc, &disc });
+        const auto models = ModelFile::open(path);
+        // Back to back in the file, right after the records.
+        EXPECT_EQ(models[0].cuts() + models[0].size(), models[1].cuts());
+        std::remove(path.c_str());
+    }
+
+    TEST(Serialization, ManyModelsRoundTrip)
+    {
+        Fixture data;
+        std::vector<BinDisc> discs;
+        for (int n_bins = 3; n_bins < 40; ++n_bins) {
+            discs.emplace_back(n_bins, n_bins % 2 == 0 ? strategy_t::QUANTILE : strategy_t::UNIFORM);
+            discs.back().fit(data.X, data.y);
+        }
+        std::vector<const Discretizer*> models;
+        for (const auto& disc : discs) {
+            models.push_back(&disc);
+        }
+        const auto path = temp_path("many.bin");
+        save_models(path, models);
+        const auto file = ModelFile::open(path);
+        ASSERT_EQ(discs.size(), file.size());
+        for (size_t i = 0; i < discs.size(); ++i) {
+            EXPECT_EQ(discs[i].getCutPoints(), file.at(i).getCutPoints());
+            EXPECT_EQ(discs[i].getConfig().n_bins, file.at(i).binDiscConfig().n_bins);
+        }
+        std::remove(path.c_str());
+    }
+
+    TEST(Serialization, EmptyBundleRoundTrips)
+    {
+        const auto path = temp_path("empty.bin");
+        save_models(path, {});
+        EXPECT_EQ(0u, ModelFile::open(path).size());
+        std::remove(path.c_str());
+    }
+
+    // The old mapping must survive a save over its file: that is what lets a
+    // service keep scoring while new models are published.
+    TEST(Serialization, ReplacingAFileLeavesOpenMappingsIntact)
+    {
+        Fixture data;
+        BinDisc first(3, strategy_t::UNIFORM);
+        BinDisc second(7, strategy_t::UNIFORM);
+        first.fit(data.X, data.y);
+        second.fit(data.X, data.y);
+        const auto path = temp_path("replace.bin");
+        save_models(path, { &first });
+        const auto old_models = ModelFile::open(path);
+        save_models(path, { &second });
+        const auto new_models = ModelFile::open(path);
+        EXPECT_EQ(first.getCutPoints(), old_models[0].getCutPoints());
+        EXPECT_EQ(second.getCutPoints(), new_models[0].getCutPoints());
+        std::remove(path.c_str());
+    }
+
+    // Concurrent saves to one path stage under names of their own, and leave
+    // a file called <path>.tmp alone.
+    TEST(Serialization, SavesStageUnderANameOfTheirOwn)
+    {
+        Fixture data;
+        BinDisc first(3, strategy_t::UNIFORM);
+        BinDisc second(7, strategy_t::UNIFORM);
+        first.fit(data.X, data.y);
+        second.fit(data.X, data.y);
+        const auto path = temp_path("staging.bin");
+        {
+            std::ofstream mine(path + ".tmp");
+            mine << "mine";
+        }
+        std::vector<std::thread> writers;
+        for (const Discretizer* model : { &first, &second, &first, &second }) {
+            writers.emplace_back([&path, model] {
+                for (int i = 0; i < 25; ++i) {
+                    save_models(path, { model });
+                }
+                });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        const auto cuts = ModelFile::open(path)[0].getCutPoints();
+        EXPECT_TRUE(cuts == first.getCutPoints() || cuts == second.getCutPoints());
+        EXPECT_EQ((std::vector<char>{ 'm', 'i', 'n', 'e' }), read_bytes(path + ".tmp"));
+        const auto prefix = std::filesystem::path(path).filename().string() + ".tmp.";
+        for (const auto& entry : std::filesystem::directory_iterator(testing::TempDir())) {
+            EXPECT_NE(0u, entry.path().filename().string().rfind(prefix, 0)) << entry.path();
+        }
+        std::remove(path.c_str());
+        std::remove((path + ".tmp").c_str());
+    }
+
+    TEST(Serialization, SaveRejectsWhatItCannotStore)
+    {
+        const auto path = temp_path("rejected.bin");
+        BinDisc unfitted(3);
+        EXPECT_THROW_WITH_MESSAGE(save_models(path, { &unfitted }), NotFittedError,
+            "Model 0 is not fitted and cannot be saved");
+
+        Fixture data;
+        UnsupportedDiscretizer unsupported;
+        unsupported.fit(data.X, data.y);
+        EXPECT_THROW_WITH_MESSAGE(save_models(path, { &unsupported }), InvalidParameter,
+            "Model 0 is not a CPPFImdlp, BinDisc or PKIDisc and cannot be saved");
+
+        BinDisc fitted(3);
+        fitted.fit(data.X, data.y);
+        EXPECT_THROW_WITH_MESSAGE(save_models(path, { &fitted, nullptr }), InvalidParameter, "Model 1 is null");
+
+        // Nothing was written by any of the rejected calls.
+        EXPECT_FALSE(std::ifstream(path).good());
+    }
+
+    TEST(Serialization, IOFailuresAreIOErrors)
+    {
+        Fixture data;
+        BinDisc disc(3);
+        disc.fit(data.X, data.y);
+        EXPECT_THROW(save_models(testing::TempDir() + "no/such/dir/models.bin", { &disc }), IOError);
+        // rename() cannot replace a directory with a file.
+        EXPECT_THROW(save_models(testing::TempDir(), { &disc }), IOError);
+        EXPECT_THROW(ModelFile::open(temp_path("does_not_exist.bin")), IOError);
+    }
+
+    TEST(Serialization, OpenRejectsMalformedFiles)
+    {
+        Fixture data;
+        BinDisc disc(4, strategy_t::UNIFORM);
+        disc.fit(data.X, data.y);
+        const auto good_path = temp_path("good.bin");
+        const auto bad_path = temp_path("bad.bin");
+        save_models(good_path, { &disc });
+        const auto good = read_bytes(good_path);
+        ASSERT_EQ(HEADER + RECORD + disc.getCutPoints().size() * sizeof(precision_t), good.size());
+
+        const auto expect_rejected = [&](std::vector<char> bytes, const std::string& message) {
+            write_bytes(bad_path, bytes);
+            EXPECT_THROW_WITH_MESSAGE(ModelFile::open(bad_path), ValidationError, bad_path + message);
+            };
+
+        expect_rejected(std::vector<char>(good.begin(), good.begin() + 16), " is too short to be a model file");
+        auto bytes = good;
+        bytes[0] = 'X';
+        expect_rejected(bytes, " is not a model file");
+        bytes = good;
+        poke<uint32_t>(bytes, 12, 0x04030201u);
+        expect_rejected(bytes, " was written on a machine of the other byte order");
+        bytes = good;
+        poke<uint32_t>(bytes, 8, 99u);
+        expect_rejected(bytes, " has model format version 99, expected 1");
+        bytes = std::vector<char>(good.begin(), good.end() - 4);
+        expect_rejected(bytes, " is " + std::to_string(bytes.size()) + " bytes, its header says "
+            + std::to_string(good.size()) + "; it is truncated or was modified");
+        bytes = good;
+        poke<uint64_t>(bytes, 16, 1000000u);
+        expect_rejected(bytes, " declares more models than it can hold");
+        bytes = good;
+        poke<uint32_t>(bytes, HEADER + 24, 9u);
+        expect_rejected(bytes, ": model 0 has unknown kind 9");
+        bytes = good;
+        poke<uint32_t>(bytes, HEADER + 28, 5u);
+        expect_rejected(bytes, ": model 0 has unknown bound direction 5");
+        bytes = good;
+        poke<uint32_t>(bytes, HEADER + 44, 2u);
+        expect_rejected(bytes, ": model 0 has unknown strategy 2");
+        bytes = good;
+        poke<int32_t>(bytes, HEADER + 40, 0);
+        expect_rejected(bytes, ": model 0 has 0 bins, fewer than 3");
+        bytes = good;
+        poke<int32_t>(bytes, HEADER + 40, -4);
+        expect_rejected(bytes, ": model 0 has -4 bins, fewer than 3");
+        bytes = good;
+        poke<uint64_t>(bytes, HEADER + 16, 1000u);
+        expect_rejected(bytes, ": model 0 has cut points outside the file");
+        bytes = good;
+        poke<uint64_t>(bytes, HEADER + 8, 0u);
+        expect_rejected(bytes, ": model 0 has cut points outside the file");
+        bytes = good;
+        poke<uint64_t>(bytes, HEADER + 16, 1u);
+        expect_rejected(bytes, ": model 0 has cut points outside the file");
+
+        // A PKIDisc keeps its compute strategy in the same field.
+        PKIDisc pki(compute_strategy_t::SQRT);
+        pki.fit(data.X, data.y);
+        save_models(good_path, { &pki });
+        bytes = read_bytes(good_path);
+        poke<uint32_t>(bytes, HEADER + 44, 2u);
+        expect_rejected(bytes, ": model 0 has unknown strategy 2");
+
+        std::remove(good_path.c_str());
+        std::remove(bad_path.c_str());
+    }
+
+    TEST(Serialization, AccessorsRejectTheWrongKind)
+    {
+        Fixture data;
+        CPPFImdlp mdlp;
+        BinDisc bins(3);
+        mdlp.fit(data.X, data.y);
+        bins.fit(data.X, data.y);
+        const auto path = temp_path("kinds.bin");
+        save_models(path, { &mdlp, &bins });
+        const auto models = ModelFile::open(path);
+        EXPECT_THROW_WITH_MESSAGE(models[0].binDiscConfig(), InvalidParameter, "Model is a CPPFImdlp, not a BinDisc or PKIDisc");
+        EXPECT_THROW_WITH_MESSAGE(models[0].computeStrategy(), InvalidParameter, "Model is a CPPFImdlp, not a PKIDisc");
+        EXPECT_THROW_WITH_MESSAGE(models[1].mdlpConfig(), InvalidParameter, "Model is a BinDisc, not a CPPFImdlp");
+        EXPECT_THROW_WITH_MESSAGE(models.at(2), IndexError, "Model index 2 out of range for a file of 2 models");
+        std::remove(path.c_str());
+    }
+
+    TEST(Serialization, EmptyViewIsNotFitted)
+    {
+        const ModelView view;
+        samples_t X = { 1.0f, 2.0f };
+        EXPECT_THROW(view.transform(X), NotFittedError);
+    }
+
+    TEST(Serialization, MappedFileMovesOwnership)
+    {
+        Fixture data;
+        BinDisc disc(3);
+        disc.fit(data.X, data.y);
+        const auto path = temp_path("moved.bin");
+        save_models(path, { &disc });
+        MappedFile original(path);
+        const unsigned char* bytes = original.data();
+        MappedFile moved(std::move(original));
+        EXPECT_EQ(bytes, moved.data());
+        EXPECT_EQ(nullptr, original.data());
+        MappedFile assigned;
+        assigned = std::move(moved);
+        EXPECT_EQ(bytes, assigned.data());
+        EXPECT_EQ(0u, moved.size());
+        std::remove(path.c_str());
+    }
+}
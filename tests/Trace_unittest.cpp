@@ -0,0 +1,257 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "BinDisc.h"
+#include "CPPFImdlp.h"
+#include "Exceptions.h"
+#include "Executor.h"
+#include "Trace.h"
+
+namespace mdlp {
+    namespace {
+        struct TracedEvent {
+            std::string name;
+            double ts;
+            double dur;
+            int tid;
+            long long begin = -1;
+            long long end = -1;
+        };
+
+        // write_chrome_trace() puts one event on a line, so a line-wise match
+        // is a parser here.
+        std::vector<TracedEvent> traced()
+        {
+            std::ostringstream os;
+            trace::write_chrome_trace(os);
+            static const std::regex complete(
+                R"re(\{"name":"([^"]+)","cat":"mdlp","ph":"X","ts":([0-9.]+),"dur":([0-9.]+),"pid":1,"tid":([0-9]+)(,"args":\{"begin":([0-9]+),"end":([0-9]+)\})?\})re");
+            std::vector<TracedEvent> events;
+            std::istringstream lines(os.str());
+            for (std::string line; std::getline(lines, line);) {
+                std::smatch m;
+                if (std::regex_search(line, m, complete)) {
+                    TracedEvent e{ m[1], std::stod(m[2]), std::stod(m[3]), std::stoi(m[4]) };
+                    if (m[5].matched) {
+                        e.begin = std::stoll(m[6]);
+                        e.end = std::stoll(m[7]);
+                    }
+                    events.push_back(e);
+                }
+            }
+            return events;
+        }
+
+        std::vector<TracedEvent> named(const std::string& name)
+        {
+            std::vector<TracedEvent> result;
+            for (const auto& e : traced()) {
+                if (e.name == name) {
+                    result.push_back(e);
+                }
+            }
+            return result;
+        }
+
+        void zone(const char* name)
+        {
+            MDLP_TRACE_SCOPE(name);
+        }
+    }
+
+    class Trace : public ::testing::Test {
+    protected:
+        void SetUp() override { trace::clear(); }
+    };
+
+    TEST_F(Trace, IsOnInThisBuild)
+    {
+        EXPECT_TRUE(trace::enabled);
+        EXPECT_EQ(0u, trace::event_count());
+    }
+
+    TEST_F(Trace, FitRecordsTheSearch)
+    {
+        samples_t X = { 5.1f, 4.9f, 4.7f, 6.3f, 6.5f, 7.0f, 5.8f, 6.1f, 4.6f, 6.9f };
+        labels_t y = { 0, 0, 0, 1, 1, 1, 0, 1, 0, 1 };
+        CPPFImdlp disc;
+        disc.fit(X, y);
+        EXPECT_EQ(1u, named("fit_impl").size());
+        EXPECT_EQ(1u, named("sortIndices").size());
+        // The root node covers the whole input and its range says so.
+        const auto nodes = named("computeCutPoints");
+        ASSERT_FALSE(nodes.empty());
+        const auto root = std::max_element(nodes.begin(), nodes.end(),
+            [](const TracedEvent& a, const TracedEvent& b) { return a.dur < b.dur; });
+        EXPECT_EQ(0, root->begin);
+        EXPECT_EQ(static_cast<long long>(X.size()), root->end);
+        // Every node that was searched asked for a candidate over its own range.
+        const auto candidates = named("getCandidate");
+        ASSERT_EQ(nodes.size(), candidates.size());
+        for (const auto& node : nodes) {
+            const bool found = std::any_of(candidates.begin(), candidates.end(), [&](const TracedEvent& c) {
+                return c.begin == node.begin && c.end == node.end;
+                });
+            EXPECT_TRUE(found) << "[" << node.begin << ", " << node.end << ")";
+        }
+        EXPECT_EQ(traced().size(), trace::event_count());
+    }
+
+    TEST_F(Trace, ZonesNestInTime)
+    {
+        {
+            MDLP_TRACE_SCOPE("outer");
+            zone("inner");
+        }
+        const auto outer = named("outer");
+        const auto inner = named("inner");
+        ASSERT_EQ(1u, outer.size());
+        ASSERT_EQ(1u, inner.size());
+        EXPECT_EQ(outer[0].tid, inner[0].tid);
+        EXPECT_LE(outer[0].ts, inner[0].ts);
+        EXPECT_LE(inner[0].ts + inner[0].dur, outer[0].ts + outer[0].dur + 0.001);
+        // Zones without a range carry no args.
+        EXPECT_EQ(-1, outer[0].begin);
+    }
+
+    TEST_F(Trace, QuantileFitAndTransform)
+    {
+        samples_t X = { 3.0f, 1.0f, 4.0f, 1.0f, 5.0f, 9.0f, 2.0f, 6.0f, 5.0f, 3.0f, 5.0f, 8.0f };
+        BinDisc disc(3, strategy_t::QUANTILE);
+        disc.fit(X);
+        EXPECT_EQ(1u, named("fit_quantile").size());
+        labels_t out;
+        disc.transform(X, out);
+        EXPECT_EQ(1u, named("transform").size());
+    }
+
+    TEST_F(Trace, ParallelTransformTracesEveryChunk)
+    {
+        const long long chunk_size = 65536;  // Discretizer::transform_chunk
+        samples_t X(2 * chunk_size + 10);
+        for (size_t i = 0; i < X.size(); ++i) {
+            X[i] = static_cast<precision_t>(i % 97);
+        }
+        BinDisc disc(4);
+        disc.fit(X);
+        trace::clear();
+        labels_t out;
+        ThreadPool pool(3);
+        disc.transform(X, out, pool);
+        const auto chunks = named("transform chunk");
+        ASSERT_EQ(3u, chunks.size());
+        std::set<long long> begins;
+        for (const auto& chunk : chunks) {
+            begins.insert(chunk.begin);
+            EXPECT_EQ(std::min<long long>(chunk.begin + chunk_size, X.size()), chunk.end);
+        }
+        EXPECT_EQ((std::set<long long>{ 0, chunk_size, 2 * chunk_size }), begins);
+    }
+
+    TEST_F(Trace, EachThreadHasItsOwnTid)
+    {
+        std::thread first([] { zone("worker"); });
+        first.join();
+        std::thread second([] { zone("worker"); });
+        second.join();
+        zone("main");
+        const auto workers = named("worker");
+        ASSERT_EQ(2u, workers.size());
+        const auto main = named("main");
+        ASSERT_EQ(1u, main.size());
+        EXPECT_NE(workers[0].tid, workers[1].tid);
+        EXPECT_NE(main[0].tid, workers[0].tid);
+        EXPECT_NE(main[0].tid, workers[1].tid);
+    }
+
+    TEST_F(Trace, KeepsEventsBeyondOneChunk)
+    {
+        for (int i = 0; i < 2500; ++i) {
+            zone("many");
+        }
+        EXPECT_EQ(2500u, trace::event_count());
+        EXPECT_EQ(2500u, named("many").size());
+        trace::clear();
+        zone("after");
+        EXPECT_EQ(1u, trace::event_count());
+        const auto events = traced();
+        ASSERT_EQ(1u, events.size());
+        EXPECT_EQ("after", events[0].name);
+    }
+
+    // Tracing and clearing in a loop, on this thread and on threads that come
+    // and go, stops allocating. clear() keeps the chunk this thread's last
+    // event is in, which its next event may still go to, so the second round
+    // can add one; after that every chunk is a reused one.
+    TEST_F(Trace, ClearReusesTheChunks)
+    {
+        const auto round = [] {
+            for (int i = 0; i < 2048; ++i) {
+                zone("many");
+            }
+            std::thread worker([] {
+                for (int i = 0; i < 1500; ++i) {
+                    zone("worker");
+                }
+                });
+            worker.join();
+            EXPECT_EQ(3548u, trace::event_count());
+            trace::clear();
+            };
+        round();
+        round();
+        const size_t chunks = trace::chunk_count();
+        for (int i = 0; i < 5; ++i) {
+            round();
+            EXPECT_EQ(chunks, trace::chunk_count()) << "round " << i;
+        }
+        zone("after");
+        EXPECT_EQ(1u, trace::event_count());
+        const auto events = traced();
+        ASSERT_EQ(1u, events.size());
+        EXPECT_EQ("after", events[0].name);
+    }
+
+    TEST_F(Trace, WritesAFile)
+    {
+        zone("to file");
+        const std::string path = testing::TempDir() + "mdlp_trace.json";
+        trace::write_chrome_trace(path);
+        std::ifstream in(path);
+        const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::remove(path.c_str());
+        EXPECT_EQ(0u, content.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+        EXPECT_NE(std::string::npos, content.find("\"name\":\"to file\""));
+        EXPECT_NE(std::string::npos, content.find("\"thread_name\""));
+        EXPECT_THROW(trace::write_chrome_trace("/nonexistent/dir/trace.json"), IOError);
+    }
+
+    TEST_F(Trace, WritesTheFileNamedByTheEnvironmentAtExit)
+    {
+        const std::string path = testing::TempDir() + "mdlp_trace_at_exit.json";
+        std::remove(path.c_str());
+        EXPECT_EXIT({
+            setenv("MDLP_TRACE_FILE", path.c_str(), 1);
+            zone("at exit");
+            std::exit(0);
+            }, testing::ExitedWithCode(0), "");
+        std::ifstream in(path);
+        const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::remove(path.c_str());
+        EXPECT_NE(std::string::npos, content.find("\"name\":\"at exit\""));
+    }
+}
@@ -0,0 +1,231 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+// Every transform kernel must give the labels of the binary search it replaces,
+// for every cut count — the tree shapes differ with it — both directions, and
+// samples on, between and beyond the cuts.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "TransformKernel.h"
+#include "BinDisc.h"
+
+namespace mdlp {
+
+    namespace {
+        cutPoints_t sorted_cuts(size_t count, std::mt19937& rng, bool with_duplicates)
+        {
+            std::uniform_real_distribution<precision_t> value(-100.0f, 100.0f);
+            cutPoints_t cuts(count);
+            for (size_t i = 0; i < count; ++i) {
+                cuts[i] = with_duplicates && i > 0 && i % 3 == 0 ? cuts[i - 1] : value(rng);
+            }
+            std::sort(cuts.begin(), cuts.end());
+            return cuts;
+        }
+
+        // Random values plus every cut, its neighbours and the extremes. The
+        // count is rarely a multiple of sixteen, so the vector kernel's scalar
+        // tail runs too.
+        samples_t probes(const cutPoints_t& cuts, std::mt19937& rng)
+        {
+            std::uniform_real_distribution<precision_t> value(-150.0f, 150.0f);
+            samples_t data;
+            for (const precision_t cut : cuts) {
+                data.push_back(cut);
+                data.push_back(std::nextafter(cut, -std::numeric_limits<precision_t>::infinity()));
+                data.push_back(std::nextafter(cut, std::numeric_limits<precision_t>::infinity()));
+            }
+            data.push_back(-std::numeric_limits<precision_t>::max());
+            data.push_back(std::numeric_limits<precision_t>::max());
+            for (int i = 0; i < 101; ++i) {
+                data.push_back(value(rng));
+            }
+            std::shuffle(data.begin(), data.end(), rng);
+            return data;
+        }
+
+        const bound_dir_t DIRECTIONS[] = { bound_dir_t::LEFT, bound_dir_t::RIGHT };
+    }
+
+    TEST(TransformKernel, TreeHoldsTheCutsBreadthFirst)
+    {
+        const cutPoints_t cuts = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+        const detail::EytzingerCuts tree(cuts.data(), cuts.size());
+        ASSERT_EQ(3, tree.depth());
+        const precision_t inf = std::numeric_limits<precision_t>::infinity();
+        // In order: 1 2 3 4 5 inf inf; the root is the middle one.
+        const std::vector<precision_t> expected = { 4.0f, 2.0f, inf, 1.0f, 3.0f, 5.0f, inf };
+        EXPECT_EQ(expected, std::vector<precision_t>(tree.tree() + 1, tree.tree() + 8));
+    }
+
+    TEST(TransformKernel, TreeDepthCoversEveryCut)
+    {
+        const cutPoints_t cuts(9, 0.0f);
+        const int expected[] = { 0, 1, 2, 2, 3, 3, 3, 3, 4, 4 };
+        for (size_t count = 0; count <= 9; ++count) {
+            EXPECT_EQ(expected[count], detail::EytzingerCuts(cuts.data(), count).depth()) << count << " cuts";
+        }
+    }
+
+    TEST(TransformKernel, KernelsAgreeWithBinarySearch)
+    {
+        std::mt19937 rng(27);
+        for (size_t count = 0; count <= 70; ++count) {
+            for (const bool duplicates : { false, true }) {
+                const auto cuts = sorted_cuts(count, rng, duplicates);
+                const auto data = probes(cuts, rng);
+                const detail::EytzingerCuts tree(cuts.data(), cuts.size());
+                for (const auto direction : DIRECTIONS) {
+                    labels_t expected(data.size());
+                    labels_t scalar(data.size());
+                    labels_t dispatched(data.size());
+                    detail::bin_reference(cuts.data(), cuts.size(), direction, data.data(), data.size(), expected.data());
+                    detail::bin_eytzinger(tree, direction, data.data(), data.size(), scalar.data());
+                    detail::bin_samples(cuts.data(), cuts.size(), direction, data.data(), data.size(), dispatched.data());
+                    EXPECT_EQ(expected, scalar) << count << " cuts";
+                    EXPECT_EQ(expected, dispatched) << count << " cuts";
+                    if (detail::avx2_available()) {
+                        labels_t vector(data.size());
+                        detail::bin_eytzinger_avx2(tree, direction, data.data(), data.size(), vector.data());
+                        EXPECT_EQ(expected, vector) << count << " cuts";
+                    }
+                }
+            }
+        }
+    }
+
+    // Fewer samples than cuts takes the binary search; the answer must not change.
+    TEST(TransformKernel, FewSamplesManyCuts)
+    {
+        std::mt19937 rng(270);
+        const auto cuts = sorted_cuts(1000, rng, false);
+        const samples_t data = { cuts[0], cuts[500], 0.0f, 1000.0f };
+        for (const auto direction : DIRECTIONS) {
+            labels_t expected(data.size());
+            labels_t dispatched(data.size());
+            detail::bin_reference(cuts.data(), cuts.size(), direction, data.data(), data.size(), expected.data());
+            detail::bin_samples(cuts.data(), cuts.size(), direction, data.data(), data.size(), dispatched.data());
+            EXPECT_EQ(expected, dispatched);
+        }
+    }
+
+    TEST(TransformKernel, TransformUsesTheSameLabelsAsBefore)
+    {
+        std::mt19937 rng(2027);
+        std::normal_distribution<precision_t> value(0.0f, 10.0f);
+        samples_t X(5000);
+        for (auto& x : X) {
+            x = value(rng);
+        }
+        labels_t y(X.size(), 0);
+        BinDisc disc(50, strategy_t::QUANTILE);
+        disc.fit(X, y);
+        const auto cuts = disc.getCutPoints();
+        labels_t expected;
+        for (const precision_t x : X) {
+            // The pre-kernel transform: upper_bound over the inner cuts.
+            expected.push_back(static_cast<label_t>(std::upper_bound(cuts.begin() + 1, cuts.end() - 1, x) - (cuts.begin() + 1)));
+        }
+        EXPECT_EQ(expected, disc.transform(X));
+    }
+
+    // Grids as BinDisc builds them, at offsets and widths where float rounding
+    // moves the cuts off the grid, probed on and around every cut. Whether or
+    // not a grid is exact(), the dispatched labels must be the search's.
+    TEST(TransformKernel, UniformKernelsAgreeWithBinarySearch)
+    {
+        std::mt19937 rng(28);
+        const precision_t origins[] = { -1.0f, 0.0f, 0.1f, 1000.3f, -77777.7f, 1.0e7f };
+        const precision_t widths[] = { 1.0e-3f, 0.1f, 0.7f, 3.0f, 1234.5f };
+        for (const precision_t origin : origins) {
+            for (const precision_t width : widths) {
+                for (const int n_bins : { 3, 4, 10, 33, 200 }) {
+                    cutPoints_t cuts;
+                    for (int i = 0; i <= n_bins; ++i) {
+                        cuts.push_back(origin + width * static_cast<precision_t>(i));
+                    }
+                    const cutPoints_t inner(cuts.begin() + 1, cuts.end() - 1);
+                    const auto data = probes(cuts, rng);
+                    const detail::UniformCuts grid(inner.data(), inner.size(), origin, width);
+                    labels_t expected(data.size());
+                    labels_t scalar(data.size());
+                    labels_t dispatched(data.size());
+                    detail::bin_reference(inner.data(), inner.size(), bound_dir_t::RIGHT, data.data(), data.size(), expected.data());
+                    detail::bin_samples_uniform(inner.data(), inner.size(), origin, width, data.data(), data.size(), dispatched.data());
+                    EXPECT_EQ(expected, dispatched) << "origin " << origin << " width " << width << " bins " << n_bins;
+                    if (!grid.exact()) {
+                        continue;
+                    }
+                    detail::bin_uniform(grid, data.data(), data.size(), scalar.data());
+                    EXPECT_EQ(expected, scalar) << "origin " << origin << " width " << width << " bins " << n_bins;
+                    if (detail::avx2_available()) {
+                        labels_t vector(data.size());
+                        detail::bin_uniform_avx2(grid, data.data(), data.size(), vector.data());
+                        EXPECT_EQ(expected, vector) << "origin " << origin << " width " << width << " bins " << n_bins;
+                    }
+                }
+            }
+        }
+    }
+
+    // A grid that disagrees with its cuts is detected, and the tree is used.
+    TEST(TransformKernel, UniformKernelRejectsAGridItsCutsDoNotFollow)
+    {
+        std::mt19937 rng(280);
+        const cutPoints_t inner = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f };
+        EXPECT_TRUE(detail::UniformCuts(inner.data(), inner.size(), 0.0f, 1.0f).exact());
+        EXPECT_FALSE(detail::UniformCuts(inner.data(), inner.size(), 0.0f, 0.25f).exact());
+        EXPECT_FALSE(detail::UniformCuts(inner.data(), inner.size(), 0.0f, 4.0f).exact());
+        const auto data = probes(inner, rng);
+        labels_t expected(data.size());
+        labels_t dispatched(data.size());
+        detail::bin_reference(inner.data(), inner.size(), bound_dir_t::RIGHT, data.data(), data.size(), expected.data());
+        detail::bin_samples_uniform(inner.data(), inner.size(), 0.0f, 0.25f, data.data(), data.size(), dispatched.data());
+        EXPECT_EQ(expected, dispatched);
+    }
+
+    // 1 / width overflows: the arithmetic is abandoned for the tree.
+    TEST(TransformKernel, UniformKernelNeedsAFiniteInverseWidth)
+    {
+        const precision_t width = std::numeric_limits<precision_t>::denorm_min();
+        const cutPoints_t inner = { 2 * width, 4 * width };
+        const samples_t data = { 0.0f, 2 * width, 3 * width, 4 * width, 1.0f };
+        labels_t out(data.size());
+        detail::bin_samples_uniform(inner.data(), inner.size(), 0.0f, width, data.data(), data.size(), out.data());
+        EXPECT_EQ(labels_t({ 0, 1, 1, 2, 2 }), out);
+    }
+
+    TEST(TransformKernel, UniformBinDiscKeepsItsLabels)
+    {
+        std::mt19937 rng(2028);
+        for (const precision_t scale : { 0.01f, 1.0f, 1000.0f }) {
+            std::normal_distribution<precision_t> value(scale * 3, scale);
+            samples_t X(3001);
+            for (auto& x : X) {
+                x = value(rng);
+            }
+            BinDisc disc(17, strategy_t::UNIFORM);
+            disc.fit(X);
+            const auto cuts = disc.getCutPoints();
+            // The cut points themselves, where a one-bin error would show.
+            samples_t probe = X;
+            probe.insert(probe.end(), cuts.begin(), cuts.end());
+            labels_t expected;
+            for (const precision_t x : probe) {
+                expected.push_back(static_cast<label_t>(std::upper_bound(cuts.begin() + 1, cuts.end() - 1, x) - (cuts.begin() + 1)));
+            }
+            EXPECT_EQ(expected, disc.transform(probe)) << "scale " << scale;
+            // ...and they came from the arithmetic kernel, not the fallback.
+            const cutPoints_t inner(cuts.begin() + 1, cuts.end() - 1);
+            EXPECT_TRUE(detail::UniformCuts(inner.data(), inner.size(), cuts.front(), (cuts.back() - cuts.front()) / 17).exact());
+        }
+    }
+}
@@ -0,0 +1,152 @@
+// ****************************************************************
+// SPDX - FileCopyrightText: Copyright 2026 Ricardo Montañana Gómez
+// SPDX - FileType: SOURCE
+// SPDX - License - Identifier: MIT
+// ****************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <vector>
+#include "gtest/gtest.h"
+#include "Workload.h"
+
+namespace bench {
+    namespace {
+        std::vector<size_t> class_counts(const Workload& w, int classes)
+        {
+            std::vector<size_t> counts(static_cast<size_t>(classes));
+            for (const auto label : w.y) {
+                ++counts[static_cast<size_t>(label)];
+            }
+            return counts;
+        }
+    }
+
+    // Benchmark results stored before the generator existed were measured on
+    // this sequence; the defaults must keep producing it.
+    TEST(Workload, DefaultsAreDatasetVersion2)
+    {
+        for (const int k : { 2, 3, 7 }) {
+            std::mt19937 rng(42u);
+            Workload expected;
+            for (size_t i = 0; i < 5000; ++i) {
+                const int label = portable::bounded(rng, k);
+                expected.X.push_back(static_cast<mdlp::precision_t>(static_cast<double>(label) * 2.0 + portable::normal01(rng)));
+                expected.y.push_back(label);
+            }
+            const auto w = generate(WorkloadSpec{}.withN(5000).withClasses(k));
+            ASSERT_EQ(expected.X.size(), w.X.size());
+            EXPECT_EQ(0, std::memcmp(expected.X.data(), w.X.data(), w.X.size() * sizeof(mdlp::precision_t)));
+            EXPECT_EQ(expected.y, w.y);
+        }
+    }
+
+    TEST(Workload, SeededAndDeterministic)
+    {
+        const auto spec = WorkloadSpec{}.withN(3000).withClasses(5).withImbalance(4).withDuplicates(0.3)
+            .withDistribution(Distribution::bimodal).withCorrelation(0.8).withSeed(7);
+        const auto first = generate(spec);
+        const auto second = generate(spec);
+        EXPECT_EQ(first.X, second.X);
+        EXPECT_EQ(first.y, second.y);
+        const auto other = generate(WorkloadSpec(spec).withSeed(8));
+        EXPECT_NE(first.X, other.X);
+    }
+
+    TEST(Workload, ClassCountAndImbalance)
+    {
+        const auto balanced = generate(WorkloadSpec{}.withN(100000).withClasses(64));
+        for (const auto count : class_counts(balanced, 64)) {
+            EXPECT_NEAR(100000.0 / 64, static_cast<double>(count), 150.0);
+        }
+        const auto skewed = generate(WorkloadSpec{}.withN(100000).withClasses(4).withImbalance(10));
+        const auto counts = class_counts(skewed, 4);
+        EXPECT_TRUE(std::is_sorted(counts.rbegin(), counts.rend()));
+        EXPECT_NEAR(10.0, static_cast<double>(counts.front()) / static_cast<double>(counts.back()), 1.0);
+        // A single class takes every sample whatever the imbalance.
+        const auto one = generate(WorkloadSpec{}.withN(100).withClasses(1).withImbalance(5));
+        EXPECT_EQ(std::vector<size_t>{ 100 }, class_counts(one, 1));
+    }
+
+    TEST(Workload, DuplicateShare)
+    {
+        for (const double share : { 0.0, 0.5, 0.9, 0.99 }) {
+            const auto w = generate(WorkloadSpec{}.withN(20000).withDuplicates(share));
+            const std::set<mdlp::precision_t> distinct(w.X.begin(), w.X.end());
+            const double repeated = 1.0 - static_cast<double>(distinct.size()) / static_cast<double>(w.X.size());
+            EXPECT_NEAR(share, repeated, 0.02) << "duplicates=" << share;
+        }
+        // Repeats come from their own class, so no value changes class.
+        const auto w = generate(WorkloadSpec{}.withN(5000).withClasses(3).withDuplicates(0.9)
+            .withDistribution(Distribution::uniform));
+        for (size_t i = 0; i < w.X.size(); ++i) {
+            EXPECT_LE(std::fabs(w.X[i] - 2.0f * static_cast<float>(w.y[i])), 1.5f);
+        }
+    }
+
+    TEST(Workload, Distributions)
+    {
+        const auto spec = WorkloadSpec{}.withN(20000).withClasses(4);
+        const auto uniform = generate(WorkloadSpec(spec).withDistribution(Distribution::uniform));
+        for (size_t i = 0; i < uniform.X.size(); ++i) {
+            EXPECT_LE(std::fabs(uniform.X[i] - 2.0f * static_cast<float>(uniform.y[i])), 1.5f);
+        }
+        const auto integer = generate(WorkloadSpec(spec).withDistribution(Distribution::integer));
+        EXPECT_TRUE(std::all_of(integer.X.begin(), integer.X.end(), [](float x) { return x == std::floor(x); }));
+        EXPECT_LT(std::set<float>(integer.X.begin(), integer.X.end()).size(), 30u);
+        // The normal never strays more than 6 from its centre; a heavy tail does.
+        const auto heavy = generate(WorkloadSpec(spec).withDistribution(Distribution::heavy_tailed));
+        size_t far = 0;
+        for (size_t i = 0; i < heavy.X.size(); ++i) {
+            far += std::fabs(heavy.X[i] - 2.0f * static_cast<float>(heavy.y[i])) > 6.0f ? 1 : 0;
+        }
+        EXPECT_GT(far, heavy.X.size() / 100);
+        // For four classes the first modes end by 6 + 6 and the second ones
+        // start at 20 - 6: nothing falls in between.
+        const auto bimodal = generate(WorkloadSpec(spec).withDistribution(Distribution::bimodal));
+        const auto low = std::count_if(bimodal.X.begin(), bimodal.X.end(), [](float x) { return x <= 12.0f; });
+        const auto high = std::count_if(bimodal.X.begin(), bimodal.X.end(), [](float x) { return x >= 14.0f; });
+        EXPECT_EQ(bimodal.X.size(), static_cast<size_t>(low + high));
+        EXPECT_NEAR(0.5, static_cast<double>(low) / static_cast<double>(bimodal.X.size()), 0.02);
+    }
+
+    TEST(Workload, Correlation)
+    {
+        const auto outside = [](const Workload& w) {
+            size_t count = 0;
+            for (size_t i = 0; i < w.X.size(); ++i) {
+                count += std::fabs(w.X[i] - 2.0f * static_cast<float>(w.y[i])) > 1.5f ? 1 : 0;
+            }
+            return static_cast<double>(count) / static_cast<double>(w.X.size());
+        };
+        const auto spec = WorkloadSpec{}.withN(20000).withClasses(4).withDistribution(Distribution::uniform);
+        EXPECT_EQ(0.0, outside(generate(spec)));
+        // A value drawn around a random class lands outside its own band
+        // unless that class is its own or a neighbour whose band overlaps.
+        const double half = outside(generate(WorkloadSpec(spec).withCorrelation(0.5)));
+        const double none = outside(generate(WorkloadSpec(spec).withCorrelation(0.0)));
+        EXPECT_GT(half, 0.2);
+        EXPECT_NEAR(2 * half, none, 0.05);
+    }
+
+    TEST(Workload, RejectsImpossibleSpecs)
+    {
+        EXPECT_THROW(generate(WorkloadSpec{}.withClasses(0)), std::invalid_argument);
+        EXPECT_THROW(generate(WorkloadSpec{}.withImbalance(0.5)), std::invalid_argument);
+        EXPECT_THROW(generate(WorkloadSpec{}.withDuplicates(1.5)), std::invalid_argument);
+        EXPECT_THROW(generate(WorkloadSpec{}.withDuplicates(std::nan(""))), std::invalid_argument);
+        EXPECT_THROW(generate(WorkloadSpec{}.withCorrelation(-0.1)), std::invalid_argument);
+    }
+
+    TEST(Workload, Describe)
+    {
+        EXPECT_EQ("default", describe(WorkloadSpec{}.withN(100000).withSeed(3)));
+        EXPECT_EQ("classes=16 duplicates=0.9", describe(WorkloadSpec{}.withClasses(16).withDuplicates(0.9)));
+        EXPECT_EQ("imbalance=100 distribution=heavy_tailed correlation=0.5",
+            describe(WorkloadSpec{}.withImbalance(100).withDistribution(Distribution::heavy_tailed).withCorrelation(0.5)));
+        EXPECT_STREQ("integer", name(Distribution::integer));
+    }
+}